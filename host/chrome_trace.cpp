@@ -0,0 +1,221 @@
+/**
+ * @file host/chrome_trace.cpp
+ * @brief Chrome-Trace-Event-JSON aus Trace-Einträgen und Telemetrie
+ */
+
+#include "chrome_trace.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+        using monitor::TraceEvent;
+        using monitor::TraceRecord;
+        using monitor::TraceSpan;
+
+        namespace
+        {
+            constexpr int PID = 1;
+            constexpr int TID_MOTION = 1; // Aufrufer-Task (Motion, Stift, Text)
+            constexpr int TID_ISR = 2;    // Stepper-Timer-ISR
+
+            const char *commandName(uint32_t cmd)
+            {
+                static const char *names[] = {"STOP", "FORWARD", "BACKWARD", "SPIN_CW", "SPIN_CCW"};
+                return cmd < 5 ? names[cmd] : "?";
+            }
+
+            /**
+             * @brief 32-Bit-µs-Zeitstempel (Überlauf nach ~71 min) fortlaufend machen
+             */
+            class Unwrapper
+            {
+            public:
+                uint64_t operator()(uint32_t ts)
+                {
+                    if (have_ && ts < last_ && last_ - ts > 0x80000000u)
+                        high_ += 0x100000000ull;
+                    have_ = true;
+                    last_ = ts;
+                    return high_ + ts;
+                }
+
+            private:
+                bool have_ = false;
+                uint32_t last_ = 0;
+                uint64_t high_ = 0;
+            };
+
+            class JsonOut
+            {
+            public:
+                explicit JsonOut(FILE *out) : out_(out) {}
+
+                // Öffnet ein Event-Objekt (Komma-Verwaltung) - Aufrufer schließt mit "}"
+                void begin(const char *name, char ph, uint64_t ts, int tid)
+                {
+                    std::fprintf(out_, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":%d,\"tid\":%d",
+                                 first_ ? "" : ",", name, ph, static_cast<unsigned long long>(ts), PID, tid);
+                    first_ = false;
+                }
+
+                void counter(const char *name, uint64_t ts, double value)
+                {
+                    begin(name, 'C', ts, TID_MOTION);
+                    std::fprintf(out_, ",\"args\":{\"value\":%.1f}}", value);
+                }
+
+                void threadName(int tid, const char *name)
+                {
+                    std::fprintf(out_, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                                 first_ ? "" : ",", PID, tid, name);
+                    first_ = false;
+                }
+
+                FILE *file() { return out_; }
+
+            private:
+                FILE *out_;
+                bool first_ = true;
+            };
+
+            void writeSpanArgs(FILE *out, TraceSpan span, uint32_t arg)
+            {
+                switch (span)
+                {
+                case TraceSpan::MOVE:
+                    std::fprintf(out, ",\"args\":{\"distance_mm\":%.1f}", static_cast<int32_t>(arg) / 10.0);
+                    break;
+                case TraceSpan::TURN:
+                    std::fprintf(out, ",\"args\":{\"degrees\":%.1f}", static_cast<int32_t>(arg) / 10.0);
+                    break;
+                case TraceSpan::GOTO:
+                    std::fprintf(out, ",\"args\":{\"x_mm\":%.1f,\"y_mm\":%.1f}",
+                                 static_cast<int16_t>(arg & 0xFFFF) / 10.0, static_cast<int16_t>(arg >> 16) / 10.0);
+                    break;
+                case TraceSpan::PEN_UP:
+                case TraceSpan::PEN_DOWN:
+                    std::fprintf(out, ",\"args\":{\"servo_deg\":%u}", arg);
+                    break;
+                case TraceSpan::PLOT_CHAR:
+                    if (arg >= 0x20 && arg < 0x7F && arg != '"' && arg != '\\')
+                        std::fprintf(out, ",\"args\":{\"char\":\"%c\"}", static_cast<char>(arg));
+                    else
+                        std::fprintf(out, ",\"args\":{\"code\":%u}", arg);
+                    break;
+                case TraceSpan::TIMELINE:
+                    std::fprintf(out, ",\"args\":{\"records\":%u}", arg);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            void writeRecord(JsonOut &json, const TraceRecord &rec, uint64_t ts)
+            {
+                FILE *out = json.file();
+                switch (rec.event)
+                {
+                case TraceEvent::SPAN_BEGIN:
+                    json.begin(monitor::traceSpanName(static_cast<TraceSpan>(rec.a)), 'B', ts, TID_MOTION);
+                    writeSpanArgs(out, static_cast<TraceSpan>(rec.a), rec.b);
+                    std::fputs("}", out);
+                    break;
+                case TraceEvent::SPAN_END:
+                    json.begin(monitor::traceSpanName(static_cast<TraceSpan>(rec.a)), 'E', ts, TID_MOTION);
+                    std::fputs("}", out);
+                    break;
+                case TraceEvent::STEP_SPEED:
+                case TraceEvent::RAMP_DONE:
+                    json.counter("step_interval_us", ts, rec.a);
+                    break;
+                case TraceEvent::ACCELERATE:
+                case TraceEvent::DECELERATE:
+                    json.begin(monitor::traceEventName(rec.event), 'i', ts, TID_MOTION);
+                    std::fprintf(out, ",\"s\":\"t\",\"args\":{\"from_us\":%u,\"to_us\":%u}}", rec.a, rec.b);
+                    break;
+                case TraceEvent::MOTOR_COMMAND:
+                    json.begin(monitor::traceEventName(rec.event), 'i', ts, TID_MOTION);
+                    std::fprintf(out, ",\"s\":\"t\",\"args\":{\"command\":\"%s\",\"m1\":%d,\"m2\":%d}}",
+                                 commandName(rec.a), static_cast<int8_t>(rec.b & 0xFF),
+                                 static_cast<int8_t>((rec.b >> 8) & 0xFF));
+                    break;
+                default:
+                {
+                    bool isr = rec.event == TraceEvent::SMOOTH_STOP_DONE || rec.event == TraceEvent::SEGMENT_DONE ||
+                               rec.event == TraceEvent::STEP_MODE;
+                    json.begin(monitor::traceEventName(rec.event), 'i', ts, isr ? TID_ISR : TID_MOTION);
+                    std::fprintf(out, ",\"s\":\"t\",\"args\":{\"a\":%u,\"b\":%u}}", rec.a, rec.b);
+                    break;
+                }
+                }
+
+                // Rampen-Ende stammt aus der ISR - dort zusätzlich markieren
+                if (rec.event == TraceEvent::RAMP_DONE)
+                {
+                    json.begin("RAMP_DONE", 'i', ts, TID_ISR);
+                    std::fputs(",\"s\":\"t\"}", out);
+                }
+            }
+        } // namespace
+
+        void ChromeTraceWriter::add(const TraceRecord &rec)
+        {
+            records_[rec.index] = rec;
+        }
+
+        void ChromeTraceWriter::add(const telemetry::Sample &sample)
+        {
+            samples_.push_back(sample);
+        }
+
+        bool ChromeTraceWriter::write(FILE *out) const
+        {
+            JsonOut json(out);
+            std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+
+            json.threadName(TID_MOTION, "motion");
+            json.threadName(TID_ISR, "stepper ISR");
+
+            Unwrapper traceClock;
+            for (const auto &entry : records_)
+            {
+                writeRecord(json, entry.second, traceClock(entry.second.timestampUs));
+            }
+
+            Unwrapper sampleClock;
+            for (const auto &s : samples_)
+            {
+                uint64_t ts = sampleClock(s.timestampUs);
+                json.counter("step_interval_us", ts, s.timerRunning ? s.stepIntervalUs : 0);
+                json.counter("pen_down", ts, s.pen == PenState::DOWN ? 1 : 0);
+                json.counter("queue_depth", ts, s.queueDepth);
+            }
+
+            std::fputs("\n]}\n", out);
+            return std::ferror(out) == 0;
+        }
+
+        bool exportChromeTrace(const char *path)
+        {
+            FILE *out = std::fopen(path, "w");
+            if (!out)
+                return false;
+
+            ChromeTraceWriter writer;
+            uint32_t cursor = 0;
+            monitor::TraceRecord batch[64];
+            size_t n;
+            do
+            {
+                n = monitor::readTrace(cursor, batch, 64);
+                for (size_t i = 0; i < n; i++)
+                    writer.add(batch[i]);
+            } while (n == 64);
+
+            bool ok = writer.write(out);
+            return std::fclose(out) == 0 && ok;
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,62 @@
+#pragma once
+/**
+ * @file host/chrome_trace.h
+ * @brief Schreibt Trace-Einträge als Chrome-Trace-Event-JSON (Perfetto)
+ *
+ * Spannen (move, turn, goTo, penUp/penDown, plotChar) werden zu B/E-Paaren,
+ * Stepper-Ereignisse zu Instant-Events, Schrittintervalle zu Countern.
+ * Telemetrie-Messpunkte liefern zusätzliche Counter (Intervall, Stift).
+ *
+ * Die Datei lässt sich direkt in ui.perfetto.dev oder chrome://tracing laden.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "core/telemetry_frame.h"
+#include "monitor/trace.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        class ChromeTraceWriter
+        {
+        public:
+            /**
+             * @brief Trace-Eintrag übernehmen (Duplikate über die laufende Nummer verworfen)
+             */
+            void add(const monitor::TraceRecord &rec);
+
+            /**
+             * @brief Telemetrie-Messpunkt übernehmen
+             */
+            void add(const telemetry::Sample &sample);
+
+            size_t recordCount() const { return records_.size(); }
+            size_t sampleCount() const { return samples_.size(); }
+
+            /**
+             * @brief JSON schreiben
+             * @return false bei Schreibfehler
+             */
+            bool write(FILE *out) const;
+
+        private:
+            std::map<uint32_t, monitor::TraceRecord> records_; // sortiert nach laufender Nummer
+            std::vector<telemetry::Sample> samples_;
+        };
+
+        /**
+         * @brief Aktuellen Inhalt des Trace-Rings (Host-Build) als JSON-Datei schreiben
+         *
+         * Für Simulationen auf dem Host, die gegen trace_host.cpp gelinkt sind.
+         * @return false wenn die Datei nicht geschrieben werden konnte
+         */
+        bool exportChromeTrace(const char *path);
+
+    } // namespace host
+} // namespace tiny_turtle
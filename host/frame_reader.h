@@ -0,0 +1,84 @@
+#pragma once
+/**
+ * @file host/frame_reader.h
+ * @brief Zerlegt den seriellen Byte-Stream des Roboters in Roh-Frames
+ *
+ * Trennt am 0x00-Trenner, dekodiert COBS und übergibt das Roh-Frame an einen
+ * Callback. Eingestreuter Log-Text wird als ungültiges Frame gezählt und
+ * verworfen; ab dem nächsten Trenner ist der Leser wieder synchron.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "core/cobs.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        class FrameReader
+        {
+        public:
+            static constexpr size_t MAX_FRAME = 64;
+
+            /**
+             * @brief Stream bis EOF lesen
+             * @param fn Callback bool(const uint8_t *raw, size_t len) - false = ungültig
+             */
+            template <typename Fn>
+            void read(FILE *in, Fn &&fn)
+            {
+                std::vector<uint8_t> encoded;
+                uint8_t raw[MAX_FRAME];
+
+                int c;
+                while ((c = std::fgetc(in)) != EOF)
+                {
+                    if (c != 0)
+                    {
+                        // Übergroße "Frames" sind Log-Text o.ä. - nicht endlos puffern
+                        if (encoded.size() < 256)
+                            encoded.push_back(static_cast<uint8_t>(c));
+                        continue;
+                    }
+
+                    if (encoded.empty())
+                        continue;
+
+                    size_t len = 0;
+                    if (encoded.size() <= cobs::maxEncodedSize(MAX_FRAME))
+                        len = cobs::decode(encoded.data(), encoded.size(), raw);
+                    encoded.clear();
+
+                    if (len == 0 || !fn(static_cast<const uint8_t *>(raw), len))
+                        invalid_++;
+                }
+            }
+
+            unsigned long invalid() const { return invalid_; }
+
+        private:
+            unsigned long invalid_ = 0;
+        };
+
+        /**
+         * @brief Eingabedatei öffnen ("-" oder kein Argument = stdin)
+         */
+        inline FILE *openInput(int argc, char **argv)
+        {
+            if (argc > 1 && !(argv[1][0] == '-' && argv[1][1] == '\0'))
+            {
+                FILE *in = std::fopen(argv[1], "rb");
+                if (!in)
+                    std::perror(argv[1]);
+                return in;
+            }
+            return stdin;
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
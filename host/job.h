@@ -0,0 +1,327 @@
+#pragma once
+/**
+ * @file host/job.h
+ * @brief Zeichenaufträge für Host-Werkzeuge: Einlesen, Sortieren, Ausführen
+ *
+ * Ein Auftrag ist eine Textdatei mit einem Befehl pro Zeile ('#' = Kommentar):
+ *
+ *   pose X Y HEADING     Startpose (Standard 0 0 0)
+ *   text SCALE TEXT...   Text ab der aktuellen Pose (drawing::plotText)
+ *   forward MM           Geradeaus / backward MM / turn GRAD
+ *   pen up|down
+ *   goto X Y [draw]      Zu einer Koordinate fahren (motion::goTo)
+ *   stroke X Y X Y ...   Polylinie mit Stift unten
+ *   import DATEI         Polylinien aus DATEI, je Zeile "X Y X Y ..."
+ *
+ * Aufeinanderfolgende stroke-/import-Zeilen bilden eine Gruppe, deren
+ * Reihenfolge und Laufrichtung orderStrokes() auf kurze Leerfahrten
+ * optimiert. runJob() fährt den Auftrag über motion::MotionCore mit einem
+ * beliebigen HAL-Backend - Simulation, Schritt-Abfolge oder Protokoll.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/context.h"
+#include "core/types.h"
+#include "drawing/text_core.h"
+#include "motion/motion_core.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        enum class JobOp
+        {
+            POSE,
+            TEXT,
+            FORWARD,
+            BACKWARD,
+            TURN,
+            PEN_UP,
+            PEN_DOWN,
+            GOTO,
+            STROKES
+        };
+
+        using Polyline = std::vector<Point2D>;
+
+        struct JobCommand
+        {
+            JobOp op = JobOp::POSE;
+            float a = 0.0f;
+            float b = 0.0f;
+            float c = 0.0f;
+            bool draw = false;
+            std::string text;
+            std::vector<Polyline> strokes;
+        };
+
+        struct Job
+        {
+            std::vector<JobCommand> commands;
+            size_t strokeCount = 0;
+            size_t segmentCount = 0; // Liniensegmente aller Polylinien
+        };
+
+        inline bool parsePolyline(std::istringstream &in, Polyline &line)
+        {
+            float x, y;
+            while (in >> x)
+            {
+                if (!(in >> y))
+                    return false;
+                line.emplace_back(x, y);
+            }
+            return line.size() >= 2;
+        }
+
+        /**
+         * @brief Auftrag einlesen
+         * @return false mit Meldung auf stderr bei unbekanntem Befehl oder fehlender Datei
+         */
+        inline bool loadJob(const std::string &path, Job &job)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                std::fprintf(stderr, "%s: nicht lesbar\n", path.c_str());
+                return false;
+            }
+
+            auto strokeGroup = [&job]() -> JobCommand &
+            {
+                if (job.commands.empty() || job.commands.back().op != JobOp::STROKES)
+                {
+                    job.commands.emplace_back();
+                    job.commands.back().op = JobOp::STROKES;
+                }
+                return job.commands.back();
+            };
+            auto addStroke = [&job, &strokeGroup](Polyline &&line)
+            {
+                job.strokeCount++;
+                job.segmentCount += line.size() - 1;
+                strokeGroup().strokes.push_back(std::move(line));
+            };
+
+            std::string raw;
+            int lineNo = 0;
+            while (std::getline(file, raw))
+            {
+                lineNo++;
+                std::istringstream in(raw.substr(0, raw.find('#')));
+                std::string cmd;
+                if (!(in >> cmd))
+                    continue;
+
+                JobCommand c;
+                bool ok = true;
+                if (cmd == "pose")
+                    ok = static_cast<bool>(in >> c.a >> c.b >> c.c);
+                else if (cmd == "text")
+                {
+                    c.op = JobOp::TEXT;
+                    ok = static_cast<bool>(in >> c.a);
+                    std::getline(in >> std::ws, c.text);
+                }
+                else if (cmd == "forward" || cmd == "backward" || cmd == "turn")
+                {
+                    c.op = cmd == "forward" ? JobOp::FORWARD : (cmd == "backward" ? JobOp::BACKWARD : JobOp::TURN);
+                    ok = static_cast<bool>(in >> c.a);
+                }
+                else if (cmd == "pen")
+                {
+                    std::string state;
+                    in >> state;
+                    c.op = state == "down" ? JobOp::PEN_DOWN : JobOp::PEN_UP;
+                    ok = state == "up" || state == "down";
+                }
+                else if (cmd == "goto")
+                {
+                    c.op = JobOp::GOTO;
+                    std::string flag;
+                    ok = static_cast<bool>(in >> c.a >> c.b);
+                    c.draw = (in >> flag) && flag == "draw";
+                }
+                else if (cmd == "stroke")
+                {
+                    Polyline line;
+                    if (!parsePolyline(in, line))
+                        ok = false;
+                    else
+                    {
+                        addStroke(std::move(line));
+                        continue;
+                    }
+                }
+                else if (cmd == "import")
+                {
+                    std::string name;
+                    in >> name;
+                    std::ifstream src(name);
+                    ok = static_cast<bool>(src);
+                    for (std::string row; ok && std::getline(src, row);)
+                    {
+                        std::istringstream rowIn(row);
+                        Polyline line;
+                        if (parsePolyline(rowIn, line))
+                            addStroke(std::move(line));
+                    }
+                    if (ok)
+                        continue;
+                }
+                else
+                    ok = false;
+
+                if (!ok)
+                {
+                    std::fprintf(stderr, "%s:%d: ungültige Zeile: %s\n", path.c_str(), lineNo, raw.c_str());
+                    return false;
+                }
+                job.commands.push_back(std::move(c));
+            }
+            return true;
+        }
+
+        inline float distance2(const Point2D &a, const Point2D &b)
+        {
+            float dx = a.x - b.x;
+            float dy = a.y - b.y;
+            return dx * dx + dy * dy;
+        }
+
+        /**
+         * @brief Polylinien nach nächstem Nachbarn ordnen, ggf. umgedreht
+         * @param start Stiftposition vor der ersten Linie
+         * @return Länge der Leerfahrten in mm
+         */
+        inline float orderStrokes(std::vector<Polyline> &strokes, Point2D start)
+        {
+            std::vector<Polyline> ordered;
+            ordered.reserve(strokes.size());
+            std::vector<bool> used(strokes.size(), false);
+            float travel = 0.0f;
+
+            for (size_t n = 0; n < strokes.size(); n++)
+            {
+                size_t best = 0;
+                bool reverse = false;
+                float bestDist = INFINITY;
+                for (size_t i = 0; i < strokes.size(); i++)
+                {
+                    if (used[i])
+                        continue;
+                    float front = distance2(start, strokes[i].front());
+                    float back = distance2(start, strokes[i].back());
+                    if (front < bestDist)
+                    {
+                        bestDist = front;
+                        best = i;
+                        reverse = false;
+                    }
+                    if (back < bestDist)
+                    {
+                        bestDist = back;
+                        best = i;
+                        reverse = true;
+                    }
+                }
+
+                used[best] = true;
+                travel += std::sqrt(bestDist);
+                ordered.push_back(std::move(strokes[best]));
+                if (reverse)
+                    std::reverse(ordered.back().begin(), ordered.back().end());
+                start = ordered.back().back();
+            }
+            strokes = std::move(ordered);
+            return travel;
+        }
+
+        /**
+         * @brief Alle Polylinien-Gruppen sortieren (Startpunkt: Ende der Befehle davor)
+         * @return Länge der Leerfahrten in mm
+         */
+        inline float orderJob(Job &job)
+        {
+            Point2D at(0.0f, 0.0f);
+            float travel = 0.0f;
+            for (JobCommand &c : job.commands)
+            {
+                if (c.op == JobOp::POSE || c.op == JobOp::GOTO)
+                    at = Point2D(c.a, c.b);
+                else if (c.op == JobOp::STROKES)
+                {
+                    travel += orderStrokes(c.strokes, at);
+                    if (!c.strokes.empty())
+                        at = c.strokes.back().back();
+                }
+            }
+            return travel;
+        }
+
+        /**
+         * @brief Eine Polylinie zeichnen: Leerfahrt zum Anfang, Stift einmal ab und wieder hoch
+         */
+        template <class Hal>
+        void drawPolyline(motion::MotionCore<Hal> &motion, Pose &pose, const Polyline &line)
+        {
+            motion.goTo(pose, line.front().x, line.front().y, false);
+            motion.hal().penDown();
+            for (size_t i = 1; i < line.size(); i++)
+                motion.goTo(pose, line[i].x, line[i].y, false);
+            motion.hal().penUp();
+        }
+
+        /**
+         * @brief Auftrag über ein HAL-Backend fahren
+         */
+        template <class Hal>
+        void runJob(const Job &job, motion::MotionCore<Hal> &motion, Pose &pose)
+        {
+            for (const JobCommand &c : job.commands)
+            {
+                switch (c.op)
+                {
+                case JobOp::POSE:
+                    pose = {c.a, c.b, c.c};
+                    motion.hal().reportPose(pose);
+                    break;
+                case JobOp::TEXT:
+                    drawing::plotText(motion, c.text, static_cast<int>(c.a));
+                    break;
+                case JobOp::FORWARD:
+                    motion.forward(c.a);
+                    break;
+                case JobOp::BACKWARD:
+                    motion.backward(c.a);
+                    break;
+                case JobOp::TURN:
+                    motion.turn(c.a);
+                    break;
+                case JobOp::PEN_UP:
+                    motion.hal().penUp();
+                    break;
+                case JobOp::PEN_DOWN:
+                    motion.hal().penDown();
+                    break;
+                case JobOp::GOTO:
+                    motion.goTo(pose, c.a, c.b, c.draw);
+                    break;
+                case JobOp::STROKES:
+                    for (const Polyline &line : c.strokes)
+                        drawPolyline(motion, pose, line);
+                    break;
+                }
+            }
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,152 @@
+/**
+ * @file host/job_compiler.cpp
+ * @brief Zeichenauftrag offline planen und als Schritt-Abfolge ausgeben
+ *
+ * Verwendung:
+ *   job_compiler auftrag.job -o auftrag.ttl         # Binär (EMBED_FILES)
+ *   job_compiler auftrag.job --c hello > hello.h    # C-Array für das Gerät
+ *   job_compiler auftrag.job --check                # Planung gegen Abspielen prüfen
+ *
+ * Plant den Auftrag (host/job.h: Text, importierte Pfade, Reihenfolge der
+ * Linien, Rampen) mit motion::MotionCore auf host::TimelineHal und schreibt
+ * die Abfolge im Format aus core/step_timeline.h. --check fährt denselben
+ * Auftrag zusätzlich direkt über host::SimHal, spielt die Abfolge mit
+ * motion::playTimeline() in eine zweite Simulation und vergleicht beide
+ * Schritt für Schritt (Exit-Code 1 bei Abweichung).
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/kinematics.h"
+#include "motion/motion_core.h"
+#include "motion/timeline_player.h"
+#include "job.h"
+#include "sim_hal.h"
+#include "timeline_hal.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    HotState makeHot()
+    {
+        HotState hot{};
+        hot.direction = 1;
+        return hot;
+    }
+
+    template <class Hal>
+    void runOn(const host::Job &job, Hal &hal)
+    {
+        HotState hot = makeHot();
+        Pose pose = {0.0f, 0.0f, 0.0f};
+        motion::MotionCore<Hal> core(hal, hot);
+        host::runJob(job, core, pose);
+        hal.stopMotors();
+    }
+
+    bool check(const host::Job &job, const std::vector<uint8_t> &bytes)
+    {
+        host::SimHal direct;
+        runOn(job, direct);
+
+        host::SimHal played;
+        motion::TimelineStats stats;
+        bool ok = motion::playTimeline(played, bytes.data(), bytes.size(), &stats);
+
+        ok = ok && direct.streamHash() == played.streamHash() && direct.position(1) == played.position(1) &&
+             direct.position(2) == played.position(2) && direct.reported(1) == played.reported(1) &&
+             direct.reported(2) == played.reported(2) && direct.nowUs() == played.nowUs() &&
+             direct.servoMoves() == played.servoMoves() && direct.segments() == played.segments() &&
+             direct.drawing() == played.drawing();
+
+        std::fprintf(stderr, "check: %llu Schritte, %u Servo, %.1f s direkt / %.1f s abgespielt, Hash %016llx/%016llx %s\n",
+                     static_cast<unsigned long long>(direct.stepCalls() / 2), direct.servoMoves(), direct.nowUs() / 1e6,
+                     played.nowUs() / 1e6, static_cast<unsigned long long>(direct.streamHash()),
+                     static_cast<unsigned long long>(played.streamHash()), ok ? "OK" : "FEHLER");
+        return ok;
+    }
+
+    void writeCArray(FILE *out, const std::string &name, const std::vector<uint8_t> &bytes)
+    {
+        std::fprintf(out, "// Erzeugt von host/job_compiler - nicht von Hand ändern\n#pragma once\n#include <cstddef>\n#include <cstdint>\n\n");
+        std::fprintf(out, "static const uint8_t %s_timeline[] = {", name.c_str());
+        for (size_t i = 0; i < bytes.size(); i++)
+            std::fprintf(out, "%s0x%02x,", i % 16 ? " " : "\n    ", bytes[i]);
+        std::fprintf(out, "\n};\nstatic constexpr size_t %s_timeline_size = sizeof(%s_timeline);\n", name.c_str(),
+                     name.c_str());
+    }
+
+    uint32_t plannedStepsPerMmFx()
+    {
+#if TT_KINEMATICS_RUNTIME
+        return CalibratedKinematics::factors().stepsPerMmFx;
+#else
+        return ActiveKinematics::STEPS_PER_MM_FX;
+#endif
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *input = nullptr;
+    const char *output = nullptr;
+    const char *arrayName = nullptr;
+    bool doCheck = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else if (std::strcmp(argv[i], "--c") == 0 && i + 1 < argc)
+            arrayName = argv[++i];
+        else if (std::strcmp(argv[i], "--check") == 0)
+            doCheck = true;
+        else if (!input && argv[i][0] != '-')
+            input = argv[i];
+        else
+        {
+            input = nullptr;
+            break;
+        }
+    }
+    if (!input)
+    {
+        std::fprintf(stderr, "Verwendung: job_compiler AUFTRAG [-o DATEI.ttl] [--c NAME] [--check]\n");
+        return 2;
+    }
+
+    host::Job job;
+    if (!host::loadJob(input, job))
+        return 1;
+    float travel = host::orderJob(job);
+
+    host::TimelineHal writer;
+    runOn(job, writer);
+    uint64_t steps = writer.steps();
+    std::vector<uint8_t> bytes = writer.finish(plannedStepsPerMmFx());
+
+    std::fprintf(stderr, "job_compiler: %zu Linien (%zu Segmente), Leerfahrt %.0f mm, %llu Schritte -> %zu Datensätze, %zu Bytes\n",
+                 job.strokeCount, job.segmentCount, travel, static_cast<unsigned long long>(steps),
+                 (bytes.size() - timeline::HEADER_SIZE) / timeline::RECORD_SIZE, bytes.size());
+
+    if (output)
+    {
+        FILE *out = std::fopen(output, "wb");
+        if (!out || std::fwrite(bytes.data(), 1, bytes.size(), out) != bytes.size() || std::fclose(out) != 0)
+        {
+            std::perror(output);
+            return 1;
+        }
+    }
+    if (arrayName)
+        writeCArray(stdout, arrayName, bytes);
+
+    if (doCheck && !check(job, bytes))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+/**
+ * @file host/mock_pins.h
+ * @brief Pin-Senke für Host-Builds der Stepper-Backends
+ *
+ * Erfüllt die Sink-Schnittstelle aus hal/stepper_backend.h und zeichnet jede
+ * Pegeländerung und jeden STEP-Puls mit einer simulierten Zeit auf. Damit
+ * lässt sich die Treiber-Logik ohne Hardware nachprüfen (host/stepper_sim).
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        class MockPinSink
+        {
+        public:
+            static constexpr uint8_t PULSE = 0xFF; // Event.pin für STEP-Pulse
+
+            struct Event
+            {
+                uint32_t timeUs;
+                uint8_t pin;   // GPIO oder PULSE
+                uint8_t value; // Pegel bzw. Motor-Index bei PULSE
+            };
+
+            void write(uint8_t pin, bool level)
+            {
+                if (pin < levels_.size())
+                    levels_[pin] = level;
+                events_.push_back({nowUs_, pin, static_cast<uint8_t>(level)});
+            }
+
+            void pulse(uint8_t motor)
+            {
+                events_.push_back({nowUs_, PULSE, motor});
+            }
+
+            void advance(uint32_t us) { nowUs_ += us; }
+            bool level(uint8_t pin) const { return pin < levels_.size() && levels_[pin]; }
+            const std::vector<Event> &events() const { return events_; }
+            void clear() { events_.clear(); }
+
+        private:
+            uint32_t nowUs_ = 0;
+            std::array<bool, 64> levels_{};
+            std::vector<Event> events_;
+        };
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,143 @@
+/**
+ * @file host/motion_sim.cpp
+ * @brief Bewegungs-Kerne (motion/motion_core.h) gegen Host-Backends fahren
+ *
+ * Verwendung:
+ *   motion_sim           # Prüfungen, Exit-Code 1 bei Abweichung
+ *   motion_sim --bench   # zusätzlich Schritte pro Sekunde je Backend
+ *
+ * Fährt ein Quadrat und eine Fahrt mit Bumper-Kontakt über host::SimHal,
+ * zeichnet die zweite mit host::RecordingHal auf und spielt das Protokoll in
+ * eine frische Simulation ein. Beide müssen Schritt für Schritt übereinstimmen.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "core/kinematics.h"
+#include "motion/motion_core.h"
+#include "recording_hal.h"
+#include "sim_hal.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    template <class Hal>
+    using Core = motion::MotionCore<Hal>;
+
+    HotState makeHot()
+    {
+        HotState hot{};
+        hot.direction = 1;
+        return hot;
+    }
+
+    bool checkSquare()
+    {
+        host::SimHal sim;
+        HotState hot = makeHot();
+        Core<host::SimHal> core(sim, hot);
+
+        for (int i = 0; i < 4; i++)
+        {
+            core.move(50.0f);
+            core.turn(90.0f);
+        }
+
+        int32_t line = static_cast<int32_t>(ActiveKinematics::stepsForMm(50.0f));
+        int32_t corner = static_cast<int32_t>(ActiveKinematics::stepsForDegrees(90.0f));
+        int32_t expected1 = 4 * (line - corner);
+        int32_t expected2 = 4 * (line + corner);
+
+        bool ok = sim.position(1) == expected1 && sim.position(2) == expected2 &&
+                  sim.reported(1) == expected1 && sim.reported(2) == expected2 && sim.segments() == 8;
+        std::fprintf(stderr, "square: Position %d/%d (erwartet %d/%d), %u Segmente, %.2f s %s\n", sim.position(1),
+                     sim.position(2), expected1, expected2, sim.segments(), sim.nowUs() / 1e6, ok ? "OK" : "FEHLER");
+        return ok;
+    }
+
+    bool sameRun(const host::SimHal &a, const host::SimHal &b)
+    {
+        return a.streamHash() == b.streamHash() && a.position(1) == b.position(1) && a.position(2) == b.position(2) &&
+               a.reported(1) == b.reported(1) && a.reported(2) == b.reported(2) && a.nowUs() == b.nowUs() &&
+               a.servoMoves() == b.servoMoves() && a.segments() == b.segments() && a.drawing() == b.drawing();
+    }
+
+    void bounceRun(host::SimHal &sim, HotState &hot)
+    {
+        sim.penDown();
+        sim.pressBumper(4, true);
+        Core<host::SimHal>(sim, hot).move(20.0f, true);
+    }
+
+    bool checkRecordReplay()
+    {
+        // Referenz ohne Rekorder
+        host::SimHal plain(42);
+        HotState plainHot = makeHot();
+        bounceRun(plain, plainHot);
+
+        // Gleicher Lauf durch den Rekorder
+        host::SimHal sim(42);
+        HotState hot = makeHot();
+        host::RecordingHal<host::SimHal> rec(sim);
+        sim.penDown();
+        sim.pressBumper(4, true);
+        Core<host::RecordingHal<host::SimHal>>(rec, hot).move(20.0f, true);
+
+        host::SimHal copy;
+        copy.penDown();
+        host::replay(rec.log(), copy);
+
+        bool ok = sameRun(plain, sim) && sameRun(sim, copy) && hot.direction == -1 && sim.segments() >= 3 &&
+                  sim.servoMoves() == 3;
+        std::fprintf(stderr, "replay: %zu Aufrufe, %u Segmente, Position %d/%d, Wiedergabe %d/%d %s\n", rec.log().size(),
+                     sim.segments(), sim.position(1), sim.position(2), copy.position(1), copy.position(2),
+                     ok ? "OK" : "FEHLER");
+        return ok;
+    }
+
+    template <class Hal>
+    double stepsPerSecond(Hal &hal, host::SimHal &sim, int moves)
+    {
+        HotState hot = makeHot();
+        Core<Hal> core(hal, hot);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < moves; i++)
+            core.move(100.0f);
+        // Simulation nicht hinter die zweite Zeitmessung schieben lassen
+        asm volatile("" : : "r"(&sim) : "memory");
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return sim.stepCalls() / 2 / seconds;
+    }
+
+    void bench()
+    {
+        constexpr int MOVES = 200;
+
+        host::SimHal sim;
+        double simRate = stepsPerSecond(sim, sim, MOVES);
+
+        host::SimHal inner;
+        host::RecordingHal<host::SimHal> rec(inner);
+        double recRate = stepsPerSecond(rec, inner, MOVES);
+
+        std::printf("backend,steps,msteps_per_s\n");
+        std::printf("sim,%llu,%.1f\n", static_cast<unsigned long long>(sim.stepCalls() / 2), simRate / 1e6);
+        std::printf("recording,%llu,%.1f\n", static_cast<unsigned long long>(inner.stepCalls() / 2), recRate / 1e6);
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool ok = checkSquare();
+    ok = checkRecordReplay() && ok;
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+        bench();
+
+    return ok ? 0 : 1;
+}
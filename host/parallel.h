@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file host/parallel.h
+ * @brief Schleifen über alle Kerne verteilen (Host-Werkzeuge)
+ *
+ * parallelFor() vergibt Blöcke von Indizes dynamisch an Threads. Jeder
+ * Index schreibt nur in seinen eigenen Ergebnis-Platz - dann hängt das
+ * Ergebnis nicht davon ab, wie viele Threads laufen oder welcher welchen
+ * Block bekommt.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+        /**
+         * @brief Anzahl Threads: 0 = alle Kerne
+         */
+        inline unsigned resolveThreads(unsigned threads)
+        {
+            if (threads != 0)
+                return threads;
+            unsigned cores = std::thread::hardware_concurrency();
+            return cores ? cores : 1;
+        }
+
+        /**
+         * @brief fn(i) für alle i in [0, count) auf bis zu threads Threads
+         * @param grain Indizes pro vergebenem Block
+         */
+        template <class Fn>
+        void parallelFor(size_t count, unsigned threads, Fn &&fn, size_t grain = 1)
+        {
+            threads = std::min<size_t>(resolveThreads(threads), (count + grain - 1) / std::max<size_t>(grain, 1));
+            if (threads <= 1)
+            {
+                for (size_t i = 0; i < count; i++)
+                    fn(i);
+                return;
+            }
+
+            std::atomic<size_t> next{0};
+            auto worker = [&]()
+            {
+                for (;;)
+                {
+                    size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                    if (begin >= count)
+                        return;
+                    size_t end = std::min(count, begin + grain);
+                    for (size_t i = begin; i < end; i++)
+                        fn(i);
+                }
+            };
+
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; t++)
+                pool.emplace_back(worker);
+            worker();
+            for (std::thread &t : pool)
+                t.join();
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,223 @@
+/**
+ * @file host/path_bench.cpp
+ * @brief PathBuffer-Kernel (core/path_kernels.h) gegen Punkt-für-Punkt-Rechnung
+ *
+ * Verwendung:
+ *   path_bench           # Prüfungen, Exit-Code 1 bei Abweichung
+ *   path_bench --bench   # zusätzlich Punkte pro Sekunde, CSV
+ *
+ * Referenz ist dieselbe Rechnung auf einem std::vector<Point2D> mit
+ * std::sqrt/std::atan2 je Punkt, wie in motion::goTo(). Geprüft werden die
+ * float-Kernel (Host) und die Festkomma-Kernel (Gerät) auf einer festen
+ * Zufalls-Polylinie.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/path_kernels.h"
+#include "core/types.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    constexpr size_t POINTS = 1 << 20;
+
+    struct Reference
+    {
+        std::vector<Point2D> points;
+        std::vector<float> lengths;
+        std::vector<float> angles;
+        float length = 0.0f;
+    };
+
+    std::vector<Point2D> makePoints(size_t count)
+    {
+        uint32_t rng = 7;
+        auto uniform = [&rng](float min, float max)
+        {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            return min + (max - min) * (rng & 0xFFFFFF) / 16777216.0f;
+        };
+
+        std::vector<Point2D> points(count);
+        Point2D p(500.0f, 500.0f);
+        for (Point2D &q : points)
+        {
+            p.x += uniform(-20.0f, 20.0f);
+            p.y += uniform(-20.0f, 20.0f);
+            q = p;
+        }
+        return points;
+    }
+
+    void referenceRun(Reference &ref, const PathTransform &t)
+    {
+        for (Point2D &p : ref.points)
+        {
+            float x = p.x;
+            p.x = t.a * x + t.b * p.y + t.tx;
+            p.y = t.c * x + t.d * p.y + t.ty;
+        }
+        ref.lengths.resize(ref.points.size() - 1);
+        ref.angles.resize(ref.points.size() - 1);
+        ref.length = 0.0f;
+        for (size_t i = 0; i + 1 < ref.points.size(); i++)
+        {
+            float dx = ref.points[i + 1].x - ref.points[i].x;
+            float dy = ref.points[i + 1].y - ref.points[i].y;
+            ref.lengths[i] = std::sqrt(dx * dx + dy * dy);
+            ref.angles[i] = std::atan2(static_cast<double>(dx), static_cast<double>(dy)) * 180.0 / M_PI;
+            ref.length += ref.lengths[i];
+        }
+    }
+
+    template <class Buffer>
+    void fill(Buffer &buffer, const std::vector<Point2D> &points)
+    {
+        using Coord = typename Buffer::CoordType;
+        buffer.clear();
+        for (const Point2D &p : points)
+            buffer.push(toPathCoord<Coord>(p.x), toPathCoord<Coord>(p.y));
+    }
+
+    template <class Buffer, class Out>
+    void kernelRun(Buffer &buffer, const PathTransform &t, Out *lengths, Out *angles)
+    {
+        transformPath(buffer, t);
+        segmentLengths(buffer, lengths);
+        segmentAngles(buffer, angles);
+    }
+
+    float angleError(float a, float b)
+    {
+        float d = std::fabs(a - b);
+        return d > 180.0f ? 360.0f - d : d;
+    }
+
+    bool checkFloat(const Reference &ref, const std::vector<Point2D> &input, const PathTransform &t)
+    {
+        std::vector<uint8_t> memory(POINTS * 9 + 256);
+        BumpArena arena(memory.data(), memory.size());
+        PathBufferF path(arena, POINTS);
+        fill(path, input);
+
+        std::vector<float> lengths(POINTS), angles(POINTS);
+        kernelRun(path, t, lengths.data(), angles.data());
+
+        float maxAngle = 0.0f, maxLength = 0.0f;
+        for (size_t i = 0; i + 1 < POINTS; i++)
+        {
+            maxAngle = std::max(maxAngle, angleError(angles[i], ref.angles[i]));
+            maxLength = std::max(maxLength, std::fabs(lengths[i] - ref.lengths[i]));
+        }
+        PathBounds<float> b = pathBounds(path);
+        float total = pathLength(path);
+
+        bool ok = maxAngle < 0.001f && maxLength < 1e-4f && path.x()[POINTS - 1] == ref.points.back().x &&
+                  std::fabs(total - ref.length) < ref.length * 1e-4f && b.minX <= b.maxX && b.minY <= b.maxY;
+        std::fprintf(stderr, "float: Winkel max. %.5f°, Länge max. %.6f mm, gesamt %.0f/%.0f mm %s\n", maxAngle,
+                     maxLength, total, ref.length, ok ? "OK" : "FEHLER");
+        return ok;
+    }
+
+    bool checkFixed(const Reference &ref, const std::vector<Point2D> &input, const PathTransform &t)
+    {
+        std::vector<uint8_t> memory(POINTS * 9 + 256);
+        BumpArena arena(memory.data(), memory.size());
+        PathBufferQ path(arena, POINTS);
+        fill(path, input);
+
+        std::vector<int32_t> lengths(POINTS), angles(POINTS);
+        kernelRun(path, t, lengths.data(), angles.data());
+
+        // Koordinaten sind auf 0.01 mm gerundet: Winkel und Längen gegen die gerundeten Punkte prüfen
+        float maxAngle = 0.0f, maxLength = 0.0f, maxPoint = 0.0f;
+        const int32_t *xs = path.x();
+        const int32_t *ys = path.y();
+        for (size_t i = 0; i + 1 < POINTS; i++)
+        {
+            double dx = static_cast<double>(xs[i + 1]) - xs[i];
+            double dy = static_cast<double>(ys[i + 1]) - ys[i];
+            float exactAngle = static_cast<float>(std::atan2(dx, dy) * 180.0 / M_PI);
+            float exactLength = static_cast<float>(std::sqrt(dx * dx + dy * dy));
+            maxAngle = std::max(maxAngle, angleError(angles[i] / 100.0f, exactAngle));
+            maxLength = std::max(maxLength, std::fabs(lengths[i] - exactLength));
+            maxPoint = std::max(maxPoint, std::fabs(pathCoordToMm(xs[i]) - ref.points[i].x));
+        }
+        float total = pathLength(path);
+
+        bool ok = maxAngle <= 0.02f && maxLength <= 1.0f && maxPoint < 0.02f &&
+                  std::fabs(total - ref.length) < ref.length * 1e-3f;
+        std::fprintf(stderr, "int32: Winkel max. %.3f°, Länge max. %.2f Einheiten, Punkt max. %.3f mm, gesamt %.0f mm %s\n",
+                     maxAngle, maxLength, maxPoint, total, ok ? "OK" : "FEHLER");
+        return ok;
+    }
+
+    template <class Fn>
+    double pointsPerSecond(Fn &&fn, int rounds)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++)
+            fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(POINTS) * rounds / seconds;
+    }
+
+    void bench(const std::vector<Point2D> &input, const PathTransform &t)
+    {
+        constexpr int ROUNDS = 20;
+
+        Reference ref;
+        ref.points = input;
+        double aos = pointsPerSecond([&]
+                                     { referenceRun(ref, t); asm volatile("" : : "r"(ref.angles.data()) : "memory"); },
+                                     ROUNDS);
+
+        std::vector<uint8_t> memory(2 * (POINTS * 9 + 256));
+        BumpArena arena(memory.data(), memory.size());
+        PathBufferF pathF(arena, POINTS);
+        PathBufferQ pathQ(arena, POINTS);
+        fill(pathF, input);
+        fill(pathQ, input);
+        std::vector<float> lf(POINTS), af(POINTS);
+        std::vector<int32_t> lq(POINTS), aq(POINTS);
+
+        double soaF = pointsPerSecond([&]
+                                      { kernelRun(pathF, t, lf.data(), af.data()); asm volatile("" : : "r"(af.data()) : "memory"); },
+                                      ROUNDS);
+        double soaQ = pointsPerSecond([&]
+                                      { kernelRun(pathQ, t, lq.data(), aq.data()); asm volatile("" : : "r"(aq.data()) : "memory"); },
+                                      ROUNDS);
+
+        std::printf("variant,mpoints_per_s\n");
+        std::printf("aos_per_point,%.1f\n", aos / 1e6);
+        std::printf("soa_float,%.1f\n", soaF / 1e6);
+        std::printf("soa_int32,%.1f\n", soaQ / 1e6);
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<Point2D> input = makePoints(POINTS);
+    PathTransform t = PathTransform::make(1.5f, 30.0f, 100.0f, -50.0f);
+
+    Reference ref;
+    ref.points = input;
+    referenceRun(ref, t);
+
+    bool ok = checkFloat(ref, input, t);
+    ok = checkFixed(ref, input, t) && ok;
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+        bench(input, t);
+
+    return ok ? 0 : 1;
+}
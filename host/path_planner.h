@@ -0,0 +1,377 @@
+#pragma once
+/**
+ * @file host/path_planner.h
+ * @brief Planung großer Zeichnungen auf allen Kernen (Host)
+ *
+ * Für importierte Grafiken mit zehntausenden Linien. Die Stufen:
+ *
+ *   1. flattenStroke() / simplifyPolyline()   je Linie parallel
+ *   2. orderTiled()                           je Kachel parallel, danach Naht
+ *   3. startPoses()                           sequentiell, nur Geometrie
+ *   4. profileStrokes()                       je Linie parallel (MotionCore)
+ *
+ * Jede Linie beginnt und endet im Stillstand mit Stift oben, ihr Anteil an
+ * der Schritt-Abfolge hängt also nur von der Pose davor ab. Stufe 3 rechnet
+ * diese Posen mit motion::advancePose() vorab aus, Stufe 4 plant danach
+ * jede Linie für sich mit einem eigenen host::TimelineHal. Zusammengesetzt
+ * ergibt das Byte für Byte dieselbe Abfolge wie ein einziger Lauf über alle
+ * Linien - unabhängig von der Anzahl Threads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/context.h"
+#include "core/step_timeline.h"
+#include "motion/motion_core.h"
+#include "job.h"
+#include "parallel.h"
+#include "timeline_hal.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        /**
+         * @brief Eingabe-Linie: Polylinie oder Kette kubischer Bézier-Kurven
+         *
+         * Bei cubic liegen die Punkte als p0 c1 c2 p1 c1 c2 p2 ... vor.
+         */
+        struct Stroke
+        {
+            std::vector<Point2D> points;
+            bool cubic = false;
+        };
+
+        struct PlannerOptions
+        {
+            float flattenToleranceMm = 0.2f;  // Max. Abstand Sehne - Kurve
+            float simplifyToleranceMm = 0.1f; // Douglas-Peucker
+            float tileMm = 100.0f;            // Kantenlänge der Sortier-Kacheln
+            unsigned threads = 0;             // 0 = alle Kerne
+        };
+
+        struct PlanStats
+        {
+            double flattenMs = 0;
+            double orderMs = 0;
+            double poseMs = 0;
+            double profileMs = 0;
+            size_t strokes = 0;
+            size_t segments = 0; // Nach dem Vereinfachen
+            size_t records = 0;
+            uint64_t steps = 0;
+            float travelMm = 0;
+        };
+
+        // ------------------------------------------------------------------
+        // 1. Kurven abflachen, Polylinien vereinfachen
+        // ------------------------------------------------------------------
+
+        inline void flattenCubic(const Point2D &p0, const Point2D &c1, const Point2D &c2, const Point2D &p1,
+                                 float tolerance, Polyline &out, int depth = 0)
+        {
+            // Flachheit: Abstand der Kontrollpunkte zur Sehne (Obergrenze)
+            float ux = 3.0f * c1.x - 2.0f * p0.x - p1.x;
+            float uy = 3.0f * c1.y - 2.0f * p0.y - p1.y;
+            float vx = 3.0f * c2.x - p0.x - 2.0f * p1.x;
+            float vy = 3.0f * c2.y - p0.y - 2.0f * p1.y;
+            float flat = std::max(ux * ux, vx * vx) + std::max(uy * uy, vy * vy);
+
+            if (depth >= 16 || flat <= 16.0f * tolerance * tolerance)
+            {
+                out.push_back(p1);
+                return;
+            }
+
+            // De Casteljau bei t = 0.5
+            Point2D a((p0.x + c1.x) * 0.5f, (p0.y + c1.y) * 0.5f);
+            Point2D b((c1.x + c2.x) * 0.5f, (c1.y + c2.y) * 0.5f);
+            Point2D c((c2.x + p1.x) * 0.5f, (c2.y + p1.y) * 0.5f);
+            Point2D d((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f);
+            Point2D e((b.x + c.x) * 0.5f, (b.y + c.y) * 0.5f);
+            Point2D m((d.x + e.x) * 0.5f, (d.y + e.y) * 0.5f);
+            flattenCubic(p0, a, d, m, tolerance, out, depth + 1);
+            flattenCubic(m, e, c, p1, tolerance, out, depth + 1);
+        }
+
+        inline Polyline flattenStroke(const Stroke &stroke, float tolerance)
+        {
+            if (!stroke.cubic || stroke.points.size() < 4)
+                return stroke.points;
+
+            Polyline out;
+            out.push_back(stroke.points[0]);
+            for (size_t i = 0; i + 3 < stroke.points.size(); i += 3)
+                flattenCubic(stroke.points[i], stroke.points[i + 1], stroke.points[i + 2], stroke.points[i + 3],
+                             tolerance, out);
+            return out;
+        }
+
+        /**
+         * @brief Douglas-Peucker, iterativ
+         */
+        inline void simplifyPolyline(Polyline &line, float tolerance)
+        {
+            if (line.size() < 3)
+                return;
+
+            std::vector<bool> keep(line.size(), false);
+            keep.front() = keep.back() = true;
+            std::vector<std::pair<size_t, size_t>> stack = {{0, line.size() - 1}};
+            float tol2 = tolerance * tolerance;
+
+            while (!stack.empty())
+            {
+                auto [first, last] = stack.back();
+                stack.pop_back();
+
+                const Point2D &a = line[first];
+                const Point2D &b = line[last];
+                float dx = b.x - a.x;
+                float dy = b.y - a.y;
+                float len2 = dx * dx + dy * dy;
+
+                size_t worst = first;
+                float worstDist2 = 0.0f;
+                for (size_t i = first + 1; i < last; i++)
+                {
+                    float px = line[i].x - a.x;
+                    float py = line[i].y - a.y;
+                    float cross = px * dy - py * dx;
+                    float d2 = len2 > 0.0f ? cross * cross / len2 : px * px + py * py;
+                    if (d2 > worstDist2)
+                    {
+                        worstDist2 = d2;
+                        worst = i;
+                    }
+                }
+
+                if (worstDist2 > tol2)
+                {
+                    keep[worst] = true;
+                    stack.push_back({first, worst});
+                    stack.push_back({worst, last});
+                }
+            }
+
+            size_t n = 0;
+            for (size_t i = 0; i < line.size(); i++)
+                if (keep[i])
+                    line[n++] = line[i];
+            line.resize(n);
+        }
+
+        // ------------------------------------------------------------------
+        // 2. Reihenfolge: nächster Nachbar je Kachel, Kacheln in Schlangenlinie
+        // ------------------------------------------------------------------
+
+        /**
+         * @brief Linien kachelweise ordnen
+         * @param start Stiftposition vor der ersten Linie
+         * @return Länge der Leerfahrten in mm
+         */
+        inline float orderTiled(std::vector<Polyline> &lines, Point2D start, float tileMm, unsigned threads)
+        {
+            if (lines.empty())
+                return 0.0f;
+
+            float minX = lines[0].front().x, minY = lines[0].front().y;
+            float maxX = minX, maxY = minY;
+            for (const Polyline &l : lines)
+            {
+                minX = std::min(minX, l.front().x);
+                maxX = std::max(maxX, l.front().x);
+                minY = std::min(minY, l.front().y);
+                maxY = std::max(maxY, l.front().y);
+            }
+
+            size_t cols = static_cast<size_t>((maxX - minX) / tileMm) + 1;
+            size_t rows = static_cast<size_t>((maxY - minY) / tileMm) + 1;
+
+            // Kacheln in Schlangenlinie nummerieren: Zeile für Zeile, abwechselnd links/rechts beginnend
+            auto tileOf = [&](const Point2D &p)
+            {
+                size_t col = std::min(cols - 1, static_cast<size_t>((p.x - minX) / tileMm));
+                size_t row = std::min(rows - 1, static_cast<size_t>((p.y - minY) / tileMm));
+                return row * cols + (row % 2 ? cols - 1 - col : col);
+            };
+
+            std::vector<std::vector<size_t>> tiles(cols * rows);
+            for (size_t i = 0; i < lines.size(); i++)
+                tiles[tileOf(lines[i].front())].push_back(i);
+
+            // Je Kachel: nächster Nachbar ab der Eintritts-Ecke
+            std::vector<std::vector<std::pair<size_t, bool>>> order(tiles.size());
+            parallelFor(tiles.size(), threads, [&](size_t t)
+                        {
+                const std::vector<size_t> &members = tiles[t];
+                size_t row = t / cols;
+                size_t col = row % 2 ? cols - 1 - t % cols : t % cols;
+                Point2D at(minX + (row % 2 ? col + 1 : col) * tileMm, minY + row * tileMm);
+
+                std::vector<bool> used(members.size(), false);
+                order[t].reserve(members.size());
+                for (size_t n = 0; n < members.size(); n++)
+                {
+                    size_t best = 0;
+                    bool reverse = false;
+                    float bestDist = INFINITY;
+                    for (size_t k = 0; k < members.size(); k++)
+                    {
+                        if (used[k])
+                            continue;
+                        const Polyline &l = lines[members[k]];
+                        float front = distance2(at, l.front());
+                        float back = distance2(at, l.back());
+                        if (front < bestDist)
+                        {
+                            bestDist = front;
+                            best = k;
+                            reverse = false;
+                        }
+                        if (back < bestDist)
+                        {
+                            bestDist = back;
+                            best = k;
+                            reverse = true;
+                        }
+                    }
+                    used[best] = true;
+                    const Polyline &l = lines[members[best]];
+                    at = reverse ? l.front() : l.back();
+                    order[t].push_back({members[best], reverse});
+                } }, 4);
+
+            // Naht: Kacheln aneinanderhängen
+            std::vector<Polyline> ordered;
+            ordered.reserve(lines.size());
+            float travel = 0.0f;
+            for (const auto &tile : order)
+            {
+                for (auto [index, reverse] : tile)
+                {
+                    ordered.push_back(std::move(lines[index]));
+                    if (reverse)
+                        std::reverse(ordered.back().begin(), ordered.back().end());
+                    travel += std::sqrt(distance2(start, ordered.back().front()));
+                    start = ordered.back().back();
+                }
+            }
+            lines = std::move(ordered);
+            return travel;
+        }
+
+        // ------------------------------------------------------------------
+        // 3. Posen am Anfang jeder Linie
+        // ------------------------------------------------------------------
+
+        inline std::vector<Pose> startPoses(const std::vector<Polyline> &lines, Pose pose)
+        {
+            std::vector<Pose> poses;
+            poses.reserve(lines.size());
+            for (const Polyline &line : lines)
+            {
+                poses.push_back(pose);
+                for (const Point2D &p : line)
+                    motion::advancePose(pose, p.x, p.y);
+            }
+            return poses;
+        }
+
+        // ------------------------------------------------------------------
+        // 4. Rampen und Schritte je Linie
+        // ------------------------------------------------------------------
+
+        /**
+         * @brief Datensätze aller Linien, aneinandergehängt (ohne END)
+         */
+        inline std::vector<timeline::TimelineRecord> profileStrokes(const std::vector<Polyline> &lines,
+                                                                    const std::vector<Pose> &poses, unsigned threads,
+                                                                    uint64_t *steps = nullptr)
+        {
+            std::vector<std::vector<timeline::TimelineRecord>> chunks(lines.size());
+            std::vector<uint64_t> chunkSteps(lines.size());
+
+            parallelFor(lines.size(), threads, [&](size_t i)
+                        {
+                TimelineHal writer;
+                writer.resume(false, i > 0); // Vorgänger endet mit penUp()
+                HotState hot{};
+                hot.direction = 1;
+                motion::MotionCore<TimelineHal> core(writer, hot);
+                Pose pose = poses[i];
+                drawPolyline(core, pose, lines[i]);
+                chunkSteps[i] = writer.steps();
+                chunks[i] = writer.takeRecords(); }, 64);
+
+            size_t total = 0;
+            for (const auto &c : chunks)
+                total += c.size();
+
+            std::vector<timeline::TimelineRecord> records;
+            records.reserve(total + 1);
+            uint64_t stepSum = 0;
+            for (size_t i = 0; i < chunks.size(); i++)
+            {
+                records.insert(records.end(), chunks[i].begin(), chunks[i].end());
+                stepSum += chunkSteps[i];
+            }
+            if (steps)
+                *steps = stepSum;
+            return records;
+        }
+
+        /**
+         * @brief Alle Stufen: Linien -> Schritt-Abfolge (mit Kopf und END)
+         */
+        inline std::vector<uint8_t> planDrawing(const std::vector<Stroke> &strokes, const PlannerOptions &options,
+                                                uint32_t stepsPerMmFx, PlanStats *stats = nullptr)
+        {
+            using clock = std::chrono::steady_clock;
+            auto ms = [](clock::time_point a, clock::time_point b)
+            { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+            PlanStats local;
+            PlanStats &s = stats ? *stats : local;
+            s = PlanStats();
+            s.strokes = strokes.size();
+
+            auto t0 = clock::now();
+            std::vector<Polyline> lines(strokes.size());
+            parallelFor(strokes.size(), options.threads, [&](size_t i)
+                        {
+                lines[i] = flattenStroke(strokes[i], options.flattenToleranceMm);
+                simplifyPolyline(lines[i], options.simplifyToleranceMm); }, 64);
+            lines.erase(std::remove_if(lines.begin(), lines.end(), [](const Polyline &l)
+                                       { return l.size() < 2; }),
+                        lines.end());
+            for (const Polyline &l : lines)
+                s.segments += l.size() - 1;
+
+            auto t1 = clock::now();
+            s.travelMm = orderTiled(lines, Point2D(0.0f, 0.0f), options.tileMm, options.threads);
+
+            auto t2 = clock::now();
+            std::vector<Pose> poses = startPoses(lines, {0.0f, 0.0f, 0.0f});
+
+            auto t3 = clock::now();
+            std::vector<timeline::TimelineRecord> records = profileStrokes(lines, poses, options.threads, &s.steps);
+            records.push_back({timeline::TimelineOp::END, 0, 0, 0, 0});
+            s.records = records.size();
+            std::vector<uint8_t> bytes = packTimeline(records, stepsPerMmFx);
+
+            auto t4 = clock::now();
+            s.flattenMs = ms(t0, t1);
+            s.orderMs = ms(t1, t2);
+            s.poseMs = ms(t2, t3);
+            s.profileMs = ms(t3, t4);
+            return bytes;
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,189 @@
+/**
+ * @file host/plan_bench.cpp
+ * @brief Skalierung des parallelen Planers (host/path_planner.h) über die Thread-Anzahl
+ *
+ * Verwendung:
+ *   plan_bench                        # 25000 Linien, 1, 2, 4 ... alle Kerne
+ *   plan_bench --strokes 50000 --threads 1,8
+ *   plan_bench --verify               # zusätzlich gegen einen einzigen sequentiellen Lauf
+ *
+ * Erzeugt eine feste Zufalls-Grafik (Polylinien und Bézier-Ketten auf
+ * 1 x 1 m), plant sie mit jeder Thread-Anzahl und gibt die Zeiten der
+ * Stufen als CSV aus. Exit-Code 1, wenn die Abfolgen nicht Byte für Byte
+ * übereinstimmen.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/kinematics.h"
+#include "path_planner.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    class Rng
+    {
+    public:
+        explicit Rng(uint32_t seed) : state_(seed ? seed : 1) {}
+
+        uint32_t next()
+        {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 17;
+            state_ ^= state_ << 5;
+            return state_;
+        }
+
+        float uniform(float min, float max) { return min + (max - min) * (next() & 0xFFFFFF) / 16777216.0f; }
+
+    private:
+        uint32_t state_;
+    };
+
+    std::vector<host::Stroke> makeCorpus(size_t count, uint32_t seed)
+    {
+        Rng rng(seed);
+        std::vector<host::Stroke> strokes(count);
+        for (host::Stroke &s : strokes)
+        {
+            Point2D p(rng.uniform(0.0f, 1000.0f), rng.uniform(0.0f, 1000.0f));
+            s.cubic = rng.next() & 1;
+            s.points.push_back(p);
+
+            // Polylinie: 4-12 Punkte, Bézier-Kette: 1-3 Kurven
+            size_t n = s.cubic ? 3 * (1 + rng.next() % 3) : 3 + rng.next() % 9;
+            for (size_t i = 0; i < n; i++)
+            {
+                p.x = std::min(1000.0f, std::max(0.0f, p.x + rng.uniform(-15.0f, 15.0f)));
+                p.y = std::min(1000.0f, std::max(0.0f, p.y + rng.uniform(-15.0f, 15.0f)));
+                s.points.push_back(p);
+            }
+        }
+        return strokes;
+    }
+
+    uint64_t fnv1a(const std::vector<uint8_t> &bytes)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (uint8_t b : bytes)
+        {
+            hash ^= b;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    std::vector<unsigned> parseThreads(const char *list)
+    {
+        std::vector<unsigned> out;
+        for (const char *p = list; *p;)
+        {
+            char *end;
+            unsigned long n = std::strtoul(p, &end, 10);
+            if (end == p)
+                break;
+            out.push_back(static_cast<unsigned>(n));
+            p = *end == ',' ? end + 1 : end;
+        }
+        return out;
+    }
+
+    // Referenz: dieselben Linien in einem einzigen TimelineHal-Lauf
+    std::vector<uint8_t> planSequential(const std::vector<host::Stroke> &strokes, const host::PlannerOptions &options)
+    {
+        std::vector<host::Polyline> lines;
+        for (const host::Stroke &s : strokes)
+        {
+            host::Polyline l = host::flattenStroke(s, options.flattenToleranceMm);
+            host::simplifyPolyline(l, options.simplifyToleranceMm);
+            if (l.size() >= 2)
+                lines.push_back(std::move(l));
+        }
+        host::orderTiled(lines, Point2D(0.0f, 0.0f), options.tileMm, 1);
+
+        host::TimelineHal writer;
+        HotState hot{};
+        hot.direction = 1;
+        motion::MotionCore<host::TimelineHal> core(writer, hot);
+        Pose pose = {0.0f, 0.0f, 0.0f};
+        for (const host::Polyline &line : lines)
+            host::drawPolyline(core, pose, line);
+        return writer.finish(ActiveKinematics::STEPS_PER_MM_FX);
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t strokeCount = 25000;
+    std::vector<unsigned> threadCounts;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--strokes") == 0 && i + 1 < argc)
+            strokeCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threadCounts = parseThreads(argv[++i]);
+        else if (std::strcmp(argv[i], "--verify") == 0)
+            verify = true;
+        else
+        {
+            std::fprintf(stderr, "Verwendung: plan_bench [--strokes N] [--threads 1,2,4] [--verify]\n");
+            return 2;
+        }
+    }
+
+    if (threadCounts.empty())
+    {
+        unsigned cores = host::resolveThreads(0);
+        for (unsigned t = 1; t < cores; t *= 2)
+            threadCounts.push_back(t);
+        threadCounts.push_back(cores);
+    }
+
+    std::vector<host::Stroke> corpus = makeCorpus(strokeCount, 2024);
+    host::PlannerOptions options;
+
+    std::printf("threads,segments,records,steps,flatten_ms,order_ms,pose_ms,profile_ms,total_ms,speedup,hash\n");
+    double baseMs = 0;
+    uint64_t firstHash = 0;
+    bool same = true;
+
+    for (unsigned threads : threadCounts)
+    {
+        options.threads = threads;
+        host::PlanStats stats;
+        std::vector<uint8_t> bytes = host::planDrawing(corpus, options, ActiveKinematics::STEPS_PER_MM_FX, &stats);
+        uint64_t hash = fnv1a(bytes);
+        double total = stats.flattenMs + stats.orderMs + stats.poseMs + stats.profileMs;
+        if (baseMs == 0)
+        {
+            baseMs = total;
+            firstHash = hash;
+        }
+        same = same && hash == firstHash;
+
+        std::printf("%u,%zu,%zu,%llu,%.1f,%.1f,%.1f,%.1f,%.1f,%.2f,%016llx\n", threads, stats.segments, stats.records,
+                    static_cast<unsigned long long>(stats.steps), stats.flattenMs, stats.orderMs, stats.poseMs,
+                    stats.profileMs, total, baseMs / total, static_cast<unsigned long long>(hash));
+        std::fflush(stdout);
+    }
+
+    if (verify)
+    {
+        uint64_t hash = fnv1a(planSequential(corpus, options));
+        std::fprintf(stderr, "verify: sequentiell %016llx %s\n", static_cast<unsigned long long>(hash),
+                     hash == firstHash ? "OK" : "FEHLER");
+        same = same && hash == firstHash;
+    }
+
+    if (!same)
+        std::fprintf(stderr, "plan_bench: Abfolgen hängen von der Thread-Anzahl ab\n");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+#pragma once
+/**
+ * @file host/recording_hal.h
+ * @brief HAL-Backend, das jeden Aufruf protokolliert und weiterreicht
+ *
+ * RecordingHal<Inner> erfüllt die Schnittstelle aus hal/hal_backend.h, hängt
+ * jeden Aufruf samt Argumenten und Rückgabewert an ein Protokoll an und
+ * ruft danach Inner auf. replay() spielt die Aktionen eines Protokolls
+ * (Schritte, Pausen, Stift, Zähler) in ein anderes Backend ein - Abfragen
+ * werden dabei nicht wiederholt, ihr Ergebnis steckt schon in der Abfolge.
+ *
+ *   RecordingHal<SimHal> rec(sim);
+ *   motion::MotionCore<RecordingHal<SimHal>>(rec, hot).move(50.0f, true);
+ *   SimHal copy;
+ *   replay(rec.log(), copy);
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/context.h"
+#include "hal/hal_backend.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        enum class HalOp : uint8_t
+        {
+            STEP_MOTOR,     // a = Motor, b = Richtung
+            STOP_MOTORS,
+            DELAY_US,       // a = µs
+            READ_BUMPERS,   // a = vorne, b = hinten (Ergebnis)
+            PEN_UP,
+            PEN_DOWN,
+            IS_DRAWING,     // a = Ergebnis
+            WAIT_SERVO,
+            RANDOM,         // a = Ergebnis, b = Obergrenze
+            REPORT_STEPS,   // a = Richtung Motor 1, b = Richtung Motor 2
+            REPORT_POSE,    // a = x, b = y, c = Heading (je 1/1000 mm bzw. Grad)
+            SEGMENT_DONE    // a = Schritte
+        };
+
+        struct HalCall
+        {
+            HalOp op;
+            int32_t a;
+            int32_t b;
+            int32_t c;
+        };
+
+        template <class Inner>
+        class RecordingHal : public hal::HalBackend<RecordingHal<Inner>>
+        {
+        public:
+            explicit RecordingHal(Inner &inner) : inner_(inner) {}
+
+            void stepMotor(uint8_t motor, int direction)
+            {
+                record(HalOp::STEP_MOTOR, motor, direction);
+                inner_.stepMotor(motor, direction);
+            }
+
+            void stopMotors()
+            {
+                record(HalOp::STOP_MOTORS);
+                inner_.stopMotors();
+            }
+
+            void delayMicroseconds(uint32_t us)
+            {
+                record(HalOp::DELAY_US, static_cast<int32_t>(us));
+                inner_.delayMicroseconds(us);
+            }
+
+            BumperState readBumpers()
+            {
+                BumperState bumpers = inner_.readBumpers();
+                record(HalOp::READ_BUMPERS, bumpers.front, bumpers.back);
+                return bumpers;
+            }
+
+            void penUp()
+            {
+                record(HalOp::PEN_UP);
+                inner_.penUp();
+            }
+
+            void penDown()
+            {
+                record(HalOp::PEN_DOWN);
+                inner_.penDown();
+            }
+
+            bool isDrawing()
+            {
+                bool drawing = inner_.isDrawing();
+                record(HalOp::IS_DRAWING, drawing);
+                return drawing;
+            }
+
+            void waitServoSettled()
+            {
+                record(HalOp::WAIT_SERVO);
+                inner_.waitServoSettled();
+            }
+
+            long random(long min, long max)
+            {
+                long value = inner_.random(min, max);
+                record(HalOp::RANDOM, static_cast<int32_t>(value), static_cast<int32_t>(max));
+                return value;
+            }
+
+            void reportSteps(int dir1, int dir2)
+            {
+                record(HalOp::REPORT_STEPS, dir1, dir2);
+                inner_.reportSteps(dir1, dir2);
+            }
+
+            void reportPose(const Pose &pose)
+            {
+                record(HalOp::REPORT_POSE, toMilli(pose.x), toMilli(pose.y), toMilli(pose.heading));
+                inner_.reportPose(pose);
+            }
+
+            void segmentDone(uint32_t steps)
+            {
+                record(HalOp::SEGMENT_DONE, static_cast<int32_t>(steps));
+                inner_.segmentDone(steps);
+            }
+
+            const std::vector<HalCall> &log() const { return log_; }
+            void clear() { log_.clear(); }
+
+        private:
+            void record(HalOp op, int32_t a = 0, int32_t b = 0, int32_t c = 0) { log_.push_back({op, a, b, c}); }
+            static int32_t toMilli(float value) { return static_cast<int32_t>(std::lround(value * 1000.0f)); }
+
+            Inner &inner_;
+            std::vector<HalCall> log_;
+        };
+
+        /**
+         * @brief Aktionen eines Protokolls in ein Backend einspielen
+         */
+        template <class Hal>
+        void replay(const std::vector<HalCall> &log, Hal &hal)
+        {
+            for (const HalCall &call : log)
+            {
+                switch (call.op)
+                {
+                case HalOp::STEP_MOTOR:
+                    hal.stepMotor(static_cast<uint8_t>(call.a), call.b);
+                    break;
+                case HalOp::STOP_MOTORS:
+                    hal.stopMotors();
+                    break;
+                case HalOp::DELAY_US:
+                    hal.delayMicroseconds(static_cast<uint32_t>(call.a));
+                    break;
+                case HalOp::PEN_UP:
+                    hal.penUp();
+                    break;
+                case HalOp::PEN_DOWN:
+                    hal.penDown();
+                    break;
+                case HalOp::WAIT_SERVO:
+                    hal.waitServoSettled();
+                    break;
+                case HalOp::REPORT_STEPS:
+                    hal.reportSteps(call.a, call.b);
+                    break;
+                case HalOp::REPORT_POSE:
+                    hal.reportPose({call.a / 1000.0f, call.b / 1000.0f, call.c / 1000.0f});
+                    break;
+                case HalOp::SEGMENT_DONE:
+                    hal.segmentDone(static_cast<uint32_t>(call.a));
+                    break;
+                default: // Abfragen
+                    break;
+                }
+            }
+        }
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,149 @@
+#pragma once
+/**
+ * @file host/sim_hal.h
+ * @brief HAL-Backend für Host-Simulationen
+ *
+ * Erfüllt die Schnittstelle aus hal/hal_backend.h ohne Hardware: Schritte
+ * landen in Zählern, Pausen und Servo-Bewegungen schieben eine virtuelle Uhr
+ * vor. Bumper-Kontakte werden vorab eingeplant, Zufallszahlen kommen aus
+ * einem festen Seed - zwei Läufe mit gleicher Eingabe sind identisch.
+ * streamHash() fasst die Schrittfolge samt Zeitpunkten zusammen.
+ */
+
+#include <cstdint>
+
+#include "core/config.h"
+#include "core/context.h"
+#include "hal/hal_backend.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        class SimHal : public hal::HalBackend<SimHal>
+        {
+        public:
+            explicit SimHal(uint32_t seed = 1) : rng_(seed ? seed : 1) {}
+
+            void stepMotor(uint8_t motor, int direction)
+            {
+                position_[motor == 2 ? 1 : 0] += direction;
+                stepCalls_++;
+                hashStep(motor, direction);
+            }
+
+            void stopMotors() { stops_++; }
+            void delayMicroseconds(uint32_t us) { nowUs_ += us; }
+
+            BumperState readBumpers()
+            {
+                reads_++;
+                if (bumperReads_ == 0)
+                    return {false, false};
+                bumperReads_--;
+                return {bumperFront_, !bumperFront_};
+            }
+
+            void penUp()
+            {
+                if (drawing_)
+                    moveServo();
+                drawing_ = false;
+            }
+
+            void penDown()
+            {
+                if (!drawing_)
+                    moveServo();
+                drawing_ = true;
+            }
+
+            bool isDrawing() { return drawing_; }
+            void waitServoSettled() {}
+
+            long random(long min, long max)
+            {
+                // xorshift32
+                rng_ ^= rng_ << 13;
+                rng_ ^= rng_ >> 17;
+                rng_ ^= rng_ << 5;
+                return max <= min ? min : min + static_cast<long>(rng_ % static_cast<uint32_t>(max - min));
+            }
+
+            void reportSteps(int dir1, int dir2)
+            {
+                reported_[0] += dir1;
+                reported_[1] += dir2;
+            }
+
+            void reportPose(const Pose &pose) { pose_ = pose; }
+
+            void segmentDone(uint32_t steps)
+            {
+                segments_++;
+                segmentSteps_ += steps;
+            }
+
+            /**
+             * @brief Bumper für die nächsten Abfragen als gedrückt melden
+             * @param reads Anzahl Abfragen (readBumpers/isBumperPressed)
+             * @param front true = vorne, false = hinten
+             */
+            void pressBumper(uint32_t reads, bool front = true)
+            {
+                bumperReads_ = reads;
+                bumperFront_ = front;
+            }
+
+            int32_t position(int motor) const { return position_[motor == 2 ? 1 : 0]; }
+            int32_t reported(int motor) const { return reported_[motor == 2 ? 1 : 0]; }
+            uint64_t nowUs() const { return nowUs_; }
+            uint64_t stepCalls() const { return stepCalls_; }
+            uint64_t streamHash() const { return hash_; }
+            uint32_t segments() const { return segments_; }
+            uint64_t segmentSteps() const { return segmentSteps_; }
+            uint32_t servoMoves() const { return servoMoves_; }
+            uint32_t stops() const { return stops_; }
+            uint32_t bumperReads() const { return reads_; }
+            bool drawing() const { return drawing_; }
+            const Pose &pose() const { return pose_; }
+
+        private:
+            // FNV-1a über Motor, Richtung und Zeitpunkt jedes Schritts
+            void hashStep(uint8_t motor, int direction)
+            {
+                const uint64_t words[3] = {motor, static_cast<uint64_t>(direction + 1), nowUs_};
+                for (uint64_t word : words)
+                {
+                    hash_ ^= word;
+                    hash_ *= 0x100000001b3ull;
+                }
+            }
+
+            // Wie hal::moveServo(): Stellzeit blockiert die Fahrt
+            void moveServo()
+            {
+                nowUs_ += static_cast<uint64_t>(config::SERVO_MOVE_DELAY_MS) * 1000;
+                servoMoves_++;
+            }
+
+            int32_t position_[2] = {0, 0};
+            int32_t reported_[2] = {0, 0};
+            uint64_t nowUs_ = 0;
+            uint64_t stepCalls_ = 0;
+            uint64_t hash_ = 0xcbf29ce484222325ull;
+            uint64_t segmentSteps_ = 0;
+            uint32_t segments_ = 0;
+            uint32_t servoMoves_ = 0;
+            uint32_t stops_ = 0;
+            uint32_t reads_ = 0;
+            uint32_t bumperReads_ = 0;
+            bool bumperFront_ = true;
+            bool drawing_ = false;
+            Pose pose_ = {0.0f, 0.0f, 0.0f};
+            uint32_t rng_;
+        };
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,347 @@
+/**
+ * @file host/stepper_sim.cpp
+ * @brief Stepper-Backends gegen eine Mock-Pin-Senke fahren und nachprüfen
+ *
+ * Verwendung:
+ *   stepper_sim          # Zusammenfassung, Exit-Code 1 bei Abweichung
+ *   stepper_sim --csv    # zusätzlich alle Pin-Ereignisse als CSV auf stdout
+ *
+ * Fährt dieselbe Schrittfolge (vor, zurück, Vollschritt, Stromlos, weiter)
+ * mit dem Unipolar- und dem STEP/DIR-Treiber aus hal/stepper_backend.h und
+ * rekonstruiert die Position allein aus den aufgezeichneten Pegeln.
+ * Zusätzlich werden Segmente mit hal/wave_encoder.h in Puffer der
+ * Gerätegröße kodiert und Schrittzahl sowie Schrittzeitpunkte nachgeprüft.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/config.h"
+#include "hal/stepper_backend.h"
+#include "hal/wave_encoder.h"
+#include "mock_pins.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    struct Move
+    {
+        int direction;
+        int stride; // Halbschritte pro Aufruf (nur unipolar)
+        int count;
+        bool releaseAfter;
+    };
+
+    const Move SCRIPT[] = {
+        {1, 1, 1000, false},
+        {-1, 1, 300, false},
+        {1, 2, 250, true},
+        {1, 1, 10, false},
+        {-1, 2, 40, true},
+    };
+
+    const uint8_t PINS[4] = {10, 11, 15, 22};
+
+    void dumpCsv(const char *backend, const host::MockPinSink &sink)
+    {
+        for (const auto &ev : sink.events())
+        {
+            if (ev.pin == host::MockPinSink::PULSE)
+                std::printf("%s,%u,pulse,%u\n", backend, ev.timeUs, ev.value);
+            else
+                std::printf("%s,%u,%u,%u\n", backend, ev.timeUs, ev.pin, ev.value);
+        }
+    }
+
+    int phaseOf(const host::MockPinSink &sink)
+    {
+        for (int p = 0; p < 8; p++)
+        {
+            bool match = true;
+            for (int i = 0; i < 4; i++)
+                match = match && sink.level(PINS[i]) == static_cast<bool>(hal::HALF_STEP_PATTERN[p][i]);
+            if (match)
+                return p;
+        }
+        return -1;
+    }
+
+    // Position aus dem Spulenmuster nach jedem Schritt
+    bool checkUnipolar(bool csv)
+    {
+        using Driver = hal::UnipolarDriver<host::MockPinSink>;
+        host::MockPinSink sink;
+        uint8_t phase = 0;
+        long expected = 0;
+        long decoded = 0;
+        int lastPhase = 0;
+        bool ok = true;
+
+        for (const Move &move : SCRIPT)
+        {
+            for (int i = 0; i < move.count; i++)
+            {
+                Driver::step(sink, PINS, phase, move.direction * move.stride);
+                sink.advance(config::PROFILE_28BYJ48.minIntervalUs * move.stride);
+                expected += move.direction * move.stride;
+
+                int p = phaseOf(sink);
+                if (p < 0)
+                {
+                    std::fprintf(stderr, "unipolar: ungültiges Spulenmuster nach Schritt %ld\n", expected);
+                    return false;
+                }
+                int delta = ((p - lastPhase + 8 + 4) & 7) - 4; // -4..3
+                decoded += delta;
+                lastPhase = p;
+            }
+            if (move.releaseAfter)
+            {
+                Driver::release(sink, PINS);
+                ok = ok && phaseOf(sink) < 0;
+                // Nach dem Stromlos-Schalten muss der nächste Schritt an der alten Phase weitermachen
+                Driver::step(sink, PINS, phase, 0);
+            }
+        }
+
+        ok = ok && decoded == expected;
+        std::fprintf(stderr, "unipolar: %zu Ereignisse, Position %ld (erwartet %ld) %s\n", sink.events().size(),
+                     decoded, expected, ok ? "OK" : "FEHLER");
+        if (csv)
+            dumpCsv("unipolar", sink);
+        return ok;
+    }
+
+    // Position aus DIR-Pegel bei jedem Puls; EN muss dabei aktiv (low) sein
+    bool checkStepDir(bool csv)
+    {
+        using Driver = hal::StepDirDriver<host::MockPinSink>;
+        host::MockPinSink sink;
+        int8_t state = 0;
+        long expected = 0;
+        bool ok = true;
+
+        Driver::release(sink, PINS, state);
+        for (const Move &move : SCRIPT)
+        {
+            for (int i = 0; i < move.count; i++)
+            {
+                Driver::step(sink, 0, PINS, state, move.direction);
+                sink.advance(config::PROFILE_NEMA17_STEP_DIR.minIntervalUs);
+                expected += move.direction;
+            }
+            if (move.releaseAfter)
+                Driver::release(sink, PINS, state);
+        }
+
+        // Aufzeichnung erneut abspielen
+        bool dir = false;
+        bool enabled = false;
+        long decoded = 0;
+        size_t dirWrites = 0;
+        for (const auto &ev : sink.events())
+        {
+            if (ev.pin == PINS[Driver::PIN_DIR])
+            {
+                dir = ev.value;
+                dirWrites++;
+            }
+            else if (ev.pin == PINS[Driver::PIN_ENABLE])
+                enabled = !ev.value;
+            else if (ev.pin == host::MockPinSink::PULSE)
+            {
+                if (!enabled)
+                {
+                    std::fprintf(stderr, "stepdir: Puls bei abgeschaltetem Treiber (%u µs)\n", ev.timeUs);
+                    ok = false;
+                }
+                decoded += dir ? 1 : -1;
+            }
+        }
+
+        // DIR nur bei Richtungswechsel oder nach dem Einschalten
+        size_t changes = 0;
+        int last = 0;
+        for (const Move &move : SCRIPT)
+        {
+            changes += move.direction != last;
+            last = move.releaseAfter ? 0 : move.direction;
+        }
+
+        ok = ok && decoded == expected && dirWrites == changes && !enabled;
+        std::fprintf(stderr, "stepdir: %zu Ereignisse, Position %ld (erwartet %ld), %zu DIR-Wechsel %s\n",
+                     sink.events().size(), decoded, expected, dirWrites, ok ? "OK" : "FEHLER");
+        if (csv)
+            dumpCsv("stepdir", sink);
+        return ok;
+    }
+
+    struct WaveMove
+    {
+        int dir[2];
+        uint32_t steps;
+        uint32_t intervalSlots; // Ziel-Intervall in Schlitzen
+        uint32_t startSlots;    // 0 = ohne Rampe
+        uint32_t rampSteps;
+        uint8_t stride;
+        uint8_t parity;
+    };
+
+    const WaveMove WAVE_SCRIPT[] = {
+        {{1, 1}, 1000, 100, 0, 0, 1, 0},    // Halbschritt, konstant
+        {{1, 1}, 500, 50, 300, 100, 2, 1},  // Vollschritt mit Rampe
+        {{-1, -1}, 301, 80, 0, 0, 2, 0},    // Wave-Drive, ungerade Restschritte
+        {{1, -1}, 400, 37, 120, 40, 1, 0},  // Drehen auf der Stelle
+        {{1, 1}, 7, 3, 0, 0, 1, 0},         // kurz und schnell
+        {{0, 1}, 1, 40, 0, 0, 1, 0},        // ein Motor allein: Paritäten laufen auseinander
+        {{1, 1}, 200, 40, 0, 0, 2, 1},      // Vollschritt, Motor mit falscher Parität richtet sich aus
+    };
+
+    int nibblePhase(uint8_t bits)
+    {
+        for (int p = 0; p < 8; p++)
+        {
+            uint8_t pattern = 0;
+            for (int i = 0; i < 4; i++)
+                pattern |= hal::HALF_STEP_PATTERN[p][i] << i;
+            if (pattern == bits)
+                return p;
+        }
+        return -1;
+    }
+
+    // Segmente wie hal/wave_stream.cpp in Puffer der Gerätegröße kodieren und zurücklesen
+    bool checkWave()
+    {
+        using hal::WAVE_FX_ONE;
+        hal::WaveState st = {};
+        std::vector<uint8_t> out;
+        std::vector<uint8_t> buffer(config::WAVE_BUFFER_SLOTS);
+        long expected[2] = {0, 0};
+
+        size_t next = 0;
+        size_t count = sizeof(WAVE_SCRIPT) / sizeof(WAVE_SCRIPT[0]);
+        size_t used = 0;
+        while (true)
+        {
+            if (st.stepsLeft == 0)
+            {
+                if (next == count)
+                    break;
+                const WaveMove &m = WAVE_SCRIPT[next++];
+                st.dir[0] = static_cast<int8_t>(m.dir[0]);
+                st.dir[1] = static_cast<int8_t>(m.dir[1]);
+                st.stride = m.stride;
+                st.parity = m.parity;
+                st.targetFx = m.intervalSlots * WAVE_FX_ONE;
+                st.intervalFx = m.startSlots ? m.startSlots * WAVE_FX_ONE : st.targetFx;
+                st.rampDeltaFx = m.startSlots ? (static_cast<int32_t>(st.targetFx) - static_cast<int32_t>(st.intervalFx)) /
+                                                    static_cast<int32_t>(m.rampSteps)
+                                              : 0;
+                st.stepsLeft = m.steps;
+                expected[0] += m.dir[0] * static_cast<long>(m.steps);
+                expected[1] += m.dir[1] * static_cast<long>(m.steps);
+                continue;
+            }
+            used += hal::encodeWave(st, buffer.data() + used, buffer.size() - used);
+            if (used == buffer.size())
+            {
+                out.insert(out.end(), buffer.begin(), buffer.end());
+                used = 0;
+            }
+        }
+        out.insert(out.end(), buffer.begin(), buffer.begin() + used);
+
+        // Schritte aus den Nibbles zurücklesen, Zeitpunkte gegen die Soll-Intervalle prüfen
+        long decoded[2] = {0, 0};
+        int last[2] = {0, 0};
+        uint64_t idealFx = 0;
+        uint32_t intervalFx = 0;
+        int32_t rampFx = 0;
+        uint32_t targetFx = 0;
+        long segmentLeft = 0;
+        int lag = 0;
+        size_t solos = 0;
+        size_t move = 0;
+        size_t late = 0;
+        bool ok = true;
+
+        for (size_t slot = 0; slot < out.size(); slot++)
+        {
+            int p[2] = {nibblePhase(out[slot] & 0x0F), nibblePhase(out[slot] >> 4)};
+            if (p[0] < 0 || p[1] < 0)
+            {
+                std::fprintf(stderr, "wave: ungültiges Spulenmuster in Schlitz %zu\n", slot);
+                return false;
+            }
+            int d[2] = {((p[0] - last[0] + 8 + 4) & 7) - 4, ((p[1] - last[1] + 8 + 4) & 7) - 4};
+            if (d[0] == 0 && d[1] == 0)
+                continue;
+
+            if (segmentLeft == 0)
+            {
+                const WaveMove &m = WAVE_SCRIPT[move++];
+                targetFx = m.intervalSlots * WAVE_FX_ONE;
+                intervalFx = m.startSlots ? m.startSlots * WAVE_FX_ONE : targetFx;
+                rampFx = m.startSlots ? (static_cast<int32_t>(targetFx) - static_cast<int32_t>(intervalFx)) /
+                                            static_cast<int32_t>(m.rampSteps)
+                                      : 0;
+                segmentLeft = m.steps;
+            }
+            // Ein Motor allein (beide bewegt): Ausrichtung verbraucht nichts,
+            // das Aufholen des zurückliegenden Motors eine Einheit
+            const WaveMove &cur = WAVE_SCRIPT[move - 1];
+            int units = d[0] != 0 ? (d[0] < 0 ? -d[0] : d[0]) : (d[1] < 0 ? -d[1] : d[1]);
+            int consumed = units;
+            if (cur.dir[0] != 0 && cur.dir[1] != 0 && (d[0] == 0 || d[1] == 0))
+            {
+                int solo = d[0] != 0 ? 1 : 2;
+                consumed = solo == lag ? 1 : 0;
+                lag = solo == lag ? 0 : 3 - solo;
+                solos++;
+            }
+            idealFx += static_cast<uint64_t>(intervalFx) * units;
+            segmentLeft -= consumed;
+            if (rampFx != 0)
+            {
+                int64_t n = static_cast<int64_t>(intervalFx) + rampFx;
+                bool reached = rampFx < 0 ? n <= targetFx : n >= targetFx;
+                intervalFx = reached ? targetFx : static_cast<uint32_t>(n);
+                rampFx = reached ? 0 : rampFx;
+            }
+
+            // Schritt erscheint im ersten Schlitz, der den Soll-Zeitpunkt erreicht
+            long idealSlot = static_cast<long>((idealFx + WAVE_FX_ONE - 1) / WAVE_FX_ONE) - 1;
+            long diff = static_cast<long>(slot) - idealSlot;
+            if (diff < -1 || diff > 1)
+                late++;
+
+            decoded[0] += d[0];
+            decoded[1] += d[1];
+            last[0] = p[0];
+            last[1] = p[1];
+        }
+
+        // Jeder Motor fährt genau die Schrittzahl seiner Segmente
+        ok = late == 0 && segmentLeft == 0 && lag == 0 && move == count && decoded[0] == expected[0] &&
+             decoded[1] == expected[1] && decoded[0] == st.position[0] && decoded[1] == st.position[1] && solos >= 2;
+        std::fprintf(stderr, "wave: %zu Schlitze, Position %ld/%ld (erwartet %ld/%ld), %zu Einzelschritte, %zu Schritte außerhalb ±1 Schlitz %s\n",
+                     out.size(), decoded[0], decoded[1], expected[0], expected[1], solos, late, ok ? "OK" : "FEHLER");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool csv = argc > 1 && std::strcmp(argv[1], "--csv") == 0;
+    if (csv)
+        std::printf("backend,time_us,pin,value\n");
+
+    bool ok = checkUnipolar(csv);
+    ok = checkStepDir(csv) && ok;
+    ok = checkWave() && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
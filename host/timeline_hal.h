@@ -0,0 +1,245 @@
+#pragma once
+/**
+ * @file host/timeline_hal.h
+ * @brief HAL-Backend, das eine Schritt-Abfolge (core/step_timeline.h) schreibt
+ *
+ * TimelineHal erfüllt die Schnittstelle aus hal/hal_backend.h und fasst
+ * aufeinanderfolgende Schritte mit gleicher Richtung und linear veränderter
+ * Pause zu BURST-Datensätzen zusammen. Abfragen beantwortet es selbst: kein
+ * Bumper gedrückt (offline gibt es keine Hindernisse), Stift-Zustand aus den
+ * eigenen Aufrufen, Zufall aus einem festen Seed.
+ *
+ *   host::TimelineHal writer;
+ *   motion::MotionCore<host::TimelineHal>(writer, hot).move(50.0f);
+ *   std::vector<uint8_t> bytes = writer.finish(ActiveKinematics::STEPS_PER_MM_FX);
+ *
+ * Einzelne reportSteps()-Aufrufe außerhalb von stepPair() gehen nicht in die
+ * Abfolge ein; der Player meldet Schritte über stepPair().
+ */
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/context.h"
+#include "core/step_timeline.h"
+#include "hal/hal_backend.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        /**
+         * @brief Datensätze mit Kopf zu einer Byte-Folge packen
+         */
+        inline std::vector<uint8_t> packTimeline(const std::vector<timeline::TimelineRecord> &records,
+                                                 uint32_t stepsPerMmFx)
+        {
+            std::vector<uint8_t> bytes(timeline::HEADER_SIZE + records.size() * timeline::RECORD_SIZE);
+            timeline::packHeader({static_cast<uint32_t>(records.size()), stepsPerMmFx}, bytes.data());
+            uint8_t *raw = bytes.data() + timeline::HEADER_SIZE;
+            for (const timeline::TimelineRecord &r : records)
+            {
+                timeline::packRecord(r, raw);
+                raw += timeline::RECORD_SIZE;
+            }
+            return bytes;
+        }
+
+        class TimelineHal : public hal::HalBackend<TimelineHal>
+        {
+        public:
+            explicit TimelineHal(uint32_t seed = 1) : rng_(seed ? seed : 1) {}
+
+            // Verdeckt HalBackend::stepPair(): Paar als ein Schritt im BURST
+            void stepPair(int dir1, int dir2) { beginStep(timeline::packDirs(dir1, dir2)); }
+
+            void stepMotor(uint8_t motor, int direction)
+            {
+                beginStep(motor == 2 ? timeline::packDirs(0, direction) : timeline::packDirs(direction, 0));
+            }
+
+            void stopMotors()
+            {
+                flushStep();
+                flushBurst();
+                emit({timeline::TimelineOp::STOP, 0, 0, 0, 0});
+            }
+
+            void delayMicroseconds(uint32_t us)
+            {
+                if (!stepPending_ || us > UINT16_MAX)
+                {
+                    flushStep();
+                    flushBurst();
+                    emit({timeline::TimelineOp::DELAY, 0, static_cast<uint16_t>(us >> 16), static_cast<uint16_t>(us), 0});
+                    return;
+                }
+                stepPending_ = false;
+                appendStep(pendingDirs_, static_cast<uint16_t>(us));
+            }
+
+            BumperState readBumpers() { return {false, false}; }
+
+            void penUp()
+            {
+                if (drawing_)
+                    penEvent(timeline::TimelineOp::PEN_UP);
+                drawing_ = false;
+            }
+
+            void penDown()
+            {
+                if (!drawing_)
+                    penEvent(timeline::TimelineOp::PEN_DOWN);
+                drawing_ = true;
+            }
+
+            bool isDrawing() { return drawing_; }
+
+            void waitServoSettled()
+            {
+                if (!servoMoving_)
+                    return;
+                flushStep();
+                flushBurst();
+                emit({timeline::TimelineOp::SETTLE, 0, 0, 0, 0});
+                servoMoving_ = false;
+            }
+
+            long random(long min, long max)
+            {
+                // xorshift32 (wie host::SimHal)
+                rng_ ^= rng_ << 13;
+                rng_ ^= rng_ >> 17;
+                rng_ ^= rng_ << 5;
+                return max <= min ? min : min + static_cast<long>(rng_ % static_cast<uint32_t>(max - min));
+            }
+
+            void reportSteps(int, int) {}
+
+            void reportPose(const Pose &pose)
+            {
+                flushStep();
+                flushBurst();
+                emit(timeline::poseRecord(pose));
+            }
+
+            void segmentDone(uint32_t steps)
+            {
+                flushStep();
+                flushBurst();
+                emit({timeline::TimelineOp::SEGMENT, 0, static_cast<uint16_t>(steps), 0, 0});
+            }
+
+            /**
+             * @brief Abfolge abschließen und mit Kopf als Byte-Folge liefern
+             * @param stepsPerMmFx Profil, für das geplant wurde (Gerät prüft es)
+             */
+            std::vector<uint8_t> finish(uint32_t stepsPerMmFx)
+            {
+                std::vector<timeline::TimelineRecord> records = takeRecords();
+                records.push_back({timeline::TimelineOp::END, 0, 0, 0, 0});
+                return packTimeline(records, stepsPerMmFx);
+            }
+
+            /**
+             * @brief Stift-Zustand übernehmen, wenn ein Abschnitt mitten im Auftrag beginnt
+             * @param drawing Stift unten?
+             * @param servoMoving Stift-Wechsel seit der letzten Fahrt (nächste Fahrt wartet aufs Servo)
+             */
+            void resume(bool drawing, bool servoMoving)
+            {
+                drawing_ = drawing;
+                servoMoving_ = servoMoving;
+            }
+
+            /**
+             * @brief Datensätze ohne END und Kopf übernehmen (Abschnitte aneinanderhängen)
+             */
+            std::vector<timeline::TimelineRecord> takeRecords()
+            {
+                flushStep();
+                flushBurst();
+                return std::move(records_);
+            }
+
+            const std::vector<timeline::TimelineRecord> &records() const { return records_; }
+            uint64_t steps() const { return steps_; }
+
+        private:
+            void beginStep(uint8_t dirs)
+            {
+                flushStep();
+                stepPending_ = true;
+                pendingDirs_ = dirs;
+                steps_++;
+            }
+
+            // Schritt ohne folgende Pause
+            void flushStep()
+            {
+                if (!stepPending_)
+                    return;
+                stepPending_ = false;
+                appendStep(pendingDirs_, 0);
+            }
+
+            void appendStep(uint8_t dirs, uint16_t us)
+            {
+                if (burstOpen_ && burst_.dirs == dirs && burst_.count < UINT16_MAX)
+                {
+                    int32_t next = burst_.intervalUs + static_cast<int32_t>(burst_.count) * burst_.deltaUs;
+                    if (burst_.count == 1)
+                    {
+                        int32_t delta = static_cast<int32_t>(us) - burst_.intervalUs;
+                        if (delta >= INT16_MIN && delta <= INT16_MAX)
+                        {
+                            burst_.deltaUs = static_cast<int16_t>(delta);
+                            burst_.count++;
+                            return;
+                        }
+                    }
+                    else if (next == us)
+                    {
+                        burst_.count++;
+                        return;
+                    }
+                }
+                flushBurst();
+                burst_ = {timeline::TimelineOp::BURST, dirs, 1, us, 0};
+                burstOpen_ = true;
+            }
+
+            void flushBurst()
+            {
+                if (!burstOpen_)
+                    return;
+                burstOpen_ = false;
+                emit(burst_);
+            }
+
+            void penEvent(timeline::TimelineOp op)
+            {
+                flushStep();
+                flushBurst();
+                emit({op, 0, 0, 0, 0});
+                servoMoving_ = true;
+            }
+
+            void emit(const timeline::TimelineRecord &r) { records_.push_back(r); }
+
+            std::vector<timeline::TimelineRecord> records_;
+            timeline::TimelineRecord burst_ = {};
+            bool burstOpen_ = false;
+            bool stepPending_ = false;
+            uint8_t pendingDirs_ = 0;
+            bool drawing_ = false;
+            bool servoMoving_ = false;
+            uint64_t steps_ = 0;
+            uint32_t rng_;
+        };
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,61 @@
+/**
+ * @file host/trace_export.cpp
+ * @brief Wandelt einen Mitschnitt der seriellen Schnittstelle in Chrome-Trace-JSON
+ *
+ * Verwendung:
+ *   trace_export [capture.bin] > job.json
+ *   cat /dev/cu.usbmodemXXXX | trace_export > job.json
+ *
+ * Ausgewertet werden Trace-Frames (monitor::exportTrace()) und, falls im
+ * Mitschnitt vorhanden, Telemetrie-Frames (monitor::startTelemetry()).
+ * Das Ergebnis in ui.perfetto.dev öffnen.
+ */
+
+#include <cstdio>
+
+#include "core/telemetry_frame.h"
+#include "monitor/trace_frame.h"
+#include "chrome_trace.h"
+#include "frame_reader.h"
+
+using namespace tiny_turtle;
+
+int main(int argc, char **argv)
+{
+    FILE *in = host::openInput(argc, argv);
+    if (!in)
+        return 1;
+
+    host::FrameReader reader;
+    host::ChromeTraceWriter writer;
+
+    reader.read(in, [&](const uint8_t *raw, size_t len)
+                {
+        if (raw[0] == telemetry::FRAME_TYPE_TRACE)
+        {
+            monitor::TraceRecord rec;
+            if (!telemetry::unpackTrace(raw, len, rec))
+                return false;
+            writer.add(rec);
+            return true;
+        }
+
+        telemetry::Sample sample;
+        if (!telemetry::unpack(raw, len, sample))
+            return false;
+        writer.add(sample);
+        return true; });
+
+    if (in != stdin)
+        std::fclose(in);
+
+    if (!writer.write(stdout))
+    {
+        std::perror("trace_export");
+        return 1;
+    }
+
+    std::fprintf(stderr, "trace_export: %zu Trace-Einträge, %zu Messpunkte, %lu ungültig\n",
+                 writer.recordCount(), writer.sampleCount(), reader.invalid());
+    return 0;
+}
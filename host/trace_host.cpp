@@ -0,0 +1,67 @@
+/**
+ * @file host/trace_host.cpp
+ * @brief Trace-Backend für Simulations-Builds auf dem Host
+ *
+ * Implementiert die API aus monitor/trace.h mit demselben Ring wie auf dem
+ * Gerät (monitor/trace_ring.h), Zeitquelle ist steady_clock. Ausgewertet wird
+ * per host::exportChromeTrace() statt über einen Trace-Task.
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "monitor/trace.h"
+#include "monitor/trace_ring.h"
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        // Großzügiger als auf dem Gerät - ein ganzer Job soll hineinpassen
+        static TraceRing<65536> s_ring;
+
+        static uint32_t nowUs()
+        {
+            using namespace std::chrono;
+            static const steady_clock::time_point start = steady_clock::now();
+            return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - start).count());
+        }
+
+        void traceRecord(TraceEvent event, uint32_t a, uint32_t b)
+        {
+            s_ring.record(nowUs(), event, a, b);
+        }
+
+        size_t readTrace(uint32_t &cursor, TraceRecord *out, size_t max, uint32_t *lost)
+        {
+            return s_ring.read(cursor, out, max, lost);
+        }
+
+        TraceStats getTraceStats()
+        {
+            return {s_ring.recorded(), 0};
+        }
+
+        void dumpTrace()
+        {
+            uint32_t recorded = s_ring.recorded();
+            uint32_t cursor = recorded > s_ring.capacity() ? recorded - static_cast<uint32_t>(s_ring.capacity()) : 0;
+
+            TraceRecord batch[64];
+            size_t n;
+            do
+            {
+                n = s_ring.read(cursor, batch, 64, nullptr);
+                for (size_t i = 0; i < n; i++)
+                {
+                    std::printf("%10u %-16s %u %u\n", batch[i].timestampUs, traceEventName(batch[i].event),
+                                batch[i].a, batch[i].b);
+                }
+            } while (n == 64);
+        }
+
+        void startTraceTask() {}
+        void stopTraceTask() {}
+
+    } // namespace monitor
+} // namespace tiny_turtle
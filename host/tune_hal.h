@@ -0,0 +1,155 @@
+#pragma once
+/**
+ * @file host/tune_hal.h
+ * @brief HAL-Backend, das Fahrzeit, Beschleunigung und Stift-Verzug misst
+ *
+ * TuneHal simuliert wie host::SimHal mit virtueller Uhr, die Servo-Wartezeit
+ * ist aber ein Parameter. Aus den Abständen der Schritte rechnet es die
+ * Radgeschwindigkeit und daraus:
+ *
+ * - Spitzenbeschleunigung innerhalb einer Rampe (mm/s²)
+ * - Anfahr- und Haltegeschwindigkeit: Sprung aus dem bzw. in den Stillstand
+ * - Höchstgeschwindigkeit
+ * - Stift-Verzug: Weg, der gefahren wird, während der Stift noch unterwegs
+ *   ist (Servo braucht servoTravelMs, wartet aber nur servoDelayMs). Je
+ *   Stiftbewegung gezählt, das Maximum ist der Bahnfehler.
+ *
+ *   host::TuneHal hal(mmPerStep, 300, 300);
+ *   motion::MotionCore<host::TuneHal>(hal, hot, tuning).move(50.0f);
+ *   hal.peakAccel();
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "core/context.h"
+#include "hal/hal_backend.h"
+
+namespace tiny_turtle
+{
+    namespace host
+    {
+
+        class TuneHal : public hal::HalBackend<TuneHal>
+        {
+        public:
+            TuneHal(float mmPerStep, uint32_t servoDelayMs, uint32_t servoTravelMs, uint32_t seed = 1)
+                : mmPerStep_(mmPerStep), servoDelayUs_(static_cast<uint64_t>(servoDelayMs) * 1000),
+                  servoTravelUs_(static_cast<uint64_t>(servoTravelMs) * 1000), rng_(seed ? seed : 1) {}
+
+            // Verdeckt HalBackend::stepPair(): ein Paar ist ein Radschritt
+            void stepPair(int dir1, int dir2)
+            {
+                steps_++;
+                if (haveStep_)
+                {
+                    uint64_t dtUs = nowUs_ - lastStepUs_;
+                    float speed = dtUs ? mmPerStep_ * 1e6f / dtUs : 0.0f;
+                    if (haveSpeed_)
+                        peakAccel_ = std::max(peakAccel_, std::fabs(speed - speed_) * 1e6f / dtUs);
+                    else
+                        startSpeed_ = std::max(startSpeed_, speed);
+                    topSpeed_ = std::max(topSpeed_, speed);
+                    speed_ = speed;
+                    haveSpeed_ = true;
+                }
+                haveStep_ = true;
+                lastStepUs_ = nowUs_;
+
+                // Nur Geradeausfahrt bewegt den Stift (Drehung auf der Stelle um die Stiftachse)
+                if (dir1 == dir2 && nowUs_ < penSettledUs_)
+                {
+                    lagMm_ += mmPerStep_;
+                    maxLagMm_ = std::max(maxLagMm_, lagMm_);
+                }
+            }
+
+            void stepMotor(uint8_t, int) {}
+
+            // Stillstand: letzte Geschwindigkeit ist der Haltesprung
+            void stopMotors() { endSegment(); }
+            void segmentDone(uint32_t) { endSegment(); }
+
+            void delayMicroseconds(uint32_t us) { nowUs_ += us; }
+
+            BumperState readBumpers() { return {false, false}; }
+
+            void penUp()
+            {
+                if (drawing_)
+                    moveServo();
+                drawing_ = false;
+            }
+
+            void penDown()
+            {
+                if (!drawing_)
+                    moveServo();
+                drawing_ = true;
+            }
+
+            bool isDrawing() { return drawing_; }
+            void waitServoSettled() {}
+
+            long random(long min, long max)
+            {
+                // xorshift32
+                rng_ ^= rng_ << 13;
+                rng_ ^= rng_ >> 17;
+                rng_ ^= rng_ << 5;
+                return max <= min ? min : min + static_cast<long>(rng_ % static_cast<uint32_t>(max - min));
+            }
+
+            void reportSteps(int, int) {}
+            void reportPose(const Pose &) {}
+
+            uint64_t nowUs() const { return nowUs_; }
+            uint64_t steps() const { return steps_; }
+            uint32_t servoMoves() const { return servoMoves_; }
+            float peakAccel() const { return peakAccel_; }                        // mm/s²
+            float startSpeed() const { return std::max(startSpeed_, stopSpeed_); } // mm/s
+            float topSpeed() const { return topSpeed_; }                           // mm/s
+            float maxPenLagMm() const { return maxLagMm_; }
+
+        private:
+            void endSegment()
+            {
+                if (haveSpeed_)
+                    stopSpeed_ = std::max(stopSpeed_, speed_);
+                haveStep_ = false;
+                haveSpeed_ = false;
+            }
+
+            // Blockiert servoDelayMs, der Stift ist erst nach servoTravelMs angekommen
+            void moveServo()
+            {
+                penSettledUs_ = nowUs_ + servoTravelUs_;
+                nowUs_ += servoDelayUs_;
+                lagMm_ = 0.0f;
+                servoMoves_++;
+            }
+
+            float mmPerStep_;
+            uint64_t servoDelayUs_;
+            uint64_t servoTravelUs_;
+            uint64_t nowUs_ = 0;
+            uint64_t lastStepUs_ = 0;
+            uint64_t penSettledUs_ = 0;
+            uint64_t steps_ = 0;
+            uint32_t servoMoves_ = 0;
+            float speed_ = 0.0f;
+            float peakAccel_ = 0.0f;
+            float startSpeed_ = 0.0f;
+            float stopSpeed_ = 0.0f;
+            float topSpeed_ = 0.0f;
+            float lagMm_ = 0.0f;
+            float maxLagMm_ = 0.0f;
+            bool haveStep_ = false;
+            bool haveSpeed_ = false;
+            bool drawing_ = false;
+            uint32_t rng_;
+        };
+
+    } // namespace host
+} // namespace tiny_turtle
@@ -0,0 +1,379 @@
+/**
+ * @file host/tune_motion.cpp
+ * @brief Rampen- und Servo-Einstellungen per Parameter-Suche auf allen Kernen bestimmen
+ *
+ * Verwendung:
+ *   tune_motion                             # eingebauter Korpus, Standard-Raster
+ *   tune_motion host/jobs/hello.job a.job   # eigene Aufträge als Korpus
+ *   tune_motion --ramp 2:20:1 --servo 250:400:25 --max-accel 150
+ *   tune_motion --random 500 --seed 7 -o tuned.cmake
+ *
+ * Jeder Kandidat (MIN/MAX_STEP_DELAY_US, RAMP_VALUE, SERVO_MOVE_DELAY_MS)
+ * fährt den ganzen Korpus über motion::MotionCore auf host::TuneHal. Zulässig
+ * ist er, wenn Spitzenbeschleunigung, Anfahrsprung, Höchstgeschwindigkeit und
+ * Stift-Verzug unter den Grenzen bleiben; zulässige Kandidaten werden nach
+ * Gesamtzeit sortiert; die aktuelle Einstellung tritt immer mit an. Ohne
+ * Angabe gelten als Grenzen die Werte der aktuellen Einstellung (nicht
+ * ruppiger als heute, Anfahren +5 %), die Höchstgeschwindigkeit des
+ * Stepper-Profils (minIntervalUs) und 0.2 mm Stift-Verzug.
+ *
+ * Ausgabe: Rangliste als CSV auf stdout, das Ergebnis als
+ * target_compile_definitions-Zeile für main/CMakeLists.txt auf stderr
+ * (mit -o zusätzlich in eine Datei). Das Ergebnis hängt nicht von der
+ * Thread-Anzahl ab.
+ *
+ * hal::setRamp() wird nicht abgesucht: es betrifft nur die Timer-Steuerung,
+ * Zeichenaufträge fahren mit den blockierenden Schleifen.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/config.h"
+#include "core/kinematics.h"
+#include "job.h"
+#include "motion/motion_core.h"
+#include "parallel.h"
+#include "tune_hal.h"
+
+using namespace tiny_turtle;
+
+namespace
+{
+    struct Range
+    {
+        long lo, hi, step;
+    };
+
+    struct Candidate
+    {
+        motion::MotionTuning tuning;
+        uint32_t servoDelayMs;
+    };
+
+    struct Result
+    {
+        Candidate candidate;
+        double seconds = 0;
+        float peakAccel = 0; // mm/s²
+        float startSpeed = 0; // mm/s
+        float topSpeed = 0;   // mm/s
+        float penLagMm = 0;
+        int violations = 0;
+    };
+
+    struct Limits
+    {
+        float maxAccel = 0; // 0 = aus der aktuellen Einstellung
+        float maxStartSpeed = 0;
+        float maxSpeed = 0;
+        float maxPenLagMm = 0.2f;
+        uint32_t servoTravelMs = 300; // SG90: 0.1 s je 60°, Stift 0° -> 180°
+    };
+
+    bool parseRange(const char *text, Range &range)
+    {
+        char *end;
+        range.lo = std::strtol(text, &end, 10);
+        range.hi = range.lo;
+        range.step = 1;
+        if (*end == ':')
+            range.hi = std::strtol(end + 1, &end, 10);
+        if (*end == ':')
+            range.step = std::strtol(end + 1, &end, 10);
+        return *end == '\0' && range.lo > 0 && range.hi >= range.lo && range.step > 0;
+    }
+
+    std::vector<long> values(const Range &range)
+    {
+        std::vector<long> out;
+        for (long v = range.lo; v <= range.hi; v += range.step)
+            out.push_back(v);
+        return out;
+    }
+
+    class Rng
+    {
+    public:
+        explicit Rng(uint32_t seed) : state_(seed ? seed : 1) {}
+
+        long between(long lo, long hi)
+        {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 17;
+            state_ ^= state_ << 5;
+            return lo + static_cast<long>(state_ % static_cast<uint32_t>(hi - lo + 1));
+        }
+
+    private:
+        uint32_t state_;
+    };
+
+    bool sameCandidate(const Candidate &a, const Candidate &b)
+    {
+        return a.tuning.minStepDelayUs == b.tuning.minStepDelayUs && a.tuning.maxStepDelayUs == b.tuning.maxStepDelayUs &&
+               a.tuning.rampValue == b.tuning.rampValue && a.servoDelayMs == b.servoDelayMs;
+    }
+
+    Candidate makeCandidate(long minUs, long maxUs, long ramp, long servoMs)
+    {
+        return {{static_cast<uint16_t>(minUs), static_cast<uint16_t>(maxUs), static_cast<uint16_t>(ramp)},
+                static_cast<uint32_t>(servoMs)};
+    }
+
+    // Eingebauter Korpus: kurze und lange Polylinien wie in importierten Grafiken
+    host::Job builtinCorpus()
+    {
+        Rng rng(2024);
+        host::JobCommand strokes;
+        strokes.op = host::JobOp::STROKES;
+        for (int s = 0; s < 40; s++)
+        {
+            host::Polyline line;
+            Point2D p(static_cast<float>(rng.between(0, 200)), static_cast<float>(rng.between(0, 200)));
+            line.push_back(p);
+            long points = rng.between(2, 12);
+            for (long i = 0; i < points; i++)
+            {
+                float reach = s % 4 == 0 ? 60.0f : 8.0f;
+                p.x += (rng.between(0, 2000) - 1000) * reach / 1000.0f;
+                p.y += (rng.between(0, 2000) - 1000) * reach / 1000.0f;
+                line.push_back(p);
+            }
+            strokes.strokes.push_back(std::move(line));
+        }
+
+        host::Job job;
+        job.strokeCount = strokes.strokes.size();
+        for (const host::Polyline &l : strokes.strokes)
+            job.segmentCount += l.size() - 1;
+        job.commands.push_back(std::move(strokes));
+        return job;
+    }
+
+    Result evaluate(const std::vector<host::Job> &corpus, const Candidate &c, const Limits &limits)
+    {
+        const float mmPerStep = 1.0f / config::STEPS_PER_MM;
+        Result r;
+        r.candidate = c;
+        for (const host::Job &job : corpus)
+        {
+            host::TuneHal hal(mmPerStep, c.servoDelayMs, limits.servoTravelMs);
+            HotState hot{};
+            hot.direction = 1;
+            Pose pose = {0.0f, 0.0f, 0.0f};
+            motion::MotionCore<host::TuneHal> core(hal, hot, c.tuning);
+            host::runJob(job, core, pose);
+            hal.stopMotors();
+
+            r.seconds += hal.nowUs() / 1e6;
+            r.peakAccel = std::max(r.peakAccel, hal.peakAccel());
+            r.startSpeed = std::max(r.startSpeed, hal.startSpeed());
+            r.topSpeed = std::max(r.topSpeed, hal.topSpeed());
+            r.penLagMm = std::max(r.penLagMm, hal.maxPenLagMm());
+        }
+        return r;
+    }
+
+    int violations(const Result &r, const Limits &limits)
+    {
+        // Kleine Toleranz: die Ausgangseinstellung muss ihre eigenen Grenzen einhalten
+        constexpr float SLACK = 1.0001f;
+        return (r.peakAccel > limits.maxAccel * SLACK) + (r.startSpeed > limits.maxStartSpeed * SLACK) +
+               (r.topSpeed > limits.maxSpeed * SLACK) + (r.penLagMm > limits.maxPenLagMm);
+    }
+
+    void printRow(const char *rank, const Result &r)
+    {
+        const motion::MotionTuning &t = r.candidate.tuning;
+        std::printf("%s,%u,%u,%u,%u,%.2f,%.1f,%.2f,%.2f,%.2f,%s\n", rank, t.minStepDelayUs, t.maxStepDelayUs,
+                    t.rampValue, r.candidate.servoDelayMs, r.seconds, r.peakAccel, r.startSpeed, r.topSpeed,
+                    r.penLagMm, r.violations ? "nein" : "ja");
+    }
+
+    std::string profileLine(const Result &r)
+    {
+        const motion::MotionTuning &t = r.candidate.tuning;
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_MIN_STEP_DELAY_US=%u "
+                      "TT_MAX_STEP_DELAY_US=%u TT_RAMP_VALUE=%u TT_SERVO_MOVE_DELAY_MS=%u)",
+                      t.minStepDelayUs, t.maxStepDelayUs, t.rampValue, r.candidate.servoDelayMs);
+        return line;
+    }
+
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "Verwendung: tune_motion [AUFTRAG...] [--min A:B[:S]] [--max A:B[:S]] [--ramp A:B[:S]]\n"
+                     "                        [--servo A:B[:S]] [--random N] [--seed S] [--threads N] [--top N]\n"
+                     "                        [--max-accel MM_S2] [--max-start MM_S] [--max-speed MM_S]\n"
+                     "                        [--max-lag MM] [--servo-travel MS] [-o DATEI]\n");
+        return 2;
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Range minRange = {500, 1200, 100};
+    Range maxRange = {1500, 3000, 500};
+    Range rampRange = {1, 20, 1};
+    Range servoRange = {200, 400, 50};
+    Limits limits;
+    size_t randomCount = 0;
+    uint32_t seed = 1;
+    unsigned threads = 0;
+    size_t top = 20;
+    const char *output = nullptr;
+    std::vector<const char *> jobFiles;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *next = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (std::strcmp(arg, "--min") == 0 && next)
+            ok = parseRange(argv[++i], minRange);
+        else if (std::strcmp(arg, "--max") == 0 && next)
+            ok = parseRange(argv[++i], maxRange);
+        else if (std::strcmp(arg, "--ramp") == 0 && next)
+            ok = parseRange(argv[++i], rampRange);
+        else if (std::strcmp(arg, "--servo") == 0 && next)
+            ok = parseRange(argv[++i], servoRange);
+        else if (std::strcmp(arg, "--random") == 0 && next)
+            randomCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--seed") == 0 && next)
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--threads") == 0 && next)
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--top") == 0 && next)
+            top = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--max-accel") == 0 && next)
+            limits.maxAccel = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(arg, "--max-start") == 0 && next)
+            limits.maxStartSpeed = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(arg, "--max-speed") == 0 && next)
+            limits.maxSpeed = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(arg, "--max-lag") == 0 && next)
+            limits.maxPenLagMm = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(arg, "--servo-travel") == 0 && next)
+            limits.servoTravelMs = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "-o") == 0 && next)
+            output = argv[++i];
+        else if (arg[0] != '-')
+            jobFiles.push_back(arg);
+        else
+            ok = false;
+        if (!ok)
+            return usage();
+    }
+
+    // Korpus laden und Linien einmal ordnen - gleich für alle Kandidaten
+    std::vector<host::Job> corpus;
+    for (const char *path : jobFiles)
+    {
+        host::Job job;
+        if (!host::loadJob(path, job))
+            return 1;
+        host::orderJob(job);
+        corpus.push_back(std::move(job));
+    }
+    if (corpus.empty())
+    {
+        corpus.push_back(builtinCorpus());
+        host::orderJob(corpus.back());
+    }
+
+    // Ausgangseinstellung liefert die Standard-Grenzen
+    Candidate current = {motion::defaultTuning(), static_cast<uint32_t>(config::SERVO_MOVE_DELAY_MS)};
+    Result baseline = evaluate(corpus, current, limits);
+    if (limits.maxAccel <= 0)
+        limits.maxAccel = baseline.peakAccel;
+    if (limits.maxStartSpeed <= 0)
+        limits.maxStartSpeed = baseline.startSpeed * 1.05f; // Erstes Intervall hängt etwas von der Rampe ab
+    if (limits.maxSpeed <= 0)
+        limits.maxSpeed = 1e6f / (config::STEPS_PER_MM * config::PROFILE.minIntervalUs);
+    baseline.violations = violations(baseline, limits);
+
+    // Kandidaten vorab erzeugen, damit die Zufallsfolge nicht von den Threads abhängt;
+    // die aktuelle Einstellung tritt immer mit an
+    std::vector<Candidate> candidates = {current};
+    if (randomCount)
+    {
+        Rng rng(seed);
+        while (candidates.size() <= randomCount)
+        {
+            long minUs = rng.between(minRange.lo, minRange.hi);
+            long maxUs = rng.between(maxRange.lo, maxRange.hi);
+            long ramp = rng.between(rampRange.lo, rampRange.hi);
+            long servo = rng.between(servoRange.lo, servoRange.hi);
+            if (minUs <= maxUs)
+                candidates.push_back(makeCandidate(minUs, maxUs, ramp, servo));
+        }
+    }
+    else
+    {
+        for (long minUs : values(minRange))
+            for (long maxUs : values(maxRange))
+                for (long ramp : values(rampRange))
+                    for (long servo : values(servoRange))
+                        if (minUs <= maxUs && !sameCandidate(current, makeCandidate(minUs, maxUs, ramp, servo)))
+                            candidates.push_back(makeCandidate(minUs, maxUs, ramp, servo));
+    }
+
+    std::vector<Result> results(candidates.size());
+    host::parallelFor(candidates.size(), threads, [&](size_t i)
+                      {
+                          results[i] = evaluate(corpus, candidates[i], limits);
+                          results[i].violations = violations(results[i], limits); });
+
+    // Zulässige zuerst, dann nach Zeit, bei gleicher Zeit die sanftere Rampe
+    std::stable_sort(results.begin(), results.end(), [](const Result &a, const Result &b)
+                     {
+                         if (a.violations != b.violations)
+                             return a.violations < b.violations;
+                         if (a.seconds != b.seconds)
+                             return a.seconds < b.seconds;
+                         return a.peakAccel < b.peakAccel; });
+
+    std::printf("rank,min_step_delay_us,max_step_delay_us,ramp_value,servo_move_delay_ms,time_s,peak_accel_mm_s2,"
+                "start_speed_mm_s,top_speed_mm_s,pen_lag_mm,ok\n");
+    printRow("aktuell", baseline);
+    for (size_t i = 0; i < std::min(top, results.size()); i++)
+        printRow(std::to_string(i + 1).c_str(), results[i]);
+
+    size_t feasible = std::count_if(results.begin(), results.end(), [](const Result &r)
+                                    { return r.violations == 0; });
+    std::fprintf(stderr, "tune_motion: %zu Aufträge, %zu Kandidaten, %zu zulässig (Beschleunigung <= %.1f mm/s², "
+                         "Anfahren <= %.2f mm/s, Geschwindigkeit <= %.2f mm/s, Stift-Verzug <= %.2f mm)\n",
+                 corpus.size(), results.size(), feasible, limits.maxAccel, limits.maxStartSpeed, limits.maxSpeed,
+                 limits.maxPenLagMm);
+    if (!feasible)
+    {
+        std::fprintf(stderr, "tune_motion: kein Kandidat hält alle Grenzen ein\n");
+        return 1;
+    }
+
+    const Result &best = results.front();
+    std::fprintf(stderr, "tune_motion: %.2f s statt %.2f s (%+.1f %%)\n", best.seconds, baseline.seconds,
+                 100.0 * (best.seconds - baseline.seconds) / baseline.seconds);
+    std::string line = profileLine(best);
+    std::fprintf(stderr, "%s\n", line.c_str());
+
+    if (output)
+    {
+        FILE *out = std::fopen(output, "w");
+        if (!out || std::fprintf(out, "# Erzeugt von host/tune_motion\n%s\n", line.c_str()) < 0 || std::fclose(out) != 0)
+        {
+            std::fprintf(stderr, "tune_motion: %s nicht schreibbar\n", output);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+/**
+ * @file core/arena.h
+ * @brief Bump-Allokator über einem festen Speicherblock
+ *
+ * Vergibt Speicher durch Weiterschieben eines Zeigers, freigegeben wird nur
+ * alles auf einmal (reset()) oder bis zu einer Marke (rewind()). Passt zu
+ * "kein Heap nach init()" (monitor/alloc_tracking.h): der Block ist auf dem
+ * Gerät ein statisches Array, auf dem Host z.B. ein std::vector.
+ *
+ *   static uint8_t s_path_memory[4096];
+ *   BumpArena arena(s_path_memory, sizeof(s_path_memory));
+ *   int32_t *xs = arena.allocate<int32_t>(256); // nullptr wenn voll
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tiny_turtle
+{
+    class BumpArena
+    {
+    public:
+        // Ausrichtung jeder Allokation (SIMD-Breite auf dem Host, Cache-Zeile auf dem Gerät)
+        static constexpr size_t ALIGNMENT = 32;
+
+        BumpArena(void *memory, size_t size)
+            : base_(static_cast<uint8_t *>(memory)), size_(size), used_(0) {}
+
+        BumpArena(const BumpArena &) = delete;
+        BumpArena &operator=(const BumpArena &) = delete;
+
+        /**
+         * @brief Platz für count Elemente (nicht initialisiert)
+         * @return nullptr wenn der Block nicht reicht
+         */
+        template <class T>
+        T *allocate(size_t count)
+        {
+            uintptr_t start = reinterpret_cast<uintptr_t>(base_) + used_;
+            size_t pad = (ALIGNMENT - start % ALIGNMENT) % ALIGNMENT;
+            size_t bytes = count * sizeof(T);
+            if (count > (SIZE_MAX - pad) / sizeof(T) || used_ + pad + bytes > size_)
+                return nullptr;
+            used_ += pad;
+            T *p = reinterpret_cast<T *>(base_ + used_);
+            used_ += bytes;
+            return p;
+        }
+
+        size_t mark() const { return used_; }
+
+        /**
+         * @brief Alles nach einer Marke freigeben
+         */
+        void rewind(size_t mark)
+        {
+            if (mark < used_)
+                used_ = mark;
+        }
+
+        void reset() { used_ = 0; }
+
+        size_t used() const { return used_; }
+        size_t capacity() const { return size_; }
+
+    private:
+        uint8_t *base_;
+        size_t size_;
+        size_t used_;
+    };
+
+} // namespace tiny_turtle
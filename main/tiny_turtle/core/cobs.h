@@ -0,0 +1,108 @@
+#pragma once
+/**
+ * @file core/cobs.h
+ * @brief COBS-Kodierung (Consistent Overhead Byte Stuffing) und CRC-8
+ *
+ * Kodierte Pakete enthalten kein 0x00-Byte, so dass 0x00 als eindeutiger
+ * Frame-Trenner dienen kann. Ein Empfänger kann sich nach Störungen (z.B.
+ * eingestreuten Log-Zeilen) am nächsten 0x00 wieder synchronisieren.
+ *
+ * Header-only und ohne ESP-IDF-Abhängigkeit (wird auch vom Host-Decoder genutzt).
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tiny_turtle
+{
+    namespace cobs
+    {
+        /**
+         * @brief Maximale Größe der kodierten Daten (ohne Trenner)
+         */
+        constexpr size_t maxEncodedSize(size_t len)
+        {
+            return len + len / 254 + 1;
+        }
+
+        /**
+         * @brief Daten COBS-kodieren
+         * @param out Puffer mit mindestens maxEncodedSize(len) Bytes
+         * @return Anzahl geschriebener Bytes (ohne abschließendes 0x00)
+         */
+        inline size_t encode(const uint8_t *in, size_t len, uint8_t *out)
+        {
+            size_t codeIdx = 0;
+            size_t outIdx = 1;
+            uint8_t code = 1;
+
+            for (size_t i = 0; i < len; i++)
+            {
+                if (in[i] == 0)
+                {
+                    out[codeIdx] = code;
+                    codeIdx = outIdx++;
+                    code = 1;
+                    continue;
+                }
+
+                out[outIdx++] = in[i];
+                if (++code == 0xFF)
+                {
+                    out[codeIdx] = code;
+                    codeIdx = outIdx++;
+                    code = 1;
+                }
+            }
+            out[codeIdx] = code;
+            return outIdx;
+        }
+
+        /**
+         * @brief COBS-Daten dekodieren
+         * @param in Kodierte Daten (ohne 0x00-Trenner)
+         * @param out Puffer mit mindestens len Bytes
+         * @return Anzahl dekodierter Bytes, 0 bei ungültiger Kodierung
+         */
+        inline size_t decode(const uint8_t *in, size_t len, uint8_t *out)
+        {
+            size_t outIdx = 0;
+            size_t i = 0;
+
+            while (i < len)
+            {
+                uint8_t code = in[i++];
+                if (code == 0 || i + code - 1 > len)
+                    return 0;
+
+                for (uint8_t j = 1; j < code; j++)
+                {
+                    out[outIdx++] = in[i++];
+                }
+                if (code != 0xFF && i < len)
+                {
+                    out[outIdx++] = 0;
+                }
+            }
+            return outIdx;
+        }
+
+        /**
+         * @brief CRC-8 (Polynom 0x07) über einen Puffer
+         */
+        inline uint8_t crc8(const uint8_t *data, size_t len)
+        {
+            uint8_t crc = 0;
+            for (size_t i = 0; i < len; i++)
+            {
+                crc ^= data[i];
+                for (int b = 0; b < 8; b++)
+                {
+                    crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+                }
+            }
+            return crc;
+        }
+
+    } // namespace cobs
+} // namespace tiny_turtle
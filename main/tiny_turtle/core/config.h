@@ -7,8 +7,45 @@
  * Hier werden GPIO-Pins, Timing-Parameter und Roboter-Geometrie definiert.
  */
 
+#include <cstddef>
 #include <cstdint>
 
+// Motortreiber-Backend der Stepper-Steuerung (siehe hal/stepper_backend.h), z.B.:
+//   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_STEPPER_BACKEND=1)
+#define TT_STEPPER_BACKEND_UNIPOLAR 0 // 28BYJ-48 am ULN2003 (vier Spulen)
+#define TT_STEPPER_BACKEND_STEP_DIR 1 // A4988/DRV8825/TMC (STEP, DIR, EN)
+
+#ifndef TT_STEPPER_BACKEND
+#define TT_STEPPER_BACKEND TT_STEPPER_BACKEND_UNIPOLAR
+#endif
+
+// Roboter-Variante des Unipolar-Backends (Rad-Geometrie, siehe core/kinematics.h)
+#define TT_ROBOT_VARIANT_STOCK 0       // Original-Turtle (24 mm Räder)
+#define TT_ROBOT_VARIANT_LARGE_WHEEL 1 // Größere Räder, breitere Spur
+
+#ifndef TT_ROBOT_VARIANT
+#define TT_ROBOT_VARIANT TT_ROBOT_VARIANT_STOCK
+#endif
+
+// Rampe blockierender Bewegungen und Servo-Wartezeit; host/tune_motion gibt
+// ermittelte Werte in dieser Form aus:
+//   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_MIN_STEP_DELAY_US=900 TT_RAMP_VALUE=8)
+#ifndef TT_MIN_STEP_DELAY_US
+#define TT_MIN_STEP_DELAY_US 0 // 0 = Wert des Stepper-Profils
+#endif
+
+#ifndef TT_MAX_STEP_DELAY_US
+#define TT_MAX_STEP_DELAY_US 0 // 0 = Wert des Stepper-Profils
+#endif
+
+#ifndef TT_RAMP_VALUE
+#define TT_RAMP_VALUE 5
+#endif
+
+#ifndef TT_SERVO_MOVE_DELAY_MS
+#define TT_SERVO_MOVE_DELAY_MS 400
+#endif
+
 namespace tiny_turtle
 {
     namespace config
@@ -33,6 +70,9 @@ namespace tiny_turtle
         // Motor 1: GPIO 10, 11, 14, 15 (save)
         // Motor 2: GPIO 18, 19, 20, 21 (save)
         // Debug-LED: GPIO 8 (onboard)
+        //
+        // Mit TT_STEPPER_BACKEND_STEP_DIR gilt je Motor: A = STEP, B = DIR,
+        // C = EN (low-aktiv), D = frei
         //-----------------------------------------------------------------------
         constexpr int A4 = 4;
         constexpr int A5 = 5;
@@ -62,32 +102,121 @@ namespace tiny_turtle
         constexpr int SWITCH_BACK = A5;
         constexpr int PHOTO_SENSOR = A6;
 
+        //===========================================================================
+        // Stepper-Profile (Kinematik je Backend)
+        //===========================================================================
+
+        constexpr float PI = 3.14159265359f;
+
+        struct StepperProfile
+        {
+            const char *name;
+            int stepsPerRotation;        // Schritt-Einheiten pro Radumdrehung (inkl. Getriebe/Mikroschritt)
+            float wheelDiameter;         // mm
+            float wheelDistance;         // Abstand zwischen den Rädern in mm
+            uint16_t minStepDelayUs;     // Blockierende Bewegungen: kürzeste Verzögerung
+            uint16_t maxStepDelayUs;     // Blockierende Bewegungen: längste Verzögerung
+            uint16_t defaultStepDelayUs; // Start-Intervall
+            uint32_t minIntervalUs;      // Timer-Steuerung: kürzestes Intervall pro Schritt-Einheit
+            uint32_t maxIntervalUs;      // Timer-Steuerung: längstes Intervall
+        };
+
+        // Schrittmotor-Eigenschaften (28BYJ-48)
+        constexpr int STEPS_PER_MOTOR_ROTATION = 64; // Interne Schritte
+        constexpr int GEAR_RATIO = 64; // Getriebeübersetzung
+
+        // 28BYJ-48 im Halbschritt, ca. 1-2 kHz
+        inline constexpr StepperProfile PROFILE_28BYJ48 = {
+            "28BYJ-48", STEPS_PER_MOTOR_ROTATION * GEAR_RATIO, 24.05f, 33.5f, 1000, 3000, 2000, 500, 10000};
+
+        // Gleicher Motor mit 40-mm-Rädern und 60 mm Spur: schneller, gröber aufgelöst
+        inline constexpr StepperProfile PROFILE_28BYJ48_LARGE_WHEEL = {
+            "28BYJ-48 large wheel", STEPS_PER_MOTOR_ROTATION * GEAR_RATIO, 40.0f, 60.0f, 1000, 3000, 2000, 500, 10000};
+
+        // NEMA17 (200 Schritte) mit 1/16-Mikroschritt im Treiber, bis 40 kHz
+        inline constexpr StepperProfile PROFILE_NEMA17_STEP_DIR = {
+            "NEMA17 1/16", 200 * 16, 60.0f, 120.0f, 100, 1000, 400, 25, 10000};
+
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+        inline constexpr const StepperProfile &BASE_PROFILE = PROFILE_NEMA17_STEP_DIR;
+#elif TT_ROBOT_VARIANT == TT_ROBOT_VARIANT_LARGE_WHEEL
+        inline constexpr const StepperProfile &BASE_PROFILE = PROFILE_28BYJ48_LARGE_WHEEL;
+#else
+        inline constexpr const StepperProfile &BASE_PROFILE = PROFILE_28BYJ48;
+#endif
+
+        // Profil mit anderen Verzögerungen für blockierende Bewegungen (0 = unverändert)
+        constexpr StepperProfile withStepDelays(const StepperProfile &p, uint16_t minUs, uint16_t maxUs)
+        {
+            StepperProfile out = p;
+            out.minStepDelayUs = minUs ? minUs : p.minStepDelayUs;
+            out.maxStepDelayUs = maxUs ? maxUs : p.maxStepDelayUs;
+            return out;
+        }
+
+        inline constexpr StepperProfile PROFILE = withStepDelays(BASE_PROFILE, TT_MIN_STEP_DELAY_US, TT_MAX_STEP_DELAY_US);
+        static_assert(PROFILE.minStepDelayUs <= PROFILE.maxStepDelayUs, "TT_MIN_STEP_DELAY_US > TT_MAX_STEP_DELAY_US");
+
+        // STEP/DIR-Pulsform (MCPWM, 10 MHz): DIR muss vor der steigenden Flanke
+        // stabil sein (DRV8825: 650 ns), der Puls mindestens 1.9 µs hoch
+        constexpr uint32_t STEP_DIR_SETUP_NS = 1000;
+        constexpr uint32_t STEP_DIR_PULSE_NS = 2000;
+
         //===========================================================================
         // Timing-Parameter
         //===========================================================================
 
-        constexpr uint16_t MIN_STEP_DELAY_US = 1000; // Minimale Verzögerung (max. Geschwindigkeit)
-        constexpr uint16_t MAX_STEP_DELAY_US = 3000; // Maximale Verzögerung (min. Geschwindigkeit)
-        constexpr uint16_t DEFAULT_STEP_DELAY_US = 2000;
-        constexpr uint16_t RAMP_VALUE = 5; // Beschleunigungsrate (kleiner = sanfter)
+        constexpr uint16_t MIN_STEP_DELAY_US = PROFILE.minStepDelayUs; // Minimale Verzögerung (max. Geschwindigkeit)
+        constexpr uint16_t MAX_STEP_DELAY_US = PROFILE.maxStepDelayUs; // Maximale Verzögerung (min. Geschwindigkeit)
+        constexpr uint16_t DEFAULT_STEP_DELAY_US = PROFILE.defaultStepDelayUs;
+        constexpr uint16_t RAMP_VALUE = TT_RAMP_VALUE; // Beschleunigungsrate (kleiner = sanfter)
+        constexpr uint16_t RAMP_START_DELAY_US = 2000;  // Blockierende Bewegungen beginnen hier, auf Min/Max begrenzt
+
+        // StepMode::AUTO: Vollschritt unterhalb dieses Intervalls (µs pro Halbschritt-Weg),
+        // zurück in den Halbschritt erst oberhalb von Schwelle + Hysterese
+        constexpr uint32_t FULL_STEP_BELOW_US = 800;
+        constexpr uint32_t FULL_STEP_HYSTERESIS_US = 100;
+
+        // Sinus-Mikroschritt (TT_STEPPER_MICROSTEP=1): LEDC-Kanäle 2-5 an LEDC-Timer 2
+        constexpr uint32_t MICROSTEPS_PER_FULL_STEP = 16; // 8, 16 oder 32
+        constexpr uint32_t MICROSTEP_PWM_HZ = 20000;      // Oberhalb des Hörbereichs
+        constexpr uint32_t MICROSTEP_MIN_US = 1000;       // Kürzestes Intervall pro Halbschritt-Einheit
+        constexpr uint32_t MICROSTEP_ABOVE_US = 2500;     // AUTO: Mikroschritt oberhalb dieses Intervalls
+
+        // Wellenform-Streaming über PARLIO (TT_STEPPER_WAVE=1): ein Byte pro Zeitschlitz
+        constexpr uint32_t WAVE_SLOT_RATE_HZ = 100000; // 10 µs Raster
+        constexpr size_t WAVE_BUFFER_SLOTS = 1024;     // Je Halbpuffer (10.24 ms)
+
+        // Stepper-GPTimer: PLL 80 MHz / 2 (kleinster Vorteiler) = 25 ns pro Takt
+        constexpr uint32_t STEPPER_TIMER_RESOLUTION_HZ = 40000000;
+
+        // Schritt-Intervalle als Festkomma in Timer-Takten (Q24.8, HotState::intervalFx)
+        constexpr uint32_t TIMER_TICKS_PER_US = STEPPER_TIMER_RESOLUTION_HZ / 1000000;
+        constexpr uint32_t INTERVAL_FX_SHIFT = 8;
+        constexpr uint32_t INTERVAL_FX_PER_US = TIMER_TICKS_PER_US << INTERVAL_FX_SHIFT;
+
+        constexpr uint32_t intervalToFx(uint32_t us) { return us * INTERVAL_FX_PER_US; }
+
+        // Task-Notification-Slots (CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 3)
+        constexpr uint32_t NOTIFY_INDEX_STEPPER = 1; // hal::waitFor(), hal::playWave()
+        constexpr uint32_t NOTIFY_INDEX_SLEEP = 2;   // hal::sleepUs()
+
+        constexpr uint32_t SLEEP_SPIN_THRESHOLD_US = 50; // Kürzere Wartezeiten aktiv warten
+        constexpr size_t SLEEP_TIMER_SLOTS = 4;          // Gleichzeitig schlafende Tasks (esp_timer)
 
         //===========================================================================
         // Roboter-Geometrie
         //===========================================================================
 
-        constexpr float PI = 3.14159265359f;
-
-        // Schrittmotor-Eigenschaften (28BYJ-48)
-        constexpr int STEPS_PER_MOTOR_ROTATION = 64; // Interne Schritte
-        constexpr int GEAR_RATIO = 64; // Getriebeübersetzung
-        constexpr int STEPS_PER_ROTATION = STEPS_PER_MOTOR_ROTATION * GEAR_RATIO; // = 4096
+        // Aus dem aktiven Profil (28BYJ-48: 4096 Schritte, 24.05 mm Rad, 33.5 mm Spur)
+        constexpr int STEPS_PER_ROTATION = PROFILE.stepsPerRotation;
 
         // Rad-Geometrie (in mm)
-        constexpr float WHEEL_DIAMETER = 24.05f;
+        constexpr float WHEEL_DIAMETER = PROFILE.wheelDiameter;
         constexpr float WHEEL_CIRCUMFERENCE = WHEEL_DIAMETER * PI;
-        constexpr float WHEEL_DISTANCE = 33.5f; // Abstand zwischen den Rädern
+        constexpr float WHEEL_DISTANCE = PROFILE.wheelDistance; // Abstand zwischen den Rädern
 
-        // Berechnete Werte
+        // Berechnete Werte (Gleitkomma; motion/ rechnet mit core/kinematics.h)
         constexpr float STEPS_PER_MM = static_cast<float>(STEPS_PER_ROTATION) / WHEEL_CIRCUMFERENCE;
         constexpr float STEPS_PER_360_ROTATION = WHEEL_DISTANCE * PI * STEPS_PER_MM;
 
@@ -97,7 +226,29 @@ namespace tiny_turtle
 
         constexpr int SERVO_PEN_DOWN = 0;
         constexpr int SERVO_PEN_UP = 180;
-        constexpr int SERVO_MOVE_DELAY_MS = 400; // Wartezeit für Servo-Bewegung
+        constexpr int SERVO_MOVE_DELAY_MS = TT_SERVO_MOVE_DELAY_MS; // Wartezeit für Servo-Bewegung
+
+        //===========================================================================
+        // Status-LED (NeoPixel)
+        //===========================================================================
+
+        constexpr int NEOPIXEL_COUNT = 1;         // Anzahl LEDs in der Kette
+        constexpr int LED_FRAME_RATE_HZ = 50;     // Bildrate der LED-Animationen
+        constexpr uint8_t LED_BRIGHTNESS = 72;    // Globale Helligkeit (0-255, nach Gamma)
+        constexpr float LED_GAMMA = 2.2f;         // Gamma-Korrektur der Farbwerte
+        constexpr int LED_TASK_PRIORITY = 1;      // Niedrig - Motion hat Vorrang
+        constexpr int LED_TASK_STACK_SIZE = 3072; // Bytes
+
+        //===========================================================================
+        // Monitoring
+        //===========================================================================
+
+        constexpr uint32_t TELEMETRY_RATE_HZ = 100; // Standard-Abtastrate der Telemetrie
+        constexpr size_t TRACE_BUFFER_SIZE = 256;     // Einträge im Trace-Ring (Zweierpotenz)
+        constexpr int TRACE_TASK_PRIORITY = 1;        // Niedrig - Formatierung stört Motion nicht
+        constexpr int TRACE_TASK_STACK_SIZE = 3072;   // Bytes
+        constexpr uint32_t TRACE_DUMP_INTERVAL_MS = 500;
+        constexpr size_t PERF_MAX_TASKS = 16;         // Tasks im Performance-Schnappschuss
 
         //===========================================================================
         // Sensor-Konfiguration
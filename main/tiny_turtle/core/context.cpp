@@ -0,0 +1,51 @@
+/**
+ * @file core/context.cpp
+ * @brief Implementierung des Turtle-Kontexts
+ */
+
+#include "context.h"
+
+namespace tiny_turtle
+{
+
+    TurtleContext::TurtleContext(const TurtlePins &pins_)
+        : hot{}, pose{0.0f, 0.0f, 0.0f}, state(), pins(pins_), hal{nullptr, nullptr, nullptr, 0}
+    {
+        hot.direction = 1;
+        hot.delayValue = config::DEFAULT_STEP_DELAY_US;
+        hot.command = MotorCommand::STOP;
+        hot.currentSpeedUs = config::DEFAULT_STEP_DELAY_US;
+        hot.intervalFx = config::intervalToFx(config::DEFAULT_STEP_DELAY_US);
+        hot.targetSpeedUs = config::DEFAULT_STEP_DELAY_US;
+        hot.startSpeedUs = 5000;
+        hot.nextCommand = MotorCommand::STOP;
+        hot.stepMode = StepMode::HALF;
+        hot.activeMode = StepMode::HALF;
+        hot.activeStride = 1;
+        hot.nextMode = StepMode::HALF;
+        // Ruhezustand: nichts in Arbeit, waitFor() kehrt sofort zurück
+        hot.events = static_cast<uint32_t>(StepperEvent::RAMP_DONE) |
+                     static_cast<uint32_t>(StepperEvent::SEGMENT_DONE) |
+                     static_cast<uint32_t>(StepperEvent::STOPPED);
+    }
+
+    TurtlePins TurtleContext::defaultPins()
+    {
+        return {
+            .stepper = {
+                {config::STEP_1A, config::STEP_1B, config::STEP_1C, config::STEP_1D},
+                {config::STEP_2A, config::STEP_2B, config::STEP_2C, config::STEP_2D}},
+            .servo = config::SERVO_PIN,
+            .switchFront = config::SWITCH_FRONT,
+            .switchBack = config::SWITCH_BACK,
+            .photoSensor = config::PHOTO_SENSOR,
+        };
+    }
+
+    TurtleContext &defaultContext()
+    {
+        static TurtleContext s_default;
+        return s_default;
+    }
+
+} // namespace tiny_turtle
@@ -0,0 +1,143 @@
+#pragma once
+/**
+ * @file core/context.h
+ * @brief Instanz-basierter Turtle-Kontext
+ *
+ * Bündelt den gesamten Zustand eines Roboters (Motion-Zustand, Pose,
+ * Stepper-Laufzeitdaten, Seqlock-Schnappschuss) und die zugehörigen
+ * HAL-Handles. Motion-, Drawing- und HAL-Funktionen nehmen den Kontext
+ * explizit entgegen; die bisherigen freien Funktionen arbeiten auf
+ * defaultContext().
+ *
+ * Bewusst ohne ESP-IDF-Header, damit der Kontext auch in Host-Builds
+ * verwendet werden kann (HAL-Handles sind nur vorwärts-deklariert).
+ */
+
+#include <cstdint>
+#include "config.h"
+#include "types.h"
+#include "robot_state.h"
+
+// Vorwärts-Deklarationen der HAL-Handles
+struct gptimer_t;
+struct tskTaskControlBlock;
+class Servo;
+
+namespace tiny_turtle
+{
+
+    /**
+     * @brief Pin-Belegung eines Roboters
+     */
+    struct TurtlePins
+    {
+        uint8_t stepper[2][4];
+        int servo;
+        int switchFront;
+        int switchBack;
+        int photoSensor;
+    };
+
+    /**
+     * @brief Häufig genutzter Zustand (Motion + Stepper-ISR) in einem Block
+     */
+    struct alignas(32) HotState
+    {
+        // Motion-Zustand (blockierende Bewegungen)
+        uint8_t phase1;   // Aktuelle Phase im Half-Step-Muster (Motor 1)
+        uint8_t phase2;   // Aktuelle Phase im Half-Step-Muster (Motor 2)
+        int8_t driverDir[2]; // STEP/DIR: aktueller DIR-Pegel als -1/1 (0 = Treiber aus)
+        bool drawing;     // Stift-Zustand (true = unten/zeichnet)
+        int8_t direction; // Aktuelle Bewegungsrichtung (1 = vorwärts, -1 = rückwärts)
+        int32_t delayValue; // Aktuelle Schritt-Verzögerung
+
+        // Timer-basierte Steuerung (von der ISR gelesen/geschrieben)
+        volatile MotorCommand command;
+        volatile int8_t motor1Dir;
+        volatile int8_t motor2Dir;
+        volatile bool timerRunning;
+        volatile bool rampingUp;
+        volatile bool rampingDown;
+        volatile bool smoothStop;
+        volatile int32_t stepCount;
+        volatile uint32_t currentSpeedUs; // Soll-Intervall in µs (gerundet, für API und Telemetrie)
+        volatile uint32_t intervalFx;     // Soll-Intervall in Timer-Takten, Q24.8 (Schattenregister)
+        volatile uint32_t alarmTicks;     // Im Timer aktives Intervall (schreibt nur die ISR bei laufendem Timer)
+        volatile uint32_t alarmFrac;      // Übertrag des Nachkomma-Anteils
+        volatile uint32_t targetSpeedUs;
+        volatile uint32_t startSpeedUs;
+        volatile uint32_t rampSteps;
+        volatile uint32_t rampCounter;
+        volatile int32_t rampDeltaFx; // Intervall-Änderung pro Schritt (Q24.8 Takte)
+
+        // Schrittfolge
+        volatile StepMode stepMode;   // Gewünscht (AUTO = nach Geschwindigkeit)
+        volatile StepMode activeMode; // In der ISR aktiv (nie AUTO)
+        volatile uint8_t activeStride; // Halbschritte pro Alarm (1 oder 2)
+        volatile uint8_t activeShift;  // Alarm-Intervall >> activeShift (Mikroschritte pro Halbschritt)
+        volatile uint8_t soloMotor;    // Nächster Alarm: nur dieser Motor einen Halbschritt (0 = beide)
+        volatile uint8_t lagMotor;     // Liegt im Segment eine Einheit zurück (0 = keiner, nach Ausrichtung)
+        volatile uint16_t microPhase1; // Position im Sinus-Zyklus (Motor 1, nur MICRO)
+        volatile uint16_t microPhase2; // Position im Sinus-Zyklus (Motor 2, nur MICRO)
+
+        // Segmente (feste Schrittzahl in Halbschritten, ein Folgesegment vorgemerkt)
+        volatile uint32_t segmentSteps; // Verbleibende Schritte (0 = Dauerbetrieb)
+        volatile uint32_t nextSteps;    // Folgesegment (0 = keines)
+        volatile MotorCommand nextCommand;
+        volatile StepMode nextMode;
+
+        // Abschluss-Ereignisse (hal::StepperEvent-Bits)
+        volatile uint32_t events;   // Eingetretene Ereignisse (bis zum nächsten Befehl gesetzt)
+        volatile uint32_t waitMask; // Ereignisse, auf die hal.waiter wartet
+    };
+
+    /**
+     * @brief Aktuelle Position und Ausrichtung
+     */
+    struct Pose
+    {
+        float x;
+        float y;
+        float heading; // 0 = nach vorne (positive Y)
+    };
+
+    /**
+     * @brief HAL-Handles eines Roboters
+     */
+    struct HalHandles
+    {
+        gptimer_t *timer;
+        Servo *servo;
+        tskTaskControlBlock *volatile waiter; // Task in hal::waitFor() (oder nullptr)
+        int64_t servoSettleUs;                // Servo in Bewegung bis (esp_timer-Zeit, 0 = in Ruhe)
+    };
+
+    /**
+     * @brief Gesamter Zustand eines Roboters
+     */
+    class TurtleContext
+    {
+    public:
+        explicit TurtleContext(const TurtlePins &pins = defaultPins());
+
+        TurtleContext(const TurtleContext &) = delete;
+        TurtleContext &operator=(const TurtleContext &) = delete;
+
+        /**
+         * @brief Standard-Pinbelegung aus config.h
+         */
+        static TurtlePins defaultPins();
+
+        HotState hot;
+        Pose pose;
+        RobotState state;
+        TurtlePins pins;
+        HalHandles hal;
+    };
+
+    /**
+     * @brief Standard-Instanz (für die Legacy- und Kurzform-API)
+     */
+    TurtleContext &defaultContext();
+
+} // namespace tiny_turtle
@@ -3,19 +3,19 @@
 namespace tiny_turtle
 {
     // Schrittmotor-Zähler
-    uint8_t stepCount1 = 0;
-    uint8_t stepCount2 = 0;
+    uint8_t &stepCount1 = defaultContext().hot.phase1;
+    uint8_t &stepCount2 = defaultContext().hot.phase2;
 
     // Bewegungs-Zustand
-    long delayValue = 2000;
-    int direction = 1;
-    bool isDrawing = false;
+    int32_t &delayValue = defaultContext().hot.delayValue;
+    int8_t &direction = defaultContext().hot.direction;
+    bool &isDrawing = defaultContext().hot.drawing;
 
 } // namespace tiny_turtle
 
-// Legacy-Variablen (separate Kopien für Rückwärtskompatibilität)
-uint8_t stepCount1 = 0;
-uint8_t stepCount2 = 0;
-long delayValue = 2000;
-int direction = 1;
-bool drawing = false;
+// Legacy-Variablen (Aliase auf denselben Zustand)
+uint8_t &stepCount1 = tiny_turtle::stepCount1;
+uint8_t &stepCount2 = tiny_turtle::stepCount2;
+int32_t &delayValue = tiny_turtle::delayValue;
+int8_t &direction = tiny_turtle::direction;
+bool &drawing = tiny_turtle::isDrawing;
@@ -3,32 +3,34 @@
  * @file globals.h
  * @brief Globale Zustandsvariablen für Tiny Turtle
  *
- * Diese Variablen werden für den aktuellen Zustand des Roboters verwendet.
- * Langfristig sollten diese in eine State-Klasse gekapselt werden.
+ * Der Zustand liegt im TurtleContext (core/context.h). Die Variablen hier
+ * sind nur noch Referenzen auf defaultContext() - Alt-Code kann sie weiter
+ * lesen und schreiben, es gibt aber keine getrennten Kopien mehr.
  */
 
 #include <cstdint>
+#include "context.h"
 
 namespace tiny_turtle
 {
     //===========================================================================
-    // Roboter-Zustand
+    // Roboter-Zustand (Referenzen auf defaultContext().hot)
     //===========================================================================
 
     // Schrittmotor-Zähler (aktuelle Phase im Half-Step-Muster)
-    extern uint8_t stepCount1;
-    extern uint8_t stepCount2;
+    extern uint8_t &stepCount1;
+    extern uint8_t &stepCount2;
 
     // Bewegungs-Zustand
-    extern long delayValue; // Aktuelle Schritt-Verzögerung
-    extern int direction;   // Aktuelle Bewegungsrichtung (1 = vorwärts, -1 = rückwärts)
-    extern bool isDrawing;  // Stift-Zustand (true = unten/zeichnet) - renamed to avoid namespace conflict
+    extern int32_t &delayValue; // Aktuelle Schritt-Verzögerung
+    extern int8_t &direction;   // Aktuelle Bewegungsrichtung (1 = vorwärts, -1 = rückwärts)
+    extern bool &isDrawing;     // Stift-Zustand (true = unten/zeichnet)
 
 } // namespace tiny_turtle
 
-// Legacy-Kompatibilität: Globale Variablen exportieren
-extern uint8_t stepCount1;
-extern uint8_t stepCount2;
-extern long delayValue;
-extern int direction;
-extern bool drawing; // Legacy name
+// Legacy-Kompatibilität: Globale Variablen exportieren (gleiche Speicherstellen)
+extern uint8_t &stepCount1;
+extern uint8_t &stepCount2;
+extern int32_t &delayValue;
+extern int8_t &direction;
+extern bool &drawing; // Legacy name
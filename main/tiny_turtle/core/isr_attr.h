@@ -0,0 +1,27 @@
+#pragma once
+/**
+ * @file core/isr_attr.h
+ * @brief Speicher-Attribute für Code und Daten der Stepper-ISR
+ *
+ * Während Flash-Schreibzugriffen (NVS, Partitionen, OTA) ist der Cache aus -
+ * die Stepper-ISR läuft trotzdem weiter (CONFIG_GPTIMER_ISR_IRAM_SAFE) und darf
+ * dann nur IRAM-Code und DRAM-Daten berühren. Header-only Helfer, die aus der
+ * ISR aufgerufen werden (SeqLock, TraceRing, Histogram, Treiber-Backends),
+ * sind daher TT_ISR_INLINE: sie landen im IRAM-Code des Aufrufers, auch wenn
+ * der Compiler sie sonst als eigene Funktion im Flash ablegen würde.
+ *
+ * Auf dem Host sind IRAM_ATTR/DRAM_ATTR leer, die Header bleiben IDF-frei.
+ */
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+#ifndef DRAM_ATTR
+#define DRAM_ATTR
+#endif
+#endif
+
+#define TT_ISR_INLINE inline __attribute__((always_inline))
@@ -0,0 +1,25 @@
+/**
+ * @file core/kinematics.cpp
+ * @brief Laufzeit-Kalibrierung der Kinematik
+ */
+
+#include "kinematics.h"
+
+namespace tiny_turtle
+{
+    static KinematicsFactors s_calibrated = Kinematics<config::PROFILE>::FACTORS;
+
+    const KinematicsFactors &CalibratedKinematics::factors()
+    {
+        return s_calibrated;
+    }
+
+    void calibrateKinematics(float wheelDiameterMm, float wheelDistanceMm)
+    {
+        config::StepperProfile profile = config::PROFILE;
+        profile.wheelDiameter = wheelDiameterMm;
+        profile.wheelDistance = wheelDistanceMm;
+        s_calibrated = KinematicsFactors::from(profile);
+    }
+
+} // namespace tiny_turtle
@@ -0,0 +1,168 @@
+#pragma once
+/**
+ * @file core/kinematics.h
+ * @brief Umrechnung Weg/Winkel/Geschwindigkeit -> Schritte aus einem Stepper-Profil
+ *
+ * Kinematics<Profile> leitet aus einem config::StepperProfile zur Compile-Zeit
+ * Festkomma-Faktoren (Q16.16), eine Dreh-Tabelle für ganze Grad und die
+ * Geschwindigkeits-Grenzen ab. Jede Firmware bekommt so Konstanten für ihre
+ * Hardware, ohne Gleitkomma pro Bewegung:
+ *
+ *   using K = Kinematics<config::PROFILE_28BYJ48_LARGE_WHEEL>;
+ *   uint32_t steps = K::stepsForMm(25.0f);
+ *
+ * Für vermessene Roboter gibt es CalibratedKinematics mit derselben
+ * Schnittstelle: calibrateKinematics() rechnet die Faktoren einmal beim Start
+ * aus. Welche Variante motion/ verwendet, legt TT_KINEMATICS_RUNTIME fest
+ * (ActiveKinematics).
+ *
+ * Frei von ESP-IDF (Host-Werkzeuge nutzen dieselben Faktoren).
+ */
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "config.h"
+
+// 1 = motion/ rechnet mit den zur Laufzeit kalibrierten Faktoren, z.B.:
+//   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_KINEMATICS_RUNTIME=1)
+#ifndef TT_KINEMATICS_RUNTIME
+#define TT_KINEMATICS_RUNTIME 0
+#endif
+
+namespace tiny_turtle
+{
+    constexpr uint32_t KINEMATICS_FX_SHIFT = 16;
+
+    /**
+     * @brief Aus einem Profil abgeleitete Faktoren (constexpr oder einmal zur Laufzeit)
+     */
+    struct KinematicsFactors
+    {
+        uint32_t stepsPerMmFx;     // Schritt-Einheiten pro mm, Q16.16
+        uint32_t stepsPerDegreeFx; // Schritt-Einheiten pro Grad Drehung auf der Stelle, Q16.16
+        uint32_t usPerStepAt1MmS;  // Schrittintervall bei 1 mm/s
+        uint16_t minStepDelayUs;   // Blockierende Bewegungen
+        uint16_t maxStepDelayUs;
+        uint32_t minIntervalUs;    // Timer-Steuerung
+        uint32_t maxIntervalUs;
+        uint32_t maxSpeedMmS;      // Bei minIntervalUs
+
+        static constexpr KinematicsFactors from(const config::StepperProfile &p)
+        {
+            double stepsPerMm = p.stepsPerRotation / (static_cast<double>(p.wheelDiameter) * config::PI);
+            double stepsPerDegree = static_cast<double>(p.wheelDistance) * config::PI * stepsPerMm / 360.0;
+            uint32_t usPerStep = static_cast<uint32_t>(1000000.0 / stepsPerMm + 0.5);
+            return {
+                static_cast<uint32_t>(stepsPerMm * (1u << KINEMATICS_FX_SHIFT) + 0.5),
+                static_cast<uint32_t>(stepsPerDegree * (1u << KINEMATICS_FX_SHIFT) + 0.5),
+                usPerStep,
+                p.minStepDelayUs,
+                p.maxStepDelayUs,
+                p.minIntervalUs,
+                p.maxIntervalUs,
+                usPerStep / p.minIntervalUs,
+            };
+        }
+
+        // Betrag eines Q16.16-Werts mal Faktor, gerundet auf ganze Schritte
+        static constexpr uint32_t scale(uint32_t valueFx, uint32_t factorFx)
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(valueFx) * factorFx + (1ull << 31)) >> 32);
+        }
+
+        static constexpr uint32_t toFx(float value)
+        {
+            return static_cast<uint32_t>((value < 0 ? -value : value) * (1u << KINEMATICS_FX_SHIFT) + 0.5f);
+        }
+
+        /**
+         * @brief Schritt-Einheiten für eine Strecke (Vorzeichen wird ignoriert)
+         */
+        constexpr uint32_t stepsForMm(float mm) const { return scale(toFx(mm), stepsPerMmFx); }
+
+        /**
+         * @brief Schritt-Einheiten je Rad für eine Drehung auf der Stelle (Vorzeichen wird ignoriert)
+         */
+        constexpr uint32_t stepsForDegrees(float degrees) const { return scale(toFx(degrees), stepsPerDegreeFx); }
+
+        /**
+         * @brief Schrittintervall für eine Bahngeschwindigkeit, auf die Profil-Grenzen begrenzt
+         */
+        constexpr uint32_t intervalUsForSpeed(uint32_t mmPerS) const
+        {
+            uint32_t us = mmPerS ? usPerStepAt1MmS / mmPerS : maxIntervalUs;
+            return us < minIntervalUs ? minIntervalUs : (us > maxIntervalUs ? maxIntervalUs : us);
+        }
+    };
+
+    /**
+     * @brief Kinematik eines Profils als Compile-Zeit-Konstanten
+     */
+    template <const config::StepperProfile &Profile>
+    struct Kinematics
+    {
+        static constexpr KinematicsFactors FACTORS = KinematicsFactors::from(Profile);
+
+        static constexpr uint32_t STEPS_PER_MM_FX = FACTORS.stepsPerMmFx;
+        static constexpr uint32_t STEPS_PER_DEGREE_FX = FACTORS.stepsPerDegreeFx;
+        static constexpr uint32_t MAX_SPEED_MM_S = FACTORS.maxSpeedMmS;
+
+        static_assert(STEPS_PER_MM_FX > 0 && STEPS_PER_DEGREE_FX > 0, "Profil ohne Schritte");
+        static_assert(360ull * STEPS_PER_DEGREE_FX >> KINEMATICS_FX_SHIFT <= UINT16_MAX, "Dreh-Tabelle passt nicht in uint16_t");
+
+        // Schritte je Rad für 0..360 ganze Grad (gleiche Rundung wie stepsForDegrees)
+        static constexpr std::array<uint16_t, 361> TURN_TABLE = []
+        {
+            std::array<uint16_t, 361> table{};
+            for (uint32_t deg = 0; deg <= 360; deg++)
+                table[deg] = static_cast<uint16_t>(KinematicsFactors::scale(deg << KINEMATICS_FX_SHIFT, STEPS_PER_DEGREE_FX));
+            return table;
+        }();
+
+        static constexpr uint32_t stepsForMm(float mm) { return FACTORS.stepsForMm(mm); }
+
+        static constexpr uint32_t stepsForDegrees(float degrees)
+        {
+            float abs = degrees < 0 ? -degrees : degrees;
+            uint32_t whole = static_cast<uint32_t>(abs);
+            if (abs <= 360.0f && static_cast<float>(whole) == abs)
+                return TURN_TABLE[whole];
+            return FACTORS.stepsForDegrees(abs);
+        }
+
+        static constexpr uint32_t intervalUsForSpeed(uint32_t mmPerS) { return FACTORS.intervalUsForSpeed(mmPerS); }
+        static constexpr uint16_t minStepDelayUs() { return FACTORS.minStepDelayUs; }
+        static constexpr uint16_t maxStepDelayUs() { return FACTORS.maxStepDelayUs; }
+    };
+
+    /**
+     * @brief Zur Laufzeit kalibrierte Kinematik (gleiche Schnittstelle wie Kinematics<>)
+     *
+     * Bis zum ersten calibrateKinematics() gelten die Faktoren von config::PROFILE.
+     */
+    struct CalibratedKinematics
+    {
+        static const KinematicsFactors &factors();
+
+        static uint32_t stepsForMm(float mm) { return factors().stepsForMm(mm); }
+        static uint32_t stepsForDegrees(float degrees) { return factors().stepsForDegrees(degrees); }
+        static uint32_t intervalUsForSpeed(uint32_t mmPerS) { return factors().intervalUsForSpeed(mmPerS); }
+        static uint16_t minStepDelayUs() { return factors().minStepDelayUs; }
+        static uint16_t maxStepDelayUs() { return factors().maxStepDelayUs; }
+    };
+
+    /**
+     * @brief Vermessene Rad-Geometrie übernehmen (einmal beim Start, nicht während einer Bewegung)
+     * @param wheelDiameterMm Gemessener Raddurchmesser
+     * @param wheelDistanceMm Gemessene Spurweite (Radmitte zu Radmitte)
+     */
+    void calibrateKinematics(float wheelDiameterMm, float wheelDistanceMm);
+
+    /**
+     * @brief Kinematik für motion/ (Compile-Zeit-Profil oder kalibriert)
+     */
+    using ActiveKinematics = std::conditional_t<TT_KINEMATICS_RUNTIME != 0, CalibratedKinematics,
+                                                Kinematics<config::PROFILE>>;
+
+} // namespace tiny_turtle
@@ -0,0 +1,131 @@
+#pragma once
+/**
+ * @file core/mailbox.h
+ * @brief Lock-freie Mailbox (bounded MPSC-Queue) für Zustandsmeldungen
+ *
+ * Mehrere Produzenten (Tasks, esp_timer-Callbacks, ISRs) legen Nachrichten ab,
+ * genau ein Konsument holt sie wieder heraus. Weder post() noch fetch()
+ * blockieren jemals - ist die Mailbox voll, wird die Nachricht verworfen.
+ *
+ * Implementierung nach D. Vyukov (Sequenznummer pro Zelle), benötigt nur
+ * 32-Bit-Atomics (auf dem ESP32-C6 lock-free über die RISC-V A-Extension).
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tiny_turtle
+{
+
+    template <typename T, size_t N>
+    class Mailbox
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "Mailbox-Größe muss eine Zweierpotenz sein");
+
+    public:
+        Mailbox()
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                cells_[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+            }
+        }
+
+        Mailbox(const Mailbox &) = delete;
+        Mailbox &operator=(const Mailbox &) = delete;
+
+        /**
+         * @brief Nachricht ablegen (ISR-safe, blockiert nie)
+         * @return false wenn die Mailbox voll ist (Nachricht verworfen)
+         */
+        bool post(const T &msg)
+        {
+            uint32_t pos = head_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells_[pos & (N - 1)];
+                uint32_t seq = cell.seq.load(std::memory_order_acquire);
+                int32_t diff = static_cast<int32_t>(seq - pos);
+
+                if (diff == 0)
+                {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.data = msg;
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Voll
+                }
+                else
+                {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Nächste Nachricht abholen (nur vom Konsumenten aufrufen)
+         * @return false wenn keine (vollständig geschriebene) Nachricht vorliegt
+         */
+        bool fetch(T &out)
+        {
+            uint32_t pos = tail_.load(std::memory_order_relaxed);
+            Cell &cell = cells_[pos & (N - 1)];
+            uint32_t seq = cell.seq.load(std::memory_order_acquire);
+
+            if (static_cast<int32_t>(seq - (pos + 1)) < 0)
+            {
+                return false; // Leer (oder Produzent schreibt gerade)
+            }
+
+            out = cell.data;
+            cell.seq.store(pos + N, std::memory_order_release);
+            tail_.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Mailbox leer? (Momentaufnahme)
+         */
+        bool empty() const
+        {
+            return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Anzahl wartender Nachrichten (Momentaufnahme)
+         */
+        size_t size() const
+        {
+            return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Laufende Nummer der nächsten abzulegenden bzw. abzuholenden Nachricht
+         *
+         * Mit einem Vergleich per vorzeichenbehafteter Differenz kann der
+         * Konsument alles verwerfen, was bis zu einem Zeitpunkt abgelegt war.
+         */
+        uint32_t postCount() const { return head_.load(std::memory_order_acquire); }
+        uint32_t fetchCount() const { return tail_.load(std::memory_order_relaxed); }
+
+        static constexpr size_t capacity() { return N; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<uint32_t> seq;
+            T data;
+        };
+
+        Cell cells_[N];
+        std::atomic<uint32_t> head_{0}; // Schreibposition (Produzenten)
+        std::atomic<uint32_t> tail_{0}; // Leseposition (Konsument)
+    };
+
+} // namespace tiny_turtle
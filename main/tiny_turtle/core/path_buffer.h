@@ -0,0 +1,128 @@
+#pragma once
+/**
+ * @file core/path_buffer.h
+ * @brief Pfade als getrennte x/y/Flag-Arrays (Structure of Arrays) in einer BumpArena
+ *
+ * Statt Point2D-Paaren (AoS) oder verschränkter uint8_t-Koordinaten liegen
+ * X, Y und Flags jeweils zusammenhängend im Speicher. Die Kernel aus
+ * core/path_kernels.h laufen damit als einfache Schleifen über ein Array:
+ * auf dem Host vektorisiert der Compiler sie, auf dem Gerät (ESP32-C6 ohne
+ * FPU) rechnen sie in Ganzzahlen.
+ *
+ * Der Koordinatentyp ist ein Template-Parameter:
+ *   float    Millimeter (Host-Werkzeuge)
+ *   int32_t  1/PATH_FIXED_SCALE mm (Gerät)
+ * PathBuffer ist der Standard der jeweiligen Plattform.
+ *
+ *   BumpArena arena(memory, sizeof(memory));
+ *   PathBuffer path(arena, 64);
+ *   path.push(toPathCoord(10.0f), toPathCoord(0.0f), PATH_PEN_DOWN);
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "arena.h"
+
+namespace tiny_turtle
+{
+    // Festkomma-Koordinaten: Einheiten pro mm (int32: ±21 km Wertebereich)
+    constexpr int32_t PATH_FIXED_SCALE = 100;
+
+    // Flags je Punkt (gelten für das Segment vom Vorgänger zu diesem Punkt)
+    constexpr uint8_t PATH_PEN_DOWN = 0x01; // Mit Stift unten fahren
+    constexpr uint8_t PATH_STROKE_START = 0x02; // Beginn einer neuen Linie (Leerfahrt hierher)
+
+    template <class Coord>
+    class BasicPathBuffer
+    {
+    public:
+        using CoordType = Coord;
+
+        /**
+         * @brief Platz für capacity Punkte aus der Arena holen
+         *
+         * Reicht die Arena nicht, bleibt capacity() bei 0 und push() schlägt fehl.
+         */
+        BasicPathBuffer(BumpArena &arena, size_t capacity)
+        {
+            size_t mark = arena.mark();
+            x_ = arena.allocate<Coord>(capacity);
+            y_ = arena.allocate<Coord>(capacity);
+            flags_ = arena.allocate<uint8_t>(capacity);
+            if (x_ && y_ && flags_)
+                capacity_ = capacity;
+            else
+                arena.rewind(mark);
+        }
+
+        /**
+         * @brief Punkt anhängen
+         * @return false wenn der Puffer voll ist
+         */
+        bool push(Coord x, Coord y, uint8_t flags = PATH_PEN_DOWN)
+        {
+            if (size_ >= capacity_)
+                return false;
+            x_[size_] = x;
+            y_[size_] = y;
+            flags_[size_] = flags;
+            size_++;
+            return true;
+        }
+
+        void clear() { size_ = 0; }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        Coord *x() { return x_; }
+        Coord *y() { return y_; }
+        uint8_t *flags() { return flags_; }
+        const Coord *x() const { return x_; }
+        const Coord *y() const { return y_; }
+        const uint8_t *flags() const { return flags_; }
+
+    private:
+        Coord *x_ = nullptr;
+        Coord *y_ = nullptr;
+        uint8_t *flags_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+    };
+
+    using PathBufferF = BasicPathBuffer<float>;
+    using PathBufferQ = BasicPathBuffer<int32_t>;
+
+#ifdef ESP_PLATFORM
+    using PathBuffer = PathBufferQ;
+#else
+    using PathBuffer = PathBufferF;
+#endif
+    using PathCoord = PathBuffer::CoordType;
+
+    /**
+     * @brief Millimeter in den Koordinatentyp eines Puffers
+     */
+    template <class Coord = PathCoord>
+    inline Coord toPathCoord(float mm)
+    {
+        if constexpr (std::is_integral_v<Coord>)
+            return static_cast<Coord>(mm * PATH_FIXED_SCALE + (mm >= 0 ? 0.5f : -0.5f));
+        else
+            return static_cast<Coord>(mm);
+    }
+
+    template <class Coord>
+    inline float pathCoordToMm(Coord value)
+    {
+        if constexpr (std::is_integral_v<Coord>)
+            return static_cast<float>(value) / PATH_FIXED_SCALE;
+        else
+            return static_cast<float>(value);
+    }
+
+} // namespace tiny_turtle
@@ -0,0 +1,301 @@
+#pragma once
+/**
+ * @file core/path_kernels.h
+ * @brief Stapel-Kernel für PathBuffer: Transformation, Grenzen, Längen, Winkel
+ *
+ * Jeder Kernel ist eine Schleife über die x/y-Arrays ohne Aufrufe oder
+ * Verzweigungen im Rumpf. Zwei Fassungen:
+ *
+ * - float (PathBufferF, Host): der Compiler vektorisiert die Schleifen.
+ *   Winkel kommen aus einem Polynom statt std::atan2 (Fehler < 0.001°).
+ *   Dafür mit -fno-math-errno (sqrt) und -fno-trapping-math (Auswahl per
+ *   Vergleich) übersetzen, sonst bleiben Längen und Winkel skalar.
+ * - int32_t (PathBufferQ, Gerät): Festkomma in 1/PATH_FIXED_SCALE mm,
+ *   Koeffizienten in Q24 (Skalierung unter 128), Winkel in 1/100 Grad -
+ *   ohne Soft-Float auf dem ESP32-C6.
+ *
+ * Winkel folgen der Heading-Konvention von motion::goTo(): 0° = +Y, 90° = +X.
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "path_buffer.h"
+
+namespace tiny_turtle
+{
+    /**
+     * @brief Affine Abbildung in mm: x' = a x + b y + tx, y' = c x + d y + ty
+     */
+    struct PathTransform
+    {
+        float a, b, c, d;
+        float tx, ty;
+
+        static PathTransform identity() { return {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}; }
+
+        /**
+         * @brief Skalieren, gegen den Uhrzeigersinn drehen, verschieben (in dieser Reihenfolge)
+         */
+        static PathTransform make(float scale, float rotationDeg, float txMm, float tyMm)
+        {
+            float rad = rotationDeg * static_cast<float>(M_PI) / 180.0f;
+            float cs = std::cos(rad) * scale;
+            float sn = std::sin(rad) * scale;
+            return {cs, -sn, sn, cs, txMm, tyMm};
+        }
+    };
+
+    template <class Coord>
+    struct PathBounds
+    {
+        Coord minX, minY, maxX, maxY;
+    };
+
+    namespace path_detail
+    {
+        // atan(t) für t in [0, 1], Bogenmaß
+        inline float atanUnit(float t)
+        {
+            float t2 = t * t;
+            return t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+        }
+
+        // Heading-Winkel atan2(dx, dy) in Grad, ohne Verzweigung
+        inline float headingDeg(float dx, float dy)
+        {
+            float ax = std::fabs(dx);
+            float ay = std::fabs(dy);
+            float mx = ax > ay ? ax : ay;
+            float mn = ax > ay ? ay : ax;
+            float t = mn / (mx > 1e-30f ? mx : 1e-30f); // 0/0 vermeiden
+            float r = atanUnit(t);
+            r = ax > ay ? 1.57079633f - r : r;
+            r = dy < 0.0f ? 3.14159265f - r : r;
+            return std::copysign(r, dx) * 57.2957795f;
+        }
+
+        // Gleiches Polynom in Q15 (t, Ergebnis in Bogenmaß)
+        inline int32_t atanUnitQ15(int32_t t)
+        {
+            int32_t t2 = (t * t) >> 15;
+            int32_t acc = -384;                   // -0.01172120
+            acc = 1725 + ((acc * t2) >> 15);      //  0.05265332
+            acc = -3815 + ((acc * t2) >> 15);     // -0.11643287
+            acc = 6342 + ((acc * t2) >> 15);      //  0.19354346
+            acc = -10899 + ((acc * t2) >> 15);    // -0.33262347
+            acc = 32767 + ((acc * t2) >> 15);     //  0.99997726
+            return (acc * t) >> 15;
+        }
+
+        // Heading-Winkel atan2(dx, dy) in 1/100 Grad
+        inline int32_t headingCentiDeg(int32_t dx, int32_t dy)
+        {
+            uint32_t ax = static_cast<uint32_t>(dx < 0 ? -static_cast<int64_t>(dx) : dx);
+            uint32_t ay = static_cast<uint32_t>(dy < 0 ? -static_cast<int64_t>(dy) : dy);
+            uint32_t mx = ax > ay ? ax : ay;
+            uint32_t mn = ax > ay ? ay : ax;
+            int32_t t = mx ? static_cast<int32_t>((static_cast<uint64_t>(mn) << 15) / mx) : 0;
+            int32_t r = (atanUnitQ15(t) * 11459 + 32768) >> 16; // Bogenmaß Q15 -> 1/100 Grad
+            r = ax > ay ? 9000 - r : r;
+            r = dy < 0 ? 18000 - r : r;
+            return dx < 0 ? -r : r;
+        }
+
+        inline uint32_t isqrt64(uint64_t v)
+        {
+            uint64_t r = 0;
+            uint64_t bit = 1ull << 62;
+            while (bit > v)
+                bit >>= 2;
+            while (bit)
+            {
+                if (v >= r + bit)
+                {
+                    v -= r + bit;
+                    r = (r >> 1) + bit;
+                }
+                else
+                    r >>= 1;
+                bit >>= 2;
+            }
+            return static_cast<uint32_t>(r);
+        }
+
+        inline int32_t toQ24(float v)
+        {
+            return static_cast<int32_t>(v * 16777216.0f + (v >= 0 ? 0.5f : -0.5f));
+        }
+    } // namespace path_detail
+
+    // ----------------------------------------------------------------------
+    // Transformation
+    // ----------------------------------------------------------------------
+
+    inline void transformPath(PathBufferF &path, const PathTransform &t)
+    {
+        float *__restrict xs = path.x();
+        float *__restrict ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            float x = xs[i];
+            float y = ys[i];
+            xs[i] = t.a * x + t.b * y + t.tx;
+            ys[i] = t.c * x + t.d * y + t.ty;
+        }
+    }
+
+    inline void transformPath(PathBufferQ &path, const PathTransform &t)
+    {
+        using path_detail::toQ24;
+        const int64_t a = toQ24(t.a), b = toQ24(t.b), c = toQ24(t.c), d = toQ24(t.d);
+        const int32_t tx = toPathCoord<int32_t>(t.tx);
+        const int32_t ty = toPathCoord<int32_t>(t.ty);
+
+        int32_t *__restrict xs = path.x();
+        int32_t *__restrict ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            int64_t x = xs[i];
+            int64_t y = ys[i];
+            xs[i] = static_cast<int32_t>((a * x + b * y + 0x800000) >> 24) + tx;
+            ys[i] = static_cast<int32_t>((c * x + d * y + 0x800000) >> 24) + ty;
+        }
+    }
+
+    // ----------------------------------------------------------------------
+    // Grenzen
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Umschließendes Rechteck aller Punkte (leerer Puffer: alles 0)
+     */
+    template <class Coord>
+    PathBounds<Coord> pathBounds(const BasicPathBuffer<Coord> &path)
+    {
+        const size_t n = path.size();
+        if (n == 0)
+            return {0, 0, 0, 0};
+
+        const Coord *xs = path.x();
+        const Coord *ys = path.y();
+        Coord minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+        for (size_t i = 1; i < n; i++)
+        {
+            minX = xs[i] < minX ? xs[i] : minX;
+            maxX = xs[i] > maxX ? xs[i] : maxX;
+            minY = ys[i] < minY ? ys[i] : minY;
+            maxY = ys[i] > maxY ? ys[i] : maxY;
+        }
+        return {minX, minY, maxX, maxY};
+    }
+
+    // ----------------------------------------------------------------------
+    // Längen
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Länge jedes Segments i -> i+1 in mm (size() - 1 Werte)
+     */
+    inline void segmentLengths(const PathBufferF &path, float *__restrict out)
+    {
+        const float *xs = path.x();
+        const float *ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            float dx = xs[i + 1] - xs[i];
+            float dy = ys[i + 1] - ys[i];
+            out[i] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    /**
+     * @brief Länge jedes Segments i -> i+1 in 1/PATH_FIXED_SCALE mm (size() - 1 Werte)
+     */
+    inline void segmentLengths(const PathBufferQ &path, int32_t *__restrict out)
+    {
+        const int32_t *xs = path.x();
+        const int32_t *ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            int64_t dx = static_cast<int64_t>(xs[i + 1]) - xs[i];
+            int64_t dy = static_cast<int64_t>(ys[i + 1]) - ys[i];
+            out[i] = static_cast<int32_t>(path_detail::isqrt64(static_cast<uint64_t>(dx * dx + dy * dy)));
+        }
+    }
+
+    /**
+     * @brief Gesamtlänge in mm
+     * @param drawnOnly Nur Segmente mit PATH_PEN_DOWN am Zielpunkt
+     */
+    inline float pathLength(const PathBufferF &path, bool drawnOnly = false)
+    {
+        const float *xs = path.x();
+        const float *ys = path.y();
+        const uint8_t *flags = path.flags();
+        const uint8_t mask = drawnOnly ? PATH_PEN_DOWN : 0;
+        const size_t n = path.size();
+        float sum = 0.0f;
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            float dx = xs[i + 1] - xs[i];
+            float dy = ys[i + 1] - ys[i];
+            float len = std::sqrt(dx * dx + dy * dy);
+            sum += (flags[i + 1] & mask) == mask ? len : 0.0f;
+        }
+        return sum;
+    }
+
+    inline float pathLength(const PathBufferQ &path, bool drawnOnly = false)
+    {
+        const int32_t *xs = path.x();
+        const int32_t *ys = path.y();
+        const uint8_t *flags = path.flags();
+        const uint8_t mask = drawnOnly ? PATH_PEN_DOWN : 0;
+        const size_t n = path.size();
+        uint64_t sum = 0;
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            int64_t dx = static_cast<int64_t>(xs[i + 1]) - xs[i];
+            int64_t dy = static_cast<int64_t>(ys[i + 1]) - ys[i];
+            if ((flags[i + 1] & mask) == mask)
+                sum += path_detail::isqrt64(static_cast<uint64_t>(dx * dx + dy * dy));
+        }
+        return static_cast<float>(sum) / PATH_FIXED_SCALE;
+    }
+
+    // ----------------------------------------------------------------------
+    // Winkel
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Heading jedes Segments i -> i+1 in Grad (size() - 1 Werte)
+     */
+    inline void segmentAngles(const PathBufferF &path, float *__restrict out)
+    {
+        const float *xs = path.x();
+        const float *ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i + 1 < n; i++)
+            out[i] = path_detail::headingDeg(xs[i + 1] - xs[i], ys[i + 1] - ys[i]);
+    }
+
+    /**
+     * @brief Heading jedes Segments i -> i+1 in 1/100 Grad (size() - 1 Werte)
+     */
+    inline void segmentAngles(const PathBufferQ &path, int32_t *__restrict out)
+    {
+        const int32_t *xs = path.x();
+        const int32_t *ys = path.y();
+        const size_t n = path.size();
+        for (size_t i = 0; i + 1 < n; i++)
+            out[i] = path_detail::headingCentiDeg(xs[i + 1] - xs[i], ys[i + 1] - ys[i]);
+    }
+
+} // namespace tiny_turtle
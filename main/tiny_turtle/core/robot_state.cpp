@@ -0,0 +1,96 @@
+/**
+ * @file core/robot_state.cpp
+ * @brief Implementierung des Seqlock-geschützten Roboter-Zustands
+ */
+
+#include "robot_state.h"
+#include "config.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+
+namespace tiny_turtle
+{
+    // Serialisiert Task-Schreiber untereinander und gegen die ISR
+    // (gemeinsam für alle Instanzen, die Abschnitte sind nur wenige Takte lang)
+    static portMUX_TYPE s_state_mux = portMUX_INITIALIZER_UNLOCKED;
+
+    RobotState::RobotState()
+        : lock_(RobotSnapshot{0, 0, 0.0f, 0.0f, 0.0f, config::DEFAULT_STEP_DELAY_US,
+                              MotorCommand::STOP, PenState::UP, false})
+    {
+    }
+
+    template <typename Fn>
+    void RobotState::writeFromTask(Fn &&fn)
+    {
+        portENTER_CRITICAL(&s_state_mux);
+        lock_.write(fn);
+        portEXIT_CRITICAL(&s_state_mux);
+    }
+
+    void IRAM_ATTR RobotState::stepFromISR(int dir1, int dir2, uint32_t intervalUs, MotorCommand cmd)
+    {
+        portENTER_CRITICAL_ISR(&s_state_mux);
+        lock_.write([&](RobotSnapshot &s) __attribute__((always_inline))
+                    {
+                        s.steps1 += dir1;
+                        s.steps2 += dir2;
+                        s.stepIntervalUs = intervalUs;
+                        s.command = cmd;
+                    });
+        portEXIT_CRITICAL_ISR(&s_state_mux);
+    }
+
+    void RobotState::addSteps(int dir1, int dir2)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      {
+                          s.steps1 += dir1;
+                          s.steps2 += dir2;
+                      });
+    }
+
+    void RobotState::setPose(float x, float y, float heading)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      {
+                          s.x = x;
+                          s.y = y;
+                          s.heading = heading;
+                      });
+    }
+
+    void RobotState::setPen(PenState pen)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      { s.pen = pen; });
+    }
+
+    void RobotState::setCommand(MotorCommand cmd)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      { s.command = cmd; });
+    }
+
+    void RobotState::setStepInterval(uint32_t intervalUs)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      { s.stepIntervalUs = intervalUs; });
+    }
+
+    void RobotState::setTimerRunning(bool running)
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      { s.timerRunning = running; });
+    }
+
+    void RobotState::resetSteps()
+    {
+        writeFromTask([&](RobotSnapshot &s)
+                      {
+                          s.steps1 = 0;
+                          s.steps2 = 0;
+                      });
+    }
+
+} // namespace tiny_turtle
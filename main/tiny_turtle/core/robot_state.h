@@ -0,0 +1,78 @@
+#pragma once
+/**
+ * @file core/robot_state.h
+ * @brief Gemeinsamer, Seqlock-geschützter Roboter-Zustand
+ *
+ * Stepper-ISR und Motion-Layer schreiben hier hinein, jeder Task kann
+ * jederzeit einen konsistenten Schnappschuss lesen (ohne Interrupts zu
+ * sperren). Grundlage für Telemetrie und Monitoring.
+ */
+
+#include <cstdint>
+#include "types.h"
+#include "seqlock.h"
+
+namespace tiny_turtle
+{
+
+    /**
+     * @brief Konsistenter Schnappschuss des Roboter-Zustands
+     */
+    struct RobotSnapshot
+    {
+        int32_t steps1;          // Kumulierte Schritte Motor 1 (vorzeichenbehaftet)
+        int32_t steps2;          // Kumulierte Schritte Motor 2
+        float x;                 // Position in mm
+        float y;
+        float heading;           // Ausrichtung in Grad
+        uint32_t stepIntervalUs; // Aktuelles Schrittintervall
+        MotorCommand command;    // Aktueller Motor-Befehl
+        PenState pen;            // Stift-Zustand
+        bool timerRunning;       // GPTimer läuft
+    };
+
+    class RobotState
+    {
+    public:
+        RobotState();
+
+        /**
+         * @brief Konsistenten Schnappschuss lesen (aus jedem Task)
+         */
+        RobotSnapshot snapshot() const { return lock_.read(); }
+
+        /**
+         * @brief Generationszähler - ändert sich bei jeder Aktualisierung
+         */
+        uint32_t generation() const { return lock_.generation(); }
+
+        //-----------------------------------------------------------------------
+        // Schreibzugriffe aus der Stepper-ISR
+        //-----------------------------------------------------------------------
+
+        /**
+         * @brief Schritt(e), aktuelles Intervall und Befehl verbuchen
+         * @note Nur aus der ISR aufrufen
+         */
+        void stepFromISR(int dir1, int dir2, uint32_t intervalUs, MotorCommand cmd);
+
+        //-----------------------------------------------------------------------
+        // Schreibzugriffe aus Tasks (kurze Critical Section gegen die ISR)
+        //-----------------------------------------------------------------------
+
+        void addSteps(int dir1, int dir2);
+        void setPose(float x, float y, float heading);
+        void setPen(PenState pen);
+        void setCommand(MotorCommand cmd);
+        void setStepInterval(uint32_t intervalUs);
+        void setTimerRunning(bool running);
+        void resetSteps();
+
+    private:
+        template <typename Fn>
+        void writeFromTask(Fn &&fn);
+
+        SeqLock<RobotSnapshot> lock_;
+    };
+
+} // namespace tiny_turtle
@@ -0,0 +1,90 @@
+#pragma once
+/**
+ * @file core/seqlock.h
+ * @brief Sequenz-Lock für konsistente, lock-freie Lesezugriffe
+ *
+ * Ein Schreiber erhöht vor und nach der Änderung einen Zähler (ungerade =
+ * Schreibvorgang läuft). Leser kopieren die Daten und wiederholen, falls sich
+ * der Zähler dabei geändert hat. Leser blockieren den Schreiber nie und
+ * müssen keine Interrupts sperren.
+ *
+ * Voraussetzung: Schreibzugriffe sind untereinander exklusiv (z.B. nur aus
+ * einer ISR bzw. aus Tasks innerhalb einer Critical Section).
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "isr_attr.h"
+
+namespace tiny_turtle
+{
+
+    template <typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock benötigt trivial kopierbare Daten");
+
+    public:
+        SeqLock() : data_{} {}
+        explicit SeqLock(const T &initial) : data_(initial) {}
+
+        /**
+         * @brief Daten ändern (Aufrufer garantiert exklusiven Schreibzugriff)
+         * @param fn Funktor, der eine Referenz auf die Daten erhält
+         */
+        template <typename Fn>
+        TT_ISR_INLINE void write(Fn &&fn)
+        {
+            uint32_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            fn(data_);
+
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Konsistente Kopie der Daten lesen (wiederholt bei Kollision)
+         */
+        T read() const
+        {
+            T copy;
+            uint32_t before;
+            uint32_t after;
+            do
+            {
+                before = seq_.load(std::memory_order_acquire);
+                copy = data_;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = seq_.load(std::memory_order_relaxed);
+            } while ((before & 1) || before != after);
+            return copy;
+        }
+
+        /**
+         * @brief Einmaliger Leseversuch (z.B. aus einer ISR, die nicht warten darf)
+         * @return false wenn gerade geschrieben wird
+         */
+        bool tryRead(T &out) const
+        {
+            uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1)
+                return false;
+            out = data_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return seq_.load(std::memory_order_relaxed) == before;
+        }
+
+        /**
+         * @brief Generationszähler (ändert sich bei jedem Schreibvorgang um 2)
+         */
+        uint32_t generation() const { return seq_.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<uint32_t> seq_{0};
+        T data_;
+    };
+
+} // namespace tiny_turtle
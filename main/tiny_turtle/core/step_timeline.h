@@ -0,0 +1,195 @@
+#pragma once
+/**
+ * @file core/step_timeline.h
+ * @brief Binäres Format vorberechneter Schritt-Abfolgen (Host-Compiler und Gerät)
+ *
+ * host/job_compiler plant einen Zeichenauftrag komplett auf dem PC (Text,
+ * Pfade, Reihenfolge, Rampen) und schreibt das Ergebnis als Folge von
+ * Datensätzen. motion::playTimeline() spielt sie ab, ohne zu rechnen.
+ *
+ * Kopf (16 Bytes, Little-Endian):
+ *
+ * | Offset | Typ | Inhalt                                          |
+ * |--------|-----|-------------------------------------------------|
+ * | 0      | u32 | TIMELINE_MAGIC ("TTL1")                         |
+ * | 4      | u16 | TIMELINE_VERSION                                |
+ * | 6      | u16 | reserviert (0)                                  |
+ * | 8      | u32 | Anzahl Datensätze                               |
+ * | 12     | u32 | stepsPerMmFx des Profils, für das geplant wurde |
+ *
+ * Datensatz (8 Bytes):
+ *
+ * | Offset | Typ | Inhalt                                          |
+ * |--------|-----|-------------------------------------------------|
+ * | 0      | u8  | TimelineOp                                      |
+ * | 1      | u8  | Richtungen (BURST): Bit0-1 Motor 1, Bit2-3 Motor 2 |
+ * | 2      | u16 | count                                           |
+ * | 4      | u16 | intervalUs                                      |
+ * | 6      | i16 | deltaUs                                         |
+ *
+ * Ein BURST steht für count Schritte mit linear veränderter Pause: nach
+ * Schritt k (ab 0) folgen intervalUs + k * deltaUs µs. Rampen und konstante
+ * Fahrt kosten so je einen Datensatz, egal wie lang sie sind.
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "context.h"
+
+namespace tiny_turtle
+{
+    namespace timeline
+    {
+        constexpr uint32_t TIMELINE_MAGIC = 0x314C5454; // "TTL1"
+        constexpr uint16_t TIMELINE_VERSION = 1;
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t RECORD_SIZE = 8;
+
+        enum class TimelineOp : uint8_t
+        {
+            END,       // Ende der Abfolge
+            BURST,     // count Schritte, siehe oben
+            STOP,      // Spulen stromlos
+            PEN_UP,
+            PEN_DOWN,
+            SETTLE,    // Auf das Servo warten (nach einem Stift-Wechsel, vor der nächsten Fahrt)
+            SEGMENT,   // Ende einer Fahrt/Drehung: count = Schritte
+            POSE,      // count = X, intervalUs = Y (je int16 in 0.1 mm), deltaUs = Heading in 0.01°
+            DELAY,     // Pause ohne Schritt: (count << 16) | intervalUs µs
+            COUNT
+        };
+
+        // Richtungs-Codes im Feld "Richtungen"
+        constexpr uint8_t DIR_NONE = 0;
+        constexpr uint8_t DIR_FORWARD = 1;
+        constexpr uint8_t DIR_BACKWARD = 2;
+
+        struct TimelineRecord
+        {
+            TimelineOp op;
+            uint8_t dirs;
+            uint16_t count;
+            uint16_t intervalUs;
+            int16_t deltaUs;
+        };
+
+        struct TimelineHeader
+        {
+            uint32_t recordCount;
+            uint32_t stepsPerMmFx;
+        };
+
+        namespace detail
+        {
+            inline void put16(uint8_t *p, uint16_t v)
+            {
+                p[0] = static_cast<uint8_t>(v);
+                p[1] = static_cast<uint8_t>(v >> 8);
+            }
+
+            inline void put32(uint8_t *p, uint32_t v)
+            {
+                put16(p, static_cast<uint16_t>(v));
+                put16(p + 2, static_cast<uint16_t>(v >> 16));
+            }
+
+            inline uint16_t get16(const uint8_t *p)
+            {
+                return static_cast<uint16_t>(p[0] | (p[1] << 8));
+            }
+
+            inline uint32_t get32(const uint8_t *p)
+            {
+                return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+            }
+
+            inline int16_t toFixed(float value, float scale)
+            {
+                float v = value * scale;
+                if (v > 32767.0f)
+                    v = 32767.0f;
+                if (v < -32768.0f)
+                    v = -32768.0f;
+                return static_cast<int16_t>(v >= 0 ? v + 0.5f : v - 0.5f);
+            }
+        } // namespace detail
+
+        /**
+         * @brief Richtung (-1, 0, +1) in einen 2-Bit-Code
+         */
+        inline uint8_t encodeDir(int direction)
+        {
+            return direction > 0 ? DIR_FORWARD : (direction < 0 ? DIR_BACKWARD : DIR_NONE);
+        }
+
+        inline int decodeDir(uint8_t code)
+        {
+            return code == DIR_FORWARD ? 1 : (code == DIR_BACKWARD ? -1 : 0);
+        }
+
+        inline uint8_t packDirs(int dir1, int dir2)
+        {
+            return static_cast<uint8_t>(encodeDir(dir1) | (encodeDir(dir2) << 2));
+        }
+
+        inline void packHeader(const TimelineHeader &h, uint8_t *raw)
+        {
+            detail::put32(raw, TIMELINE_MAGIC);
+            detail::put16(raw + 4, TIMELINE_VERSION);
+            detail::put16(raw + 6, 0);
+            detail::put32(raw + 8, h.recordCount);
+            detail::put32(raw + 12, h.stepsPerMmFx);
+        }
+
+        /**
+         * @brief Kopf prüfen und lesen
+         * @return false bei falscher Kennung/Version oder wenn size nicht zur Anzahl Datensätze passt
+         */
+        inline bool unpackHeader(const uint8_t *raw, size_t size, TimelineHeader &h)
+        {
+            if (size < HEADER_SIZE || detail::get32(raw) != TIMELINE_MAGIC || detail::get16(raw + 4) != TIMELINE_VERSION)
+                return false;
+            h.recordCount = detail::get32(raw + 8);
+            h.stepsPerMmFx = detail::get32(raw + 12);
+            return h.recordCount <= (size - HEADER_SIZE) / RECORD_SIZE;
+        }
+
+        inline void packRecord(const TimelineRecord &r, uint8_t *raw)
+        {
+            raw[0] = static_cast<uint8_t>(r.op);
+            raw[1] = r.dirs;
+            detail::put16(raw + 2, r.count);
+            detail::put16(raw + 4, r.intervalUs);
+            detail::put16(raw + 6, static_cast<uint16_t>(r.deltaUs));
+        }
+
+        inline TimelineRecord unpackRecord(const uint8_t *raw)
+        {
+            return {static_cast<TimelineOp>(raw[0]), raw[1], detail::get16(raw + 2), detail::get16(raw + 4),
+                    static_cast<int16_t>(detail::get16(raw + 6))};
+        }
+
+        /**
+         * @brief Pose als POSE-Datensatz
+         */
+        inline TimelineRecord poseRecord(const Pose &pose)
+        {
+            float heading = pose.heading;
+            while (heading > 180.0f)
+                heading -= 360.0f;
+            while (heading < -180.0f)
+                heading += 360.0f;
+            return {TimelineOp::POSE, 0, static_cast<uint16_t>(detail::toFixed(pose.x, 10.0f)),
+                    static_cast<uint16_t>(detail::toFixed(pose.y, 10.0f)), detail::toFixed(heading, 100.0f)};
+        }
+
+        inline Pose recordPose(const TimelineRecord &r)
+        {
+            return {static_cast<int16_t>(r.count) / 10.0f, static_cast<int16_t>(r.intervalUs) / 10.0f,
+                    r.deltaUs / 100.0f};
+        }
+
+    } // namespace timeline
+} // namespace tiny_turtle
@@ -0,0 +1,170 @@
+#pragma once
+/**
+ * @file core/telemetry_frame.h
+ * @brief Binäres Telemetrie-Frame-Format (Gerät und Host-Decoder)
+ *
+ * Aufbau (Little-Endian, vor COBS):
+ *
+ * | Offset | Typ  | Inhalt                                        |
+ * |--------|------|-----------------------------------------------|
+ * | 0      | u8   | Frame-Typ (FRAME_TYPE_SAMPLE)                 |
+ * | 1      | u16  | Sequenznummer                                 |
+ * | 3      | u32  | Zeitstempel in µs                             |
+ * | 7      | i32  | Schritte Motor 1                              |
+ * | 11     | i32  | Schritte Motor 2                              |
+ * | 15     | i16  | X in 0.1 mm                                   |
+ * | 17     | i16  | Y in 0.1 mm                                   |
+ * | 19     | i16  | Ausrichtung in 0.01°                          |
+ * | 21     | u16  | Schrittintervall in µs                        |
+ * | 23     | u8   | Flags: Bit0 Stift, Bit1 Timer, Bit2-4 Befehl  |
+ * | 24     | u8   | Warteschlange: Stepper-Segmente (0-2)         |
+ * | 25     | u8   | CRC-8 über Byte 0-24                          |
+ *
+ * Auf der Leitung: 0x00, COBS(Frame), 0x00. Der führende Trenner beendet
+ * eventuell eingestreuten Log-Text, so dass der nächste Frame intakt bleibt.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "cobs.h"
+#include "types.h"
+
+namespace tiny_turtle
+{
+    namespace telemetry
+    {
+        constexpr uint8_t FRAME_TYPE_SAMPLE = 0x54; // 'T'
+        constexpr size_t FRAME_RAW_SIZE = 26;
+        constexpr size_t FRAME_WIRE_SIZE = cobs::maxEncodedSize(FRAME_RAW_SIZE) + 2;
+
+        /**
+         * @brief Ein Telemetrie-Messpunkt
+         */
+        struct Sample
+        {
+            uint16_t seq;
+            uint32_t timestampUs;
+            int32_t steps1;
+            int32_t steps2;
+            float x;
+            float y;
+            float heading;
+            uint32_t stepIntervalUs;
+            MotorCommand command;
+            PenState pen;
+            bool timerRunning;
+            uint8_t queueDepth; // Laufendes + vorgemerktes Segment der Stepper-ISR
+        };
+
+        namespace detail
+        {
+            inline void put16(uint8_t *p, uint16_t v)
+            {
+                p[0] = static_cast<uint8_t>(v);
+                p[1] = static_cast<uint8_t>(v >> 8);
+            }
+
+            inline void put32(uint8_t *p, uint32_t v)
+            {
+                p[0] = static_cast<uint8_t>(v);
+                p[1] = static_cast<uint8_t>(v >> 8);
+                p[2] = static_cast<uint8_t>(v >> 16);
+                p[3] = static_cast<uint8_t>(v >> 24);
+            }
+
+            inline uint16_t get16(const uint8_t *p)
+            {
+                return static_cast<uint16_t>(p[0] | (p[1] << 8));
+            }
+
+            inline uint32_t get32(const uint8_t *p)
+            {
+                return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                       (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            }
+
+            inline int16_t toFixed(float value, float scale)
+            {
+                float v = value * scale;
+                if (v > 32767.0f)
+                    v = 32767.0f;
+                if (v < -32768.0f)
+                    v = -32768.0f;
+                return static_cast<int16_t>(v >= 0 ? v + 0.5f : v - 0.5f);
+            }
+        } // namespace detail
+
+        /**
+         * @brief Messpunkt in ein Roh-Frame (FRAME_RAW_SIZE Bytes) packen
+         */
+        inline void pack(const Sample &s, uint8_t *raw)
+        {
+            using namespace detail;
+
+            float heading = s.heading;
+            while (heading > 180.0f)
+                heading -= 360.0f;
+            while (heading < -180.0f)
+                heading += 360.0f;
+
+            raw[0] = FRAME_TYPE_SAMPLE;
+            put16(raw + 1, s.seq);
+            put32(raw + 3, s.timestampUs);
+            put32(raw + 7, static_cast<uint32_t>(s.steps1));
+            put32(raw + 11, static_cast<uint32_t>(s.steps2));
+            put16(raw + 15, static_cast<uint16_t>(toFixed(s.x, 10.0f)));
+            put16(raw + 17, static_cast<uint16_t>(toFixed(s.y, 10.0f)));
+            put16(raw + 19, static_cast<uint16_t>(toFixed(heading, 100.0f)));
+            put16(raw + 21, static_cast<uint16_t>(s.stepIntervalUs > 0xFFFF ? 0xFFFF : s.stepIntervalUs));
+            raw[23] = static_cast<uint8_t>((s.pen == PenState::DOWN ? 0x01 : 0) |
+                                           (s.timerRunning ? 0x02 : 0) |
+                                           ((static_cast<uint8_t>(s.command) & 0x07) << 2));
+            raw[24] = s.queueDepth;
+            raw[25] = cobs::crc8(raw, FRAME_RAW_SIZE - 1);
+        }
+
+        /**
+         * @brief Roh-Frame entpacken und prüfen
+         * @return false bei falscher Länge, falschem Typ oder CRC-Fehler
+         */
+        inline bool unpack(const uint8_t *raw, size_t len, Sample &s)
+        {
+            using namespace detail;
+
+            if (len != FRAME_RAW_SIZE || raw[0] != FRAME_TYPE_SAMPLE)
+                return false;
+            if (cobs::crc8(raw, FRAME_RAW_SIZE - 1) != raw[25])
+                return false;
+
+            s.seq = get16(raw + 1);
+            s.timestampUs = get32(raw + 3);
+            s.steps1 = static_cast<int32_t>(get32(raw + 7));
+            s.steps2 = static_cast<int32_t>(get32(raw + 11));
+            s.x = static_cast<int16_t>(get16(raw + 15)) / 10.0f;
+            s.y = static_cast<int16_t>(get16(raw + 17)) / 10.0f;
+            s.heading = static_cast<int16_t>(get16(raw + 19)) / 100.0f;
+            s.stepIntervalUs = get16(raw + 21);
+            s.pen = (raw[23] & 0x01) ? PenState::DOWN : PenState::UP;
+            s.timerRunning = (raw[23] & 0x02) != 0;
+            s.command = static_cast<MotorCommand>((raw[23] >> 2) & 0x07);
+            s.queueDepth = raw[24];
+            return true;
+        }
+
+        /**
+         * @brief Messpunkt als fertiges Leitungs-Frame kodieren (0x00 + COBS + 0x00)
+         * @param wire Puffer mit mindestens FRAME_WIRE_SIZE Bytes
+         * @return Anzahl Bytes inklusive Trenner
+         */
+        inline size_t encodeFrame(const Sample &s, uint8_t *wire)
+        {
+            uint8_t raw[FRAME_RAW_SIZE];
+            pack(s, raw);
+            wire[0] = 0x00;
+            size_t n = 1 + cobs::encode(raw, FRAME_RAW_SIZE, wire + 1);
+            wire[n++] = 0x00;
+            return n;
+        }
+
+    } // namespace telemetry
+} // namespace tiny_turtle
@@ -39,6 +39,28 @@ namespace tiny_turtle
         SPIN_CCW, // Drehung auf der Stelle (gegen Uhrzeigersinn)
     };
 
+    /**
+     * @brief Schrittfolge der Unipolar-Motoren (Phasen-Index immer in Halbschritten)
+     */
+    enum class StepMode : uint8_t
+    {
+        HALF, // Halbschritt: feinste Auflösung, 1 Einheit pro Schritt
+        FULL, // Vollschritt, zwei Spulen aktiv: höchstes Drehmoment, 2 Einheiten pro Schritt
+        WAVE,  // Vollschritt, eine Spule aktiv: geringster Strom, 2 Einheiten pro Schritt
+        MICRO, // Sinus-PWM (TT_STEPPER_MICROSTEP=1, sonst HALF): leise und ruckfrei bei langsamer Fahrt
+        AUTO,  // MICRO bei sehr langsamer, HALF bei mittlerer, FULL bei schneller Fahrt
+    };
+
+    /**
+     * @brief Abschluss-Ereignisse der Timer-Steuerung (Bitmaske, siehe hal::waitFor)
+     */
+    enum class StepperEvent : uint32_t
+    {
+        RAMP_DONE = 1u << 0,    // Zielgeschwindigkeit erreicht
+        SEGMENT_DONE = 1u << 1, // Segment mit fester Schrittzahl abgefahren
+        STOPPED = 1u << 2,      // Motoren stehen (Stopp, Sanft-Stopp oder letztes Segment)
+    };
+
     //===========================================================================
     // Stift-Zustand
     //===========================================================================
@@ -0,0 +1,153 @@
+/**
+ * @file demo_flash_safety.cpp
+ * @brief Demo: Flash-Schreibzugriffe während der Fahrt (Regressionstest)
+ */
+
+#include "demo_flash_safety.h"
+#include "../tiny_turtle.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "demo_flash";
+
+namespace tiny_turtle
+{
+    namespace demos
+    {
+        // Segment je Schrittfolge: 8192 Halbschritt-Einheiten bei 1000 µs
+        static constexpr uint32_t TEST_STEPS = 8192;
+        static constexpr uint32_t TEST_INTERVAL_US = 1000;
+
+        // Größte zulässige Verspätung eines Alarms. Ein Stillstand der ISR
+        // während eines Sektor-Löschens läge im Millisekunden-Bereich.
+        static constexpr uint32_t MAX_LATENCY_US = 50;
+
+        // Ein Blob pro Commit - füllt die NVS-Seiten schnell, Seitenwechsel löschen Sektoren
+        static constexpr size_t BLOB_SIZE = 1024;
+
+        static bool openNvs(nvs_handle_t &handle)
+        {
+            esp_err_t err = nvs_flash_init();
+            if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND)
+            {
+                ESP_ERROR_CHECK(nvs_flash_erase());
+                err = nvs_flash_init();
+            }
+            if (err != ESP_OK)
+            {
+                ESP_LOGE(TAG, "NVS nicht verfügbar: %s", esp_err_to_name(err));
+                return false;
+            }
+            return nvs_open("tt_flash", NVS_READWRITE, &handle) == ESP_OK;
+        }
+
+        static const char *modeName(StepMode mode)
+        {
+            switch (mode)
+            {
+            case StepMode::FULL:
+                return "Vollschritt";
+            case StepMode::WAVE:
+                return "Wave";
+            case StepMode::MICRO:
+                return "Mikroschritt";
+            default:
+                return "Halbschritt";
+            }
+        }
+
+        // Ein Segment in einer Schrittfolge fahren und dabei ununterbrochen schreiben
+        static bool runSegment(nvs_handle_t handle, StepMode mode)
+        {
+            static uint8_t blob[BLOB_SIZE];
+            uint32_t writes = 0;
+            uint32_t failed = 0;
+            bool stride = mode == StepMode::FULL || mode == StepMode::WAVE;
+
+            // Ein einzelner Halbschritt von Motor 2 bringt die Paritäten
+            // auseinander - die Vollschritt-Folgen müssen trotzdem anlaufen
+            if (stride)
+                hal::stepMotor(2, 1);
+
+            hal::setStepMode(mode);
+            hal::resetStepCount();
+#if TT_ISR_TIMING
+            monitor::resetIsrTiming();
+#endif
+
+            hal::queueSegment(MotorCommand::FORWARD, TEST_STEPS);
+
+            // Schreiben, bis das Segment fertig ist
+            bool sawMode = false;
+            while (!hal::waitFor(StepperEvent::STOPPED, 0))
+            {
+                sawMode = sawMode || hal::getStepMode() == mode;
+                for (size_t i = 0; i < BLOB_SIZE; i++)
+                    blob[i] = static_cast<uint8_t>(writes + i);
+                if (nvs_set_blob(handle, "blob", blob, BLOB_SIZE) != ESP_OK || nvs_commit(handle) != ESP_OK)
+                    failed++;
+                writes++;
+            }
+
+            // Auch mit Ausrichtung exakt: der Einzel-Halbschritt zählt gegen das Segment
+            int32_t steps = hal::getStepCount();
+            bool ok = steps == static_cast<int32_t>(TEST_STEPS) && sawMode && writes > 0;
+            ESP_LOGI(TAG, "%s: %lu Commits (%lu fehlgeschlagen), Schritte %ld von %lu%s", modeName(mode), writes, failed,
+                     steps, TEST_STEPS, sawMode ? "" : ", Schrittfolge nie aktiv");
+
+#if TT_ISR_TIMING
+            monitor::IsrTiming timing = monitor::getIsrTiming();
+            ok = ok && timing.latencyUs.max <= MAX_LATENCY_US && timing.overruns == 0;
+            ESP_LOGI(TAG, "%s: Alarm-Latenz max %lu µs (Grenze %lu), %lu Überläufe", modeName(mode),
+                     timing.latencyUs.max, MAX_LATENCY_US, timing.overruns);
+#endif
+            return ok;
+        }
+
+        bool runFlashSafetyTest()
+        {
+            ESP_LOGI(TAG, "=== Flash-Schreibzugriffe während der Fahrt ===");
+
+            // NVS puffert Einträge im Heap - hier gewollt, die Fahrt selbst bleibt heap-frei
+            monitor::AllocPermit nvsAllocations;
+
+            nvs_handle_t handle;
+            if (!openNvs(handle))
+                return false;
+
+            // Jede Schrittfolge hat ihre eigene Alarm-Periode (Überlauf-Frist)
+            static constexpr StepMode MODES[] = {
+                StepMode::HALF,
+#if TT_STEPPER_BACKEND != TT_STEPPER_BACKEND_STEP_DIR
+                StepMode::FULL,
+                StepMode::WAVE,
+#if TT_STEPPER_MICROSTEP
+                StepMode::MICRO,
+#endif
+#endif
+            };
+
+            hal::setRamp(0);
+            hal::setStepSpeed(TEST_INTERVAL_US);
+
+            bool ok = true;
+            for (StepMode mode : MODES)
+                ok = runSegment(handle, mode) && ok;
+            nvs_close(handle);
+
+#if !TT_ISR_TIMING
+            ESP_LOGW(TAG, "TT_ISR_TIMING=0 - nur die Schrittzahl geprüft");
+#endif
+
+            if (ok)
+                ESP_LOGI(TAG, "BESTANDEN");
+            else
+                ESP_LOGE(TAG, "FEHLGESCHLAGEN");
+            return ok;
+        }
+
+    } // namespace demos
+} // namespace tiny_turtle
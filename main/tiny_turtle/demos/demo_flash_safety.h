@@ -0,0 +1,26 @@
+#pragma once
+/**
+ * @file demo_flash_safety.h
+ * @brief Demo: Flash-Schreibzugriffe während der Fahrt (Regressionstest)
+ */
+
+namespace tiny_turtle
+{
+    namespace demos
+    {
+        /**
+         * @brief Fährt ein Segment und schreibt dabei laufend in den NVS
+         *
+         * Jeder Commit schaltet den Flash-Cache ab, Seitenwechsel löschen ganze
+         * Sektoren. Die Stepper-ISR muss das unbeschadet überstehen:
+         * - Schrittzahl genau wie angefordert (kein Schritt verloren)
+         * - keine Alarm-Latenz über dem Grenzwert, keine Überläufe
+         *   (braucht TT_ISR_TIMING, sonst nur die Schrittzahl)
+         *
+         * @return true wenn alle Prüfungen bestanden sind
+         * @note Braucht eine NVS-Partition (Standard-Partitionstabelle)
+         */
+        bool runFlashSafetyTest();
+
+    } // namespace demos
+} // namespace tiny_turtle
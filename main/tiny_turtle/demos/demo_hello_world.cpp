@@ -22,6 +22,10 @@ namespace tiny_turtle
             // Text schreiben
             drawing::plotText("Hello World! ", height);
 
+            // Ressourcenverbrauch des Jobs (plotChar-Takte, Stift-Wartezeit, Tasks, Heap)
+            monitor::logPerfSnapshot();
+            monitor::printPerfJson();
+
             ESP_LOGI(TAG, "Demo beendet.");
         }
 
@@ -33,11 +33,8 @@ namespace tiny_turtle
             // Beschleunigung zu schnell
             hal::setTargetSpeed(1000); // Rampe zu 1000 µs = 1000 Steps/s
 
-            // Warten bis Rampe fertig + fahren
-            while (hal::isRamping())
-            {
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
+            // Warten bis Rampe fertig (ISR meldet RAMP_DONE) + fahren
+            hal::waitFor(StepperEvent::RAMP_DONE);
             ESP_LOGI(TAG, "Volle Geschwindigkeit erreicht!");
             vTaskDelay(pdMS_TO_TICKS(3000));
 
@@ -46,10 +43,7 @@ namespace tiny_turtle
             hal::smoothStop();
 
             // Warten bis gestoppt
-            while (hal::isRamping())
-            {
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
+            hal::waitFor(StepperEvent::STOPPED);
             ESP_LOGI(TAG, "Gestoppt!");
             vTaskDelay(pdMS_TO_TICKS(2000));
 
@@ -59,10 +53,7 @@ namespace tiny_turtle
             hal::setMotorCommand(MotorCommand::SPIN_CW);
             hal::setTargetSpeed(800); // Sehr schnell werden
 
-            while (hal::isRamping())
-            {
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
+            hal::waitFor(StepperEvent::RAMP_DONE);
             ESP_LOGI(TAG, "Max Drehgeschwindigkeit!");
             vTaskDelay(pdMS_TO_TICKS(3000));
 
@@ -70,18 +61,45 @@ namespace tiny_turtle
             ESP_LOGI(TAG, "Abbremsen...");
             hal::setTargetSpeed(2500);
 
-            while (hal::isRamping())
-            {
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
+            hal::waitFor(StepperEvent::RAMP_DONE);
             vTaskDelay(pdMS_TO_TICKS(2000));
 
             // Sanft stoppen
             hal::smoothStop();
-            while (hal::isRamping())
-            {
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
+            hal::waitFor(StepperEvent::STOPPED);
+
+            // Verkettete Segmente: das nächste startet im Alarm, in dem das vorige endet.
+            // Schnelle Fahrten im Vollschritt, die Drehung präzise im Halbschritt.
+            ESP_LOGI(TAG, "Segmente: vor (Vollschritt), Drehung (Halbschritt), zurück (Vollschritt)...");
+            hal::setStepSpeed(1500);
+            hal::queueSegment(MotorCommand::FORWARD, 1024, StepMode::FULL);
+            hal::queueSegment(MotorCommand::SPIN_CCW, 512, StepMode::HALF);
+            hal::queueSegment(MotorCommand::BACKWARD, 1024, StepMode::FULL);
+            hal::waitFor(StepperEvent::STOPPED);
+
+            // Langsame Fahrt im Sinus-Mikroschritt (ohne TT_STEPPER_MICROSTEP im Halbschritt)
+            ESP_LOGI(TAG, "Mikroschritt: langsam vor...");
+            hal::setStepSpeed(4000);
+            hal::queueSegment(MotorCommand::FORWARD, 256, StepMode::MICRO);
+            hal::waitFor(StepperEvent::STOPPED);
+
+            // Automatischer Wechsel: über die Rampe (Mikroschritt -> Halbschritt ->)
+            // in den Vollschritt und zurück
+            ESP_LOGI(TAG, "StepMode::AUTO mit Rampe...");
+            hal::setStepMode(StepMode::AUTO);
+            hal::setStepSpeed(3000);
+            hal::setMotorCommand(MotorCommand::FORWARD);
+            hal::setTargetSpeed(400);
+            hal::waitFor(StepperEvent::RAMP_DONE);
+            ESP_LOGI(TAG, "Schrittfolge bei 400 µs: %s", hal::getStepMode() == StepMode::FULL ? "FULL" : "HALF");
+            hal::smoothStop();
+            hal::waitFor(StepperEvent::STOPPED);
+            hal::setStepMode(StepMode::HALF);
+            ESP_LOGI(TAG, "Segmente fertig (Schritt %ld)", hal::getStepCount());
+
+            // Aufgezeichnete Befehle und Rampen-Ereignisse erst jetzt formatieren
+            monitor::dumpTrace();
+            monitor::logIsrTiming();
 
             ESP_LOGI(TAG, "Motor-Test beendet.");
         }
@@ -91,7 +91,7 @@ namespace tiny_turtle
         {
             ESP_LOGI(TAG, "Zeichne Spirale (%d Umdrehungen)", turns);
 
-            motion::spiral(turns, startRadius, endRadius);
+            motion::spiral(startRadius, endRadius, static_cast<float>(turns));
 
             ESP_LOGI(TAG, "Spirale fertig.");
         }
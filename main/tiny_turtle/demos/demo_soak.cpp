@@ -0,0 +1,57 @@
+/**
+ * @file demo_soak.cpp
+ * @brief Demo: Langer Zeichen-Job ohne Heap-Zugriffe (Dauertest)
+ */
+
+#include "demo_soak.h"
+#include "demo_shapes.h"
+#include "../tiny_turtle.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+static const char *TAG = "demo_soak";
+
+namespace tiny_turtle
+{
+    namespace demos
+    {
+        static constexpr int TEXT_SCALE = 8;
+
+        bool runSoakTest(uint32_t rounds)
+        {
+            ESP_LOGI(TAG, "=== Dauertest ohne Heap (%lu Durchläufe) ===", rounds);
+
+            if (!monitor::isAllocTrackingArmed())
+                ESP_LOGW(TAG, "TT_ALLOC_TRACKING=0 - nur freier Heap und Minimum werden verglichen");
+
+            monitor::resetAllocStats();
+            size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+            size_t minBefore = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+
+            bool ok = true;
+            for (uint32_t round = 0; round < rounds && ok; round++)
+            {
+                drawing::plotText("TINY TURTLE ", TEXT_SCALE);
+                drawSquare(40.0f);
+                drawCircle(20.0f);
+                drawStar(5, 25.0f, 10.0f);
+
+                monitor::AllocStats stats = monitor::getAllocStats();
+                size_t freeNow = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+                ok = stats.count == 0 && freeNow == freeBefore;
+                ESP_LOGI(TAG, "Durchlauf %lu: %lu Allokationen, Heap frei %u", round + 1, stats.count,
+                         static_cast<unsigned>(freeNow));
+            }
+
+            ok = ok && heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT) == minBefore;
+            monitor::logAllocStats();
+
+            if (ok)
+                ESP_LOGI(TAG, "BESTANDEN");
+            else
+                ESP_LOGE(TAG, "FEHLGESCHLAGEN");
+            return ok;
+        }
+
+    } // namespace demos
+} // namespace tiny_turtle
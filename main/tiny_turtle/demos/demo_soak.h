@@ -0,0 +1,25 @@
+#pragma once
+/**
+ * @file demo_soak.h
+ * @brief Demo: Langer Zeichen-Job ohne Heap-Zugriffe (Dauertest)
+ */
+
+#include <cstdint>
+
+namespace tiny_turtle
+{
+    namespace demos
+    {
+        /**
+         * @brief Zeichnet wiederholt Text und Formen und prüft, dass dabei nichts alloziert wird
+         *
+         * Mit TT_ALLOC_TRACKING zählt der Heap-Hook jede Allokation; ohne den
+         * Hook wird nur verglichen, ob freier Heap und Heap-Minimum gleich bleiben.
+         *
+         * @param rounds Durchläufe (ein Durchlauf: Text, Quadrat, Kreis, Stern)
+         * @return true wenn in keinem Durchlauf alloziert wurde
+         */
+        bool runSoakTest(uint32_t rounds = 20);
+
+    } // namespace demos
+} // namespace tiny_turtle
@@ -17,6 +17,8 @@
  *     // tiny_turtle::demos::runMotorTest();
  *     // tiny_turtle::demos::drawSquare(100);
  *     // tiny_turtle::demos::drawCircle(50);
+ *     // tiny_turtle::demos::runFlashSafetyTest();
+ *     // tiny_turtle::demos::runSoakTest();
  * }
  * @endcode
  */
@@ -24,6 +26,8 @@
 #include "demo_hello_world.h"
 #include "demo_motor_test.h"
 #include "demo_shapes.h"
+#include "demo_flash_safety.h"
+#include "demo_soak.h"
 
 namespace tiny_turtle
 {
@@ -42,6 +46,8 @@ namespace tiny_turtle
             CIRCLE,          ///< Zeichnet einen Kreis
             SPIRAL,          ///< Zeichnet eine Spirale
             STAR,            ///< Zeichnet einen Stern
+            FLASH_SAFETY,    ///< Flash-Schreibzugriffe während der Fahrt
+            SOAK,            ///< Langer Zeichen-Job ohne Heap-Zugriffe
         };
 
         /**
@@ -76,6 +82,12 @@ namespace tiny_turtle
             case DemoType::STAR:
                 drawStar();
                 break;
+            case DemoType::FLASH_SAFETY:
+                runFlashSafetyTest();
+                break;
+            case DemoType::SOAK:
+                runSoakTest();
+                break;
             }
         }
 
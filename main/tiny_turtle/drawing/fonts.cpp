@@ -80,6 +80,68 @@ namespace tiny_turtle
             {20, 142, 143, 134, 123, 114, 103, 102, 120, 200, 200, 200, 200, 200}   // $ Heart
         };
 
+
+        int asciiToFontIndex(uint8_t c)
+        {
+            if (c >= 'A' && c <= 'Z')
+                return c - 'A';
+            if (c >= 'a' && c <= 'z')
+                return c - 'a';
+            if (c >= '0' && c <= '9')
+                return c - '0' + 26;
+            if (c == ' ')
+                return 36; // Space
+            if (c == '*')
+                return 38; // Strich
+            if (c == 196)
+                return 39; // Ä
+            if (c == 214)
+                return 40; // Ö
+            if (c == 220)
+                return 41; // Ü
+            if (c == ',')
+                return 42;
+            if (c == '-')
+                return 43;
+            if (c == '.')
+                return 44;
+            if (c == '!')
+                return 45;
+            if (c == '?')
+                return 46;
+            if (c == 223)
+                return 47; // ß
+            if (c == '\'')
+                return 48;
+            if (c == '&')
+                return 49;
+            if (c == '+')
+                return 50;
+            if (c == ':')
+                return 51;
+            if (c == ';')
+                return 52;
+            if (c == '"')
+                return 53;
+            if (c == '#')
+                return 54;
+            if (c == '(')
+                return 55;
+            if (c == ')')
+                return 56;
+            if (c == '=')
+                return 57;
+            if (c == '@')
+                return 58;
+            if (c == 228)
+                return 39; // ä -> Ä
+            if (c == 246)
+                return 40; // ö -> Ö
+            if (c == 252)
+                return 41; // ü -> Ü
+            return 37;     // Unknown -> Space
+        }
+
     } // namespace drawing
 } // namespace tiny_turtle
 
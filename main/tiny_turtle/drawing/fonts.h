@@ -20,6 +20,13 @@ namespace tiny_turtle
         // Font-Koordinaten für alle Zeichen
         extern const uint8_t FONT_DATA[63][14];
 
+        /**
+         * @brief ASCII zu Font-Index konvertieren
+         * @param c ASCII-Zeichen
+         * @return Index im Font-Array
+         */
+        int asciiToFontIndex(uint8_t c);
+
     } // namespace drawing
 } // namespace tiny_turtle
 
@@ -4,8 +4,10 @@
  * @brief Text-Zeichenfunktionen
  */
 
-#include <string>
 #include <cstdint>
+#include <string_view>
+#include "fonts.h"
+#include "../core/context.h"
 
 namespace tiny_turtle
 {
@@ -13,29 +15,24 @@ namespace tiny_turtle
     {
         /**
          * @brief Text schreiben
-         * @param text Der zu schreibende Text
+         * @param text Der zu schreibende Text (Literal oder Puffer, wird nicht kopiert)
          * @param scale Schriftgröße in mm
          */
-        void plotText(const std::string &text, int scale);
+        void plotText(TurtleContext &ctx, std::string_view text, int scale);
+        void plotText(std::string_view text, int scale);
 
         /**
          * @brief Einzelnes Zeichen schreiben
          * @param character ASCII-Zeichen
          * @param scale Schriftgröße
          */
+        void plotChar(TurtleContext &ctx, uint8_t character, float scale);
         void plotChar(uint8_t character, float scale);
 
-        /**
-         * @brief ASCII zu Font-Index konvertieren
-         * @param c ASCII-Zeichen
-         * @return Index im Font-Array
-         */
-        int asciiToFontIndex(uint8_t c);
-
     } // namespace drawing
 } // namespace tiny_turtle
 
 // Legacy-Kompatibilität
-void plotText(const std::string &str, int scale);
+void plotText(std::string_view str, int scale);
 void plotChar(uint8_t character, float scale);
 int ASCIItoIndex(uint8_t c);
@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * @file drawing/text_core.h
+ * @brief Glyphen zeichnen, templatisiert auf ein HAL-Backend
+ *
+ * Zerlegt ein Zeichen aus FONT_DATA in Drehungen, Fahrten und Stift-Wechsel
+ * über motion::MotionCore. drawing/text.cpp nutzt das mit hal::DeviceHal,
+ * der Job-Compiler (host/job_compiler) mit einem aufzeichnenden Backend.
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include "fonts.h"
+#include "../motion/motion_core.h"
+
+namespace tiny_turtle
+{
+    namespace drawing
+    {
+
+        template <class Hal>
+        void plotChar(motion::MotionCore<Hal> &motion, uint8_t character, float scale)
+        {
+            Hal &hal = motion.hal();
+            int index = asciiToFontIndex(character);
+
+            for (int i = 0; i < 14; i++)
+            {
+                uint8_t coord = FONT_DATA[index][i];
+
+                if (coord == 200)
+                {
+                    // Ende des Zeichens
+                    break;
+                }
+
+                if (coord == 222)
+                {
+                    // Punkt zeichnen
+                    hal.penDown();
+                    hal.penUp();
+                    continue;
+                }
+
+                uint8_t x = (coord / 10) % 10; // Zehner = X
+                uint8_t y = coord % 10;        // Einer = Y
+                bool draw = (coord >= 100);    // Hunderter = Zeichnen
+
+                // Distanz berechnen
+                float dist = std::sqrt(static_cast<float>(x * x + y * y)) * scale;
+                float angle = std::atan2(static_cast<double>(x), static_cast<double>(y)) * 180.0f / M_PI;
+
+                if (draw)
+                {
+                    hal.penDown();
+                }
+                else
+                {
+                    hal.penUp();
+                }
+
+                // Bewegung zum Punkt
+                if (dist > 0.1f)
+                {
+                    motion.turn(angle);
+                    motion.forward(dist);
+                    motion.turn(-angle);
+                }
+            }
+
+            // Zeichenabstand
+            hal.penUp();
+            motion.forward(5.0f * scale);
+        }
+
+        template <class Hal>
+        void plotText(motion::MotionCore<Hal> &motion, std::string_view text, int scale)
+        {
+            for (char c : text)
+            {
+                plotChar(motion, static_cast<uint8_t>(c), static_cast<float>(scale));
+            }
+        }
+
+    } // namespace drawing
+} // namespace tiny_turtle
@@ -1,37 +1,201 @@
 /**
  * @file hal/audio.cpp
- * @brief Implementierung der Audio-Funktionen
+ * @brief Implementierung der Audio-Funktionen (Ton-Sequencer)
+ *
+ * LEDC-Timer und -Kanal werden einmalig in initAudio() konfiguriert. Der
+ * esp_timer-Callback holt die nächste Note aus der Mailbox, setzt nur die
+ * Frequenz (bzw. Duty 0 für Pausen) und plant sich für das Ende der Note
+ * erneut ein.
  */
 
 #include "audio.h"
 #include "led.h"
 #include "../core/config.h"
+#include "../core/mailbox.h"
+#include "../monitor/perf.h"
 #include "gpio_hal.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+
+#include <atomic>
+
+#include "driver/ledc.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "hal.audio";
 
 namespace tiny_turtle
 {
     namespace hal
     {
+        // Speaker nutzt LEDC-Timer/-Kanal 1 (exklusiv, auch tone() läuft über den Sequencer)
+        static constexpr ledc_timer_t TONE_TIMER = LEDC_TIMER_1;
+        static constexpr ledc_channel_t TONE_CHANNEL = LEDC_CHANNEL_1;
+        static constexpr ledc_timer_bit_t TONE_RESOLUTION = LEDC_TIMER_10_BIT;
+        static constexpr uint32_t TONE_DUTY_ON = (1u << TONE_RESOLUTION) / 2; // 50% Rechteck
+
+        static Mailbox<Note, 32> s_notes;
+        static esp_timer_handle_t s_note_timer = nullptr;
+        static std::atomic<bool> s_playing{false};
+
+        // stopTone(): bis zu dieser Mailbox-Position verwerfen (erledigt der Callback)
+        static std::atomic<bool> s_flush{false};
+        static std::atomic<uint32_t> s_flush_until{0};
+        static bool s_initialized = false;
+
+        static monitor::PerfGauge s_queue_gauge("audio.queued_notes");
+        static monitor::PerfCounter s_dropped_notes("audio.dropped_notes");
+
+        static void setToneOutput(uint16_t frequencyHz)
+        {
+            if (frequencyHz > 0)
+            {
+                ledc_set_freq(LEDC_LOW_SPEED_MODE, TONE_TIMER, frequencyHz);
+                ledc_set_duty(LEDC_LOW_SPEED_MODE, TONE_CHANNEL, TONE_DUTY_ON);
+            }
+            else
+            {
+                ledc_set_duty(LEDC_LOW_SPEED_MODE, TONE_CHANNEL, 0);
+            }
+            ledc_update_duty(LEDC_LOW_SPEED_MODE, TONE_CHANNEL);
+        }
+
+        static void kickSequencer()
+        {
+            // Nur starten, wenn der Sequencer gerade nicht läuft
+            bool expected = false;
+            if (s_playing.compare_exchange_strong(expected, true))
+            {
+                esp_timer_start_once(s_note_timer, 10);
+            }
+        }
+
+        static void noteTimerCallback(void *)
+        {
+            Note note;
+            if (s_flush.exchange(false))
+            {
+                uint32_t until = s_flush_until.load();
+                while (static_cast<int32_t>(until - s_notes.fetchCount()) > 0 && s_notes.fetch(note))
+                {
+                }
+                s_queue_gauge.set(static_cast<int32_t>(s_notes.size()));
+            }
+
+            if (s_notes.fetch(note))
+            {
+                setToneOutput(note.frequencyHz);
+                esp_timer_start_once(s_note_timer, static_cast<uint64_t>(note.durationMs) * 1000);
+                return;
+            }
+
+            // Warteschlange leer: Ausgang stumm schalten
+            setToneOutput(0);
+            s_playing.store(false);
+
+            // Eine Note, die zwischen fetch() und store(false) kam, nicht verlieren
+            if (!s_notes.empty())
+            {
+                kickSequencer();
+            }
+        }
+
         void initAudio()
         {
-            pinMode(config::SPEAKER_PIN, OUTPUT);
+            if (s_initialized)
+                return;
+
+            ledc_timer_config_t timer_cfg = {
+                .speed_mode = LEDC_LOW_SPEED_MODE,
+                .duty_resolution = TONE_RESOLUTION,
+                .timer_num = TONE_TIMER,
+                .freq_hz = 1000,
+                .clk_cfg = LEDC_AUTO_CLK,
+            };
+            ESP_ERROR_CHECK(ledc_timer_config(&timer_cfg));
+
+            ledc_channel_config_t ch_cfg = {
+                .gpio_num = config::SPEAKER_PIN,
+                .speed_mode = LEDC_LOW_SPEED_MODE,
+                .channel = TONE_CHANNEL,
+                .intr_type = LEDC_INTR_DISABLE,
+                .timer_sel = TONE_TIMER,
+                .duty = 0,
+                .hpoint = 0,
+            };
+            ESP_ERROR_CHECK(ledc_channel_config(&ch_cfg));
+
+            esp_timer_create_args_t timer_args = {
+                .callback = noteTimerCallback,
+                .arg = nullptr,
+                .dispatch_method = ESP_TIMER_TASK,
+                .name = "tone_seq",
+                .skip_unhandled_events = false,
+            };
+            ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_note_timer));
+
+            s_initialized = true;
+            ESP_LOGI(TAG, "Ton-Sequencer initialisiert (GPIO %d)", config::SPEAKER_PIN);
         }
 
         void playTone(uint32_t frequency, uint32_t durationMs)
         {
-            tone(config::SPEAKER_PIN, frequency, durationMs);
+            // Note hat 16-Bit-Felder: Frequenz begrenzen, lange Töne aufteilen
+            Note note = {static_cast<uint16_t>(frequency > UINT16_MAX ? UINT16_MAX : frequency), 0};
+            do
+            {
+                note.durationMs = static_cast<uint16_t>(durationMs > UINT16_MAX ? UINT16_MAX : durationMs);
+                durationMs -= note.durationMs;
+            } while (playNotes(&note, 1) == 1 && durationMs > 0);
+        }
+
+        int playNotes(const Note *notes, int count)
+        {
+            if (!s_initialized)
+                return 0;
+
+            int accepted = 0;
+            while (accepted < count && s_notes.post(notes[accepted]))
+            {
+                accepted++;
+            }
+            if (accepted < count)
+            {
+                s_dropped_notes.add(count - accepted);
+                ESP_LOGW(TAG, "Warteschlange voll, %d Noten verworfen", count - accepted);
+            }
+            s_queue_gauge.set(static_cast<int32_t>(s_notes.size()));
+
+            kickSequencer();
+            return accepted;
         }
 
         void stopTone()
         {
-            noTone(config::SPEAKER_PIN);
+            if (!s_initialized)
+                return;
+
+            // Nicht selbst aus der Mailbox holen - nur der Callback ist Konsument.
+            // Laufende Note abbrechen und den Callback sofort leeren lassen; plant
+            // er sich gerade selbst neu ein, schlägt der Start fehl und wird wiederholt.
+            s_flush_until.store(s_notes.postCount());
+            s_flush.store(true);
+            s_playing.store(true);
+            esp_timer_stop(s_note_timer);
+            while (esp_timer_start_once(s_note_timer, 10) != ESP_OK)
+            {
+                esp_timer_stop(s_note_timer);
+            }
+        }
+
+        bool isTonePlaying()
+        {
+            return s_playing.load();
         }
 
         void playRandomMelody()
         {
             int freq = random(200, 1000);
+            Note melody[6];
 
             for (int i = 0; i < 3; i++)
             {
@@ -41,10 +205,13 @@ namespace tiny_turtle
                 if (freq > 1500)
                     freq /= 4;
 
-                setLedColor(random(5) * 20, random(5) * 20, random(5) * 20);
-                playTone(freq, 100);
-                vTaskDelay(pdMS_TO_TICKS(100));
+                melody[i * 2] = {static_cast<uint16_t>(freq), 100};
+                melody[i * 2 + 1] = {0, 100}; // Pause
             }
+
+            // Lichtshow für die Dauer der Melodie (3 x 200 ms)
+            flashLedEffect(LedEffect::SPARKLE, 0, 0, 0, 600);
+            playNotes(melody, 6);
         }
 
     } // namespace hal
@@ -52,3 +219,5 @@ namespace tiny_turtle
 
 // Legacy-Kompatibilität
 void triTone() { tiny_turtle::hal::playRandomMelody(); }
+void tone(int pin, uint32_t frequency, uint32_t duration) { tiny_turtle::hal::playTone(frequency, duration); }
+void noTone(int pin) { tiny_turtle::hal::stopTone(); }
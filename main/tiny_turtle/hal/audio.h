@@ -2,6 +2,10 @@
 /**
  * @file hal/audio.h
  * @brief Hardware Abstraction Layer für Audio (Speaker/Buzzer)
+ *
+ * Töne werden von einem Sequencer abgespielt: Aufrufer legen Noten in eine
+ * Warteschlange, ein esp_timer-Callback schaltet zwischen den Noten nur die
+ * LEDC-Frequenz um. Keine Funktion hier blockiert für die Dauer eines Tons.
  */
 
 #include <cstdint>
@@ -12,22 +16,45 @@ namespace tiny_turtle
     {
 
         /**
-         * @brief Audio initialisieren
+         * @brief Eine Note für den Sequencer
+         */
+        struct Note
+        {
+            uint16_t frequencyHz; ///< 0 = Pause
+            uint16_t durationMs;
+        };
+
+        /**
+         * @brief Audio initialisieren (LEDC-Timer/-Kanal einmalig konfigurieren)
          */
         void initAudio();
 
         /**
          * @brief Ton abspielen
-         * @param frequency Frequenz in Hz
-         * @param durationMs Dauer in Millisekunden
+         * @param frequency Frequenz in Hz (0 = Pause, begrenzt auf 65535)
+         * @param durationMs Dauer in Millisekunden (über 65535 ms auf mehrere Noten verteilt)
+         * @note Nicht-blockierend, der Ton wird hinten an die Warteschlange gehängt
          */
         void playTone(uint32_t frequency, uint32_t durationMs);
 
         /**
-         * @brief Ton stoppen
+         * @brief Mehrere Noten an die Warteschlange anhängen
+         * @return Anzahl tatsächlich angenommener Noten (Warteschlange voll)
+         */
+        int playNotes(const Note *notes, int count);
+
+        /**
+         * @brief Ton stoppen und Warteschlange leeren
+         * @note Geleert wird im Sequencer-Callback (einziger Konsument der Mailbox):
+         *       alle bis zum Aufruf abgelegten Noten, spätere bleiben erhalten
          */
         void stopTone();
 
+        /**
+         * @brief Prüfen ob der Sequencer gerade spielt
+         */
+        bool isTonePlaying();
+
         /**
          * @brief Zufällige Melodie abspielen (3 Töne)
          */
@@ -38,5 +65,5 @@ namespace tiny_turtle
 
 // Legacy-Kompatibilität
 void triTone();
-void tone(int pin, uint32_t frequency, uint32_t duration);
+void tone(int pin, uint32_t frequency, uint32_t duration); // Nicht-blockierend, pin wird ignoriert (config::SPEAKER_PIN)
 void noTone(int pin);
@@ -0,0 +1,24 @@
+/**
+ * @file hal/device_hal.cpp
+ * @brief Nicht zeitkritischer Teil des Hardware-Backends
+ */
+
+#include "device_hal.h"
+#include "../monitor/perf.h"
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        static monitor::PerfCounter s_segments("motion.segments");
+        static monitor::PerfCounter s_steps("motion.steps");
+
+        void DeviceHal::segmentDone(uint32_t steps)
+        {
+            s_segments.add();
+            s_steps.add(steps);
+        }
+
+    } // namespace hal
+} // namespace tiny_turtle
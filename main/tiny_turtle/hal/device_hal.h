@@ -0,0 +1,53 @@
+#pragma once
+/**
+ * @file hal/device_hal.h
+ * @brief HAL-Backend für die Hardware (ESP-IDF)
+ *
+ * Bindet die Schnittstelle aus hal/hal_backend.h an die hal::-Funktionen
+ * eines TurtleContext. Alle Aufrufe im Schritt-Pfad sind inline, die
+ * Bewegungs-Kerne kompilieren damit zu denselben Aufrufen wie vorher die
+ * freien Funktionen in motion/motion.cpp.
+ */
+
+#include <cstdint>
+#include "hal_backend.h"
+#include "gpio_hal.h"
+#include "sensors.h"
+#include "servo.h"
+#include "stepper.h"
+#include "../core/context.h"
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        class DeviceHal : public HalBackend<DeviceHal>
+        {
+        public:
+            explicit DeviceHal(TurtleContext &ctx) : ctx_(ctx) {}
+
+            inline void stepMotor(uint8_t motor, int direction) { hal::stepMotor(ctx_, motor, direction); }
+            inline void stopMotors() { hal::stopMotors(ctx_); }
+            inline void delayMicroseconds(uint32_t us) { ::delayMicroseconds(us); }
+            inline BumperState readBumpers() { return hal::readBumpers(ctx_); }
+            inline bool isBumperPressed() { return hal::isBumperPressed(ctx_); }
+            inline void penUp() { hal::penUp(ctx_); }
+            inline void penDown() { hal::penDown(ctx_); }
+            inline bool isDrawing() { return ctx_.hot.drawing; }
+            inline void waitServoSettled() { hal::waitServoSettled(ctx_); }
+            inline long random(long min, long max) { return ::random(min, max); }
+            inline void reportSteps(int dir1, int dir2) { ctx_.state.addSteps(dir1, dir2); }
+            inline void reportPose(const Pose &pose) { ctx_.state.setPose(pose.x, pose.y, pose.heading); }
+
+            /**
+             * @brief Zähler "motion.segments" und "motion.steps" fortschreiben
+             */
+            void segmentDone(uint32_t steps);
+
+        private:
+            TurtleContext &ctx_;
+        };
+
+    } // namespace hal
+} // namespace tiny_turtle
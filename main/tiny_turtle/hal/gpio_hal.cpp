@@ -21,13 +21,11 @@ namespace
   constexpr ledc_timer_bit_t kServoResolution = LEDC_TIMER_15_BIT; // 20 ms period, enough granularity
   constexpr uint32_t kServoFreq = 50;
 
-  // Speaker (tone) uses LEDC timer/channel 1.
-  constexpr ledc_timer_t kToneTimer = LEDC_TIMER_1;
-  constexpr ledc_channel_t kToneChannel = LEDC_CHANNEL_1;
-  constexpr ledc_timer_bit_t kToneResolution = LEDC_TIMER_10_BIT;
+  // LEDC timer/channel 1 belong to the tone sequencer (hal/audio.cpp).
 
   adc_oneshot_unit_handle_t adc_handle = nullptr;
   bool adc_initialized = false;
+  uint32_t adc_configured_channels = 0; // Bit n = ADC1 channel n configured
 
   void init_adc()
   {
@@ -48,6 +46,42 @@ namespace
     }
   }
 
+  // Map pin to its ADC1 channel, create the unit and configure the channel on first use
+  bool adc_channel_for(int pin, adc_channel_t &channel)
+  {
+    init_adc();
+    if (!adc_initialized || !adc_handle)
+      return false;
+
+    adc_unit_t unit;
+    if (adc_oneshot_io_to_channel(static_cast<gpio_num_t>(pin), &unit, &channel) != ESP_OK)
+    {
+      ESP_LOGW(TAG, "GPIO %d not ADC-capable", pin);
+      return false;
+    }
+    if (unit != ADC_UNIT_1)
+    {
+      ESP_LOGW(TAG, "Only ADC1 supported in this helper (gpio %d)", pin);
+      return false;
+    }
+
+    uint32_t bit = 1u << channel;
+    if (!(adc_configured_channels & bit))
+    {
+      adc_oneshot_chan_cfg_t cfg = {
+          .atten = ADC_ATTEN_DB_11,
+          .bitwidth = ADC_BITWIDTH_DEFAULT,
+      };
+      if (adc_oneshot_config_channel(adc_handle, channel, &cfg) != ESP_OK)
+      {
+        ESP_LOGW(TAG, "ADC channel config failed on gpio %d", pin);
+        return false;
+      }
+      adc_configured_channels |= bit;
+    }
+    return true;
+  }
+
   void configure_ledc_timer(ledc_timer_t timer, ledc_timer_bit_t resolution, uint32_t freq_hz)
   {
     ledc_timer_config_t config = {
@@ -99,31 +133,19 @@ long random(long min, long max)
   return min + static_cast<long>(esp_random() % static_cast<uint32_t>(max - min));
 }
 
-// ADC helper (uses ADC1 by default)
-int analogRead(int pin)
+// Create the ADC unit and configure the pin's channel up front (ADC1 only)
+void analogReadInit(int pin)
 {
-  init_adc();
-  if (!adc_initialized || !adc_handle)
-    return 0;
+  adc_channel_t channel;
+  adc_channel_for(pin, channel);
+}
 
-  adc_unit_t unit;
+// ADC helper (uses ADC1 by default), channel is configured once on first use
+int analogRead(int pin)
+{
   adc_channel_t channel;
-  if (adc_oneshot_io_to_channel(static_cast<gpio_num_t>(pin), &unit, &channel) != ESP_OK)
-  {
-    ESP_LOGW(TAG, "GPIO %d not ADC-capable", pin);
+  if (!adc_channel_for(pin, channel))
     return 0;
-  }
-  if (unit != ADC_UNIT_1)
-  {
-    ESP_LOGW(TAG, "Only ADC1 supported in this helper (gpio %d)", pin);
-    return 0;
-  }
-
-  adc_oneshot_chan_cfg_t cfg = {
-      .atten = ADC_ATTEN_DB_11,
-      .bitwidth = ADC_BITWIDTH_DEFAULT,
-  };
-  adc_oneshot_config_channel(adc_handle, channel, &cfg);
 
   int raw = 0;
   if (adc_oneshot_read(adc_handle, channel, &raw) != ESP_OK)
@@ -176,22 +198,3 @@ void Servo::detach()
   ledc_stop(LEDC_LOW_SPEED_MODE, kServoChannel, 0);
   attached_ = false;
 }
-
-// tone implementation using LEDC
-void tone(int pin, uint32_t freq_hz, uint32_t duration_ms)
-{
-  configure_ledc_timer(kToneTimer, kToneResolution, freq_hz);
-  ledc_channel_config_t ch_cfg = {
-      .gpio_num = pin,
-      .speed_mode = LEDC_LOW_SPEED_MODE,
-      .channel = kToneChannel,
-      .intr_type = LEDC_INTR_DISABLE,
-      .timer_sel = kToneTimer,
-      .duty = (1u << kToneResolution) / 2, // 50% duty square wave
-      .hpoint = 0,
-  };
-  ledc_channel_config(&ch_cfg);
-
-  vTaskDelay(pdMS_TO_TICKS(duration_ms));
-  ledc_stop(LEDC_LOW_SPEED_MODE, kToneChannel, 0);
-}
@@ -21,6 +21,9 @@ long random(long max);
 long random(long min, long max);
 inline long constrain(long x, long a, long b) { return std::clamp(x, a, b); }
 int analogRead(int pin);
+// Create the ADC unit and configure the channel up front so analogRead() only samples
+void analogReadInit(int pin);
+// Queues the note on the tone sequencer (hal/audio.cpp), returns immediately
 void tone(int pin, uint32_t freq_hz, uint32_t duration_ms);
 
 class Servo
@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file hal/hal_backend.h
+ * @brief Statische HAL-Schnittstelle der Bewegungs-Kerne (CRTP)
+ *
+ * motion::MotionCore (motion/motion_core.h) ist auf ein Backend templatisiert,
+ * das von HalBackend<Derived> erbt und diese Funktionen bereitstellt:
+ *
+ *   struct Backend : hal::HalBackend<Backend>
+ *   {
+ *       void stepMotor(uint8_t motor, int direction); // Halbschritt an Motor 1 oder 2
+ *       void stopMotors();                            // Spulen stromlos
+ *       void delayMicroseconds(uint32_t us);          // Pause zwischen zwei Schritten
+ *       BumperState readBumpers();
+ *       void penUp();
+ *       void penDown();
+ *       bool isDrawing();                             // Stift unten?
+ *       void waitServoSettled();                      // Vor jeder Fahrt
+ *       long random(long min, long max);              // Gleichverteilt in [min, max)
+ *       void reportSteps(int dir1, int dir2);         // Schrittzähler fortschreiben
+ *       void reportPose(const Pose &pose);            // Pose nach goTo() veröffentlichen
+ *       void segmentDone(uint32_t steps);             // Ende einer Fahrt/Drehung
+ *   };
+ *
+ * Die Basis ergänzt daraus zusammengesetzte Operationen; ein Backend darf
+ * sie mit einer schnelleren eigenen Fassung verdecken. Alle Aufrufe werden
+ * zur Compile-Zeit gebunden, es gibt keine virtuellen Funktionen - auf dem
+ * Gerät bleibt vom Backend nach dem Inlining nur der Aufruf der hal::-Funktion.
+ *
+ * Backends:
+ * - hal::DeviceHal (hal/device_hal.h): ESP-IDF-Hardware eines TurtleContext
+ * - host::SimHal (host/sim_hal.h): Simulation mit virtueller Zeit
+ * - host::RecordingHal<Inner> (host/recording_hal.h): protokolliert jeden
+ *   Aufruf und reicht ihn an Inner weiter (Wiedergabe mit host::replay())
+ * - host::TimelineHal (host/timeline_hal.h): schreibt eine Schritt-Abfolge
+ *   für motion::playTimeline()
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cstdint>
+#include <type_traits>
+#include "../core/types.h"
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        template <class Derived>
+        class HalBackend
+        {
+        public:
+            /**
+             * @brief Beide Motoren einen Halbschritt weiter und Zähler fortschreiben
+             */
+            inline void stepPair(int dir1, int dir2)
+            {
+                self().stepMotor(1, dir1);
+                self().stepMotor(2, dir2);
+                self().reportSteps(dir1, dir2);
+            }
+
+            /**
+             * @brief Ist einer der Bumper gedrückt?
+             */
+            inline bool isBumperPressed()
+            {
+                return self().readBumpers().any();
+            }
+
+        protected:
+            HalBackend() = default;
+
+        private:
+            inline Derived &self() { return static_cast<Derived &>(*this); }
+        };
+
+        /**
+         * @brief true, wenn T die Schnittstelle über HalBackend<T> erfüllt
+         */
+        template <class T>
+        constexpr bool isHalBackend = std::is_base_of_v<HalBackend<T>, T>;
+
+    } // namespace hal
+} // namespace tiny_turtle
@@ -1,40 +1,345 @@
 /**
  * @file hal/led.cpp
- * @brief Implementierung der LED-Steuerung
+ * @brief Implementierung der LED-Steuerung (Animations-Engine)
+ *
+ * Ein niederpriorer Task rendert mit config::LED_FRAME_RATE_HZ. Es gibt drei
+ * Ebenen (höchste Priorität zuerst):
+ *  1. Overlay  - zeitlich begrenzter Effekt (z.B. Lichtshow, Fehler-Blinken)
+ *  2. Progress - Fortschrittsanzeige eines Jobs
+ *  3. Basis    - dauerhafter Zustand (bereit, Stift oben/unten, ...)
+ *
+ * Gamma-Korrektur und Helligkeit werden über eine gemeinsame 256-Byte
+ * Lookup-Tabelle angewendet. show() wird nur aufgerufen, wenn sich das
+ * Bild tatsächlich geändert hat.
  */
 
 #include "led.h"
 #include "../core/config.h"
+#include "../core/mailbox.h"
 #include "neopixel.h"
 
+#include <atomic>
+#include <cmath>
+
+#include "esp_log.h"
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "hal.led";
+
 namespace tiny_turtle
 {
     namespace hal
     {
-        // NeoPixel-Instanz
-        static NeoPixel s_pixels(1, config::NEOPIXEL_PIN);
+        //===========================================================================
+        // Mailbox-Nachrichten
+        //===========================================================================
+
+        enum class LedMessageType : uint8_t
+        {
+            BASE,
+            OVERLAY,
+            PROGRESS,
+            BRIGHTNESS,
+        };
+
+        struct LedMessage
+        {
+            LedMessageType type;
+            LedEffect effect;
+            uint8_t r, g, b;
+            uint16_t param; // Overlay-Dauer (ms), Fortschritt oder Helligkeit
+        };
+
+        struct LedLayer
+        {
+            LedEffect effect;
+            uint8_t r, g, b;
+        };
+
+        //===========================================================================
+        // Statische Daten
+        //===========================================================================
+
+        // NeoPixel-Instanz (gehört exklusiv dem Animations-Task)
+        static uint8_t s_pixel_buffer[config::NEOPIXEL_COUNT * NeoPixel::BYTES_PER_PIXEL];
+        static NeoPixel s_pixels(config::NEOPIXEL_PIN, config::NEOPIXEL_COUNT, s_pixel_buffer);
+
+        static Mailbox<LedMessage, 16> s_mailbox;
+        static std::atomic<uint32_t> s_dropped{0};
+        static TaskHandle_t s_task = nullptr;
+        static StackType_t s_task_stack[config::LED_TASK_STACK_SIZE];
+        static StaticTask_t s_task_buffer;
+
+        // Renderer-Zustand (nur im Animations-Task verwendet)
+        static LedLayer s_base = {LedEffect::OFF, 0, 0, 0};
+        static LedLayer s_overlay = {LedEffect::OFF, 0, 0, 0};
+        static uint32_t s_overlay_frames = 0;
+        static uint8_t s_progress = 0xFF; // 0xFF = keine Fortschrittsanzeige
+        static uint32_t s_frame = 0;
+
+        static uint8_t s_output_lut[256]; // Gamma + Helligkeit
+        static uint8_t s_breathe_lut[64]; // Eine Atem-Periode
+        static uint8_t s_sparkle[config::NEOPIXEL_COUNT][3];
+        static uint8_t s_last_frame[config::NEOPIXEL_COUNT][3];
+        static bool s_last_frame_valid = false;
+
+        static constexpr uint32_t FRAMES_PER_SECOND = config::LED_FRAME_RATE_HZ;
+        static constexpr uint32_t BREATHE_PERIOD_FRAMES = FRAMES_PER_SECOND * 2; // 2 s
+        static constexpr uint32_t BLINK_HALF_PERIOD_FRAMES = FRAMES_PER_SECOND / 4; // 2 Hz
+        static constexpr uint32_t SPARKLE_PERIOD_FRAMES = FRAMES_PER_SECOND / 10;   // 100 ms
+
+        //===========================================================================
+        // Status-Tabelle (Farben vor Gamma, ergeben mit LED_BRIGHTNESS die alten Rohwerte)
+        //===========================================================================
+
+        static const LedLayer STATUS_TABLE[] = {
+            {LedEffect::SOLID, 0, 180, 0},     // READY    (~0,32,0)
+            {LedEffect::SOLID, 125, 125, 125}, // PEN_UP   (~15,15,15)
+            {LedEffect::SOLID, 216, 216, 216}, // PEN_DOWN (~50,50,50)
+            {LedEffect::BREATHE, 0, 64, 255},  // BUSY
+            {LedEffect::BLINK, 255, 0, 0},     // ERROR
+            {LedEffect::SPARKLE, 0, 0, 0},     // MUSIC
+        };
+
+        //===========================================================================
+        // Lookup-Tabellen
+        //===========================================================================
+
+        static void buildOutputLut(uint8_t brightness)
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                float linear = powf(i / 255.0f, config::LED_GAMMA) * 255.0f;
+                s_output_lut[i] = static_cast<uint8_t>((linear * brightness) / 255.0f + 0.5f);
+            }
+        }
+
+        static void buildBreatheLut()
+        {
+            for (int i = 0; i < 64; i++)
+            {
+                float phase = 2.0f * config::PI * i / 64.0f;
+                s_breathe_lut[i] = static_cast<uint8_t>(24 + 231 * (0.5f - 0.5f * cosf(phase)));
+            }
+        }
+
+        static inline uint8_t scale8(uint8_t value, uint8_t scale)
+        {
+            return static_cast<uint8_t>((value * (scale + 1)) >> 8);
+        }
+
+        //===========================================================================
+        // Renderer
+        //===========================================================================
+
+        static void handleMessage(const LedMessage &msg)
+        {
+            switch (msg.type)
+            {
+            case LedMessageType::BASE:
+                s_base = {msg.effect, msg.r, msg.g, msg.b};
+                break;
+            case LedMessageType::OVERLAY:
+                s_overlay = {msg.effect, msg.r, msg.g, msg.b};
+                s_overlay_frames = (msg.param * FRAMES_PER_SECOND + 999) / 1000;
+                break;
+            case LedMessageType::PROGRESS:
+                s_progress = msg.param > 100 ? 0xFF : static_cast<uint8_t>(msg.param);
+                break;
+            case LedMessageType::BRIGHTNESS:
+                buildOutputLut(static_cast<uint8_t>(msg.param));
+                s_last_frame_valid = false;
+                break;
+            }
+        }
+
+        static void renderPixel(const LedLayer &layer, int idx, uint8_t out[3])
+        {
+            uint8_t level = 255;
+
+            switch (layer.effect)
+            {
+            case LedEffect::OFF:
+                level = 0;
+                break;
+            case LedEffect::SOLID:
+                break;
+            case LedEffect::BREATHE:
+                level = s_breathe_lut[(s_frame % BREATHE_PERIOD_FRAMES) * 64 / BREATHE_PERIOD_FRAMES];
+                break;
+            case LedEffect::BLINK:
+                level = ((s_frame / BLINK_HALF_PERIOD_FRAMES) & 1) ? 0 : 255;
+                break;
+            case LedEffect::PROGRESS:
+            {
+                uint32_t filled = s_progress * config::NEOPIXEL_COUNT; // in 1/100 Pixel
+                uint32_t full = filled / 100;
+                if (static_cast<uint32_t>(idx) < full)
+                    level = 255;
+                else if (static_cast<uint32_t>(idx) == full)
+                    level = static_cast<uint8_t>((filled % 100) * 255 / 100);
+                else
+                    level = 0;
+                break;
+            }
+            case LedEffect::SPARKLE:
+                out[0] = s_sparkle[idx][0];
+                out[1] = s_sparkle[idx][1];
+                out[2] = s_sparkle[idx][2];
+                return;
+            }
+
+            out[0] = scale8(layer.r, level);
+            out[1] = scale8(layer.g, level);
+            out[2] = scale8(layer.b, level);
+        }
+
+        static void renderFrame()
+        {
+            if (s_frame % SPARKLE_PERIOD_FRAMES == 0)
+            {
+                for (int i = 0; i < config::NEOPIXEL_COUNT; i++)
+                {
+                    uint32_t rnd = esp_random();
+                    s_sparkle[i][0] = (rnd % 5) * 63;
+                    s_sparkle[i][1] = ((rnd >> 8) % 5) * 63;
+                    s_sparkle[i][2] = ((rnd >> 16) % 5) * 63;
+                }
+            }
+
+            LedLayer layer = s_base;
+            if (s_overlay_frames > 0)
+            {
+                layer = s_overlay;
+                s_overlay_frames--;
+            }
+            else if (s_progress != 0xFF)
+            {
+                // Fortschritt in der Farbe des Basis-Zustands (oder Blau)
+                layer.effect = LedEffect::PROGRESS;
+                if (layer.r == 0 && layer.g == 0 && layer.b == 0)
+                    layer.b = 255;
+            }
+
+            bool changed = !s_last_frame_valid;
+            for (int i = 0; i < config::NEOPIXEL_COUNT; i++)
+            {
+                uint8_t rgb[3];
+                renderPixel(layer, i, rgb);
+
+                for (int c = 0; c < 3; c++)
+                {
+                    rgb[c] = s_output_lut[rgb[c]];
+                    if (rgb[c] != s_last_frame[i][c])
+                    {
+                        s_last_frame[i][c] = rgb[c];
+                        changed = true;
+                    }
+                }
+                s_pixels.setPixelColor(i, s_pixels.Color(rgb[0], rgb[1], rgb[2]));
+            }
+
+            if (changed)
+            {
+                s_pixels.show();
+                s_last_frame_valid = true;
+            }
+        }
+
+        static void ledTask(void *)
+        {
+            const TickType_t period = pdMS_TO_TICKS(1000 / FRAMES_PER_SECOND) > 0
+                                          ? pdMS_TO_TICKS(1000 / FRAMES_PER_SECOND)
+                                          : 1;
+            TickType_t lastWake = xTaskGetTickCount();
+
+            while (true)
+            {
+                LedMessage msg;
+                while (s_mailbox.fetch(msg))
+                {
+                    handleMessage(msg);
+                }
+
+                renderFrame();
+                s_frame++;
+
+                vTaskDelayUntil(&lastWake, period);
+            }
+        }
+
+        static void postMessage(const LedMessage &msg)
+        {
+            if (!s_mailbox.post(msg))
+            {
+                s_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        //===========================================================================
+        // Öffentliche API
+        //===========================================================================
 
         void initLed()
         {
+            if (s_task)
+                return;
+
+            buildOutputLut(config::LED_BRIGHTNESS);
+            buildBreatheLut();
             s_pixels.begin();
-            s_pixels.show();
+
+            s_task = xTaskCreateStatic(ledTask, "led_anim", config::LED_TASK_STACK_SIZE, nullptr,
+                                       config::LED_TASK_PRIORITY, s_task_stack, &s_task_buffer);
+            if (!s_task)
+            {
+                ESP_LOGE(TAG, "LED-Task konnte nicht gestartet werden");
+                return;
+            }
+            ESP_LOGI(TAG, "LED-Animation gestartet (%d Hz)", config::LED_FRAME_RATE_HZ);
+        }
+
+        void setLedEffect(LedEffect effect, uint8_t r, uint8_t g, uint8_t b)
+        {
+            postMessage({LedMessageType::BASE, effect, r, g, b, 0});
+        }
+
+        void flashLedEffect(LedEffect effect, uint8_t r, uint8_t g, uint8_t b, uint16_t durationMs)
+        {
+            postMessage({LedMessageType::OVERLAY, effect, r, g, b, durationMs});
         }
 
         void setLedColor(uint8_t r, uint8_t g, uint8_t b)
         {
-            s_pixels.setPixelColor(0, s_pixels.Color(r, g, b));
-            s_pixels.show();
+            setLedEffect(LedEffect::SOLID, r, g, b);
         }
 
         void ledOff()
         {
-            setLedColor(0, 0, 0);
+            setLedEffect(LedEffect::OFF, 0, 0, 0);
+        }
+
+        void showStatus(LedStatus status)
+        {
+            const LedLayer &entry = STATUS_TABLE[static_cast<int>(status)];
+            setLedEffect(entry.effect, entry.r, entry.g, entry.b);
+        }
+
+        void setLedProgress(uint8_t percent)
+        {
+            postMessage({LedMessageType::PROGRESS, LedEffect::PROGRESS, 0, 0, 0, percent});
+        }
+
+        void setLedBrightness(uint8_t brightness)
+        {
+            postMessage({LedMessageType::BRIGHTNESS, LedEffect::OFF, 0, 0, 0, brightness});
         }
 
-        // Globale Instanz für Legacy-Zugriff
-        NeoPixel &getPixels()
+        uint32_t getLedDroppedMessages()
         {
-            return s_pixels;
+            return s_dropped.load(std::memory_order_relaxed);
         }
 
     } // namespace hal
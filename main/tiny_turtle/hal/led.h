@@ -2,6 +2,10 @@
 /**
  * @file hal/led.h
  * @brief Hardware Abstraction Layer für LED (NeoPixel)
+ *
+ * Die LED wird von einem niederprioren Animations-Task mit fester Bildrate
+ * gerendert. Aufrufer melden nur Zustandsänderungen über eine lock-freie
+ * Mailbox - keine Funktion hier wartet auf das RMT-Peripheral.
  */
 
 #include <cstdint>
@@ -12,7 +16,33 @@ namespace tiny_turtle
     {
 
         /**
-         * @brief LED initialisieren
+         * @brief Animations-Effekte
+         */
+        enum class LedEffect : uint8_t
+        {
+            OFF,      ///< LED aus
+            SOLID,    ///< Feste Farbe
+            BREATHE,  ///< Langsames Pulsieren
+            PROGRESS, ///< Fortschrittsbalken (Helligkeit bei nur einer LED)
+            BLINK,    ///< Schnelles Blinken (Fehler)
+            SPARKLE,  ///< Zufällige Farben (Lichtshow)
+        };
+
+        /**
+         * @brief Semantische Roboter-Zustände mit fester Farbzuordnung
+         */
+        enum class LedStatus : uint8_t
+        {
+            READY,    ///< System bereit (grün)
+            PEN_UP,   ///< Stift oben (dunkles Weiß)
+            PEN_DOWN, ///< Stift unten (helles Weiß)
+            BUSY,     ///< Job läuft (blau, pulsierend)
+            ERROR,    ///< Fehler (rot, blinkend)
+            MUSIC,    ///< Lichtshow während Musik
+        };
+
+        /**
+         * @brief LED initialisieren und Animations-Task starten
          */
         void initLed();
 
@@ -21,6 +51,7 @@ namespace tiny_turtle
          * @param r Rot (0-255)
          * @param g Grün (0-255)
          * @param b Blau (0-255)
+         * @note Nicht-blockierend, wird mit dem nächsten Frame sichtbar
          */
         void setLedColor(uint8_t r, uint8_t g, uint8_t b);
 
@@ -29,6 +60,40 @@ namespace tiny_turtle
          */
         void ledOff();
 
+        /**
+         * @brief Dauerhaften Effekt setzen (Basis-Zustand)
+         * @param effect Animations-Effekt
+         * @param r,g,b Grundfarbe (vor Gamma/Helligkeit)
+         */
+        void setLedEffect(LedEffect effect, uint8_t r, uint8_t g, uint8_t b);
+
+        /**
+         * @brief Zeitlich begrenzten Effekt über den Basis-Zustand legen
+         * @param durationMs Dauer, danach wird der Basis-Zustand wieder angezeigt
+         */
+        void flashLedEffect(LedEffect effect, uint8_t r, uint8_t g, uint8_t b, uint16_t durationMs);
+
+        /**
+         * @brief Zustand anzeigen (Farbe/Effekt aus der Status-Tabelle)
+         */
+        void showStatus(LedStatus status);
+
+        /**
+         * @brief Job-Fortschritt anzeigen
+         * @param percent 0-100, Werte > 100 blenden den Fortschritt wieder aus
+         */
+        void setLedProgress(uint8_t percent);
+
+        /**
+         * @brief Globale Helligkeit setzen (baut die Lookup-Tabelle neu auf)
+         */
+        void setLedBrightness(uint8_t brightness);
+
+        /**
+         * @brief Anzahl verworfener Meldungen (Mailbox voll)
+         */
+        uint32_t getLedDroppedMessages();
+
     } // namespace hal
 } // namespace tiny_turtle
 
@@ -0,0 +1,188 @@
+/**
+ * @file hal/microstep.cpp
+ * @brief Implementierung des Sinus-Mikroschritts
+ *
+ * Alle ISR-Pfade nutzen nur IRAM-Code: ledc_set_duty()/ledc_update_duty()
+ * (CONFIG_LEDC_CTRL_FUNC_IN_IRAM=y), gpio_set_level()
+ * (CONFIG_GPIO_CTRL_FUNC_IN_IRAM=y) und die ROM-Funktion
+ * esp_rom_gpio_connect_out_signal(). Sinustabelle und LEDC-Signalnummer
+ * liegen im DRAM.
+ */
+
+#include "microstep.h"
+
+#if TT_STEPPER_MICROSTEP
+
+#include "stepper.h"
+#include <cmath>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_gpio.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/ledc_periph.h"
+
+static const char *TAG = "hal.microstep";
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        // LEDC-Timer/-Kanäle 0 und 1 gehören Servo und Speaker
+        static constexpr ledc_timer_t MICROSTEP_TIMER = LEDC_TIMER_2;
+        static constexpr ledc_channel_t MICROSTEP_FIRST_CHANNEL = LEDC_CHANNEL_2;
+        static constexpr ledc_timer_bit_t MICROSTEP_RESOLUTION = LEDC_TIMER_10_BIT;
+        static constexpr int32_t MICROSTEP_DUTY_MAX = (1 << MICROSTEP_RESOLUTION) - 1;
+        static constexpr uint32_t MICROSTEP_MASK = MICROSTEPS_PER_CYCLE - 1;
+        static constexpr uint32_t QUARTER_CYCLE = MICROSTEPS_PER_CYCLE / 4;
+
+        // Duty mit Vorzeichen für cos(2π · i / MICROSTEPS_PER_CYCLE)
+        static DRAM_ATTR int16_t s_cos[MICROSTEPS_PER_CYCLE];
+
+        // Spalte im Halbschritt-Muster, auf die der PWM-Kanal je Wicklung gerade zeigt
+        // (Wicklung A: Spalte 0 oder 2, Wicklung B: Spalte 1 oder 3)
+        static DRAM_ATTR uint8_t s_routed[2][2];
+
+        // GPIO-Matrix-Signal des ersten LEDC-Ausgangs (ledc_periph_signal liegt im Flash)
+        static DRAM_ATTR uint32_t s_ledc_signal;
+
+        static inline ledc_channel_t IRAM_ATTR channelOf(uint8_t motor, uint8_t winding)
+        {
+            return static_cast<ledc_channel_t>(MICROSTEP_FIRST_CHANNEL + motor * 2 + winding);
+        }
+
+        // PWM-Kanal auf eine Spule legen, die Gegenspule als GPIO auf 0
+        static void IRAM_ATTR routeWinding(TurtleContext &ctx, uint8_t motor, uint8_t winding, uint8_t column)
+        {
+            uint8_t other = column ^ 2;
+            uint32_t otherPin = ctx.pins.stepper[motor][other];
+            esp_rom_gpio_connect_out_signal(otherPin, SIG_GPIO_OUT_IDX, false, false);
+            gpio_set_level(static_cast<gpio_num_t>(otherPin), 0);
+            esp_rom_gpio_connect_out_signal(ctx.pins.stepper[motor][column],
+                                            s_ledc_signal + channelOf(motor, winding), false, false);
+            s_routed[motor][winding] = column;
+        }
+
+        static void IRAM_ATTR driveWinding(TurtleContext &ctx, uint8_t motor, uint8_t winding, int16_t value)
+        {
+            // Bei 0 bleibt die Spule, wo sie ist - kein Umschalten im Nulldurchgang
+            if (value != 0)
+            {
+                uint8_t column = value > 0 ? winding : winding + 2;
+                if (column != s_routed[motor][winding])
+                    routeWinding(ctx, motor, winding, column);
+            }
+
+            ledc_channel_t ch = channelOf(motor, winding);
+            ledc_set_duty(LEDC_LOW_SPEED_MODE, ch, value < 0 ? -value : value);
+            ledc_update_duty(LEDC_LOW_SPEED_MODE, ch);
+        }
+
+        // Wicklung A führt cos θ, Wicklung B sin θ = cos(θ - 90°)
+        static void IRAM_ATTR applyMicrostep(TurtleContext &ctx, uint8_t motor, uint32_t position)
+        {
+            driveWinding(ctx, motor, 0, s_cos[position]);
+            driveWinding(ctx, motor, 1, s_cos[(position - QUARTER_CYCLE) & MICROSTEP_MASK]);
+        }
+
+        void IRAM_ATTR microstepMotor(TurtleContext &ctx, uint8_t stepper, int direction)
+        {
+            uint8_t idx = stepper - 1;
+            volatile uint16_t &micro = (stepper == 1) ? ctx.hot.microPhase1 : ctx.hot.microPhase2;
+            uint8_t &phase = (stepper == 1) ? ctx.hot.phase1 : ctx.hot.phase2;
+
+            uint32_t position = (micro + direction) & MICROSTEP_MASK;
+            micro = position;
+            phase = position >> MICROSTEP_SHIFT;
+            applyMicrostep(ctx, idx, position);
+        }
+
+        void IRAM_ATTR enterMicrostep(TurtleContext &ctx)
+        {
+            ctx.hot.microPhase1 = ctx.hot.phase1 << MICROSTEP_SHIFT;
+            ctx.hot.microPhase2 = ctx.hot.phase2 << MICROSTEP_SHIFT;
+
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                uint32_t position = m == 0 ? ctx.hot.microPhase1 : ctx.hot.microPhase2;
+                int16_t a = s_cos[position];
+                int16_t b = s_cos[(position - QUARTER_CYCLE) & MICROSTEP_MASK];
+                routeWinding(ctx, m, 0, a >= 0 ? 0 : 2);
+                routeWinding(ctx, m, 1, b >= 0 ? 1 : 3);
+                applyMicrostep(ctx, m, position);
+            }
+        }
+
+        void IRAM_ATTR exitMicrostep(TurtleContext &ctx)
+        {
+            releaseMicrostep(ctx);
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                for (int i = 0; i < 4; i++)
+                    esp_rom_gpio_connect_out_signal(ctx.pins.stepper[m][i], SIG_GPIO_OUT_IDX, false, false);
+
+                // Richtung 0: nur das Muster der aktuellen Phase ausgeben
+                stepMotor<StepMode::HALF>(ctx, m + 1, 0);
+            }
+        }
+
+        void IRAM_ATTR releaseMicrostep(TurtleContext &ctx)
+        {
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                for (uint8_t w = 0; w < 2; w++)
+                {
+                    ledc_set_duty(LEDC_LOW_SPEED_MODE, channelOf(m, w), 0);
+                    ledc_update_duty(LEDC_LOW_SPEED_MODE, channelOf(m, w));
+                }
+            }
+        }
+
+        void initMicrostep(TurtleContext &ctx)
+        {
+            for (uint32_t i = 0; i < MICROSTEPS_PER_CYCLE; i++)
+            {
+                float angle = 2.0f * config::PI * static_cast<float>(i) / MICROSTEPS_PER_CYCLE;
+                s_cos[i] = static_cast<int16_t>(lroundf(cosf(angle) * MICROSTEP_DUTY_MAX));
+            }
+
+            ledc_timer_config_t timerCfg = {
+                .speed_mode = LEDC_LOW_SPEED_MODE,
+                .duty_resolution = MICROSTEP_RESOLUTION,
+                .timer_num = MICROSTEP_TIMER,
+                .freq_hz = config::MICROSTEP_PWM_HZ,
+                .clk_cfg = LEDC_AUTO_CLK};
+            ESP_ERROR_CHECK(ledc_timer_config(&timerCfg));
+
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                for (uint8_t w = 0; w < 2; w++)
+                {
+                    // ledc_channel_config() verlangt einen Pin und legt den Kanal
+                    // sofort darauf - danach wieder an den GPIO zurückgeben
+                    uint8_t pin = ctx.pins.stepper[m][w];
+                    ledc_channel_config_t ch = {
+                        .gpio_num = pin,
+                        .speed_mode = LEDC_LOW_SPEED_MODE,
+                        .channel = channelOf(m, w),
+                        .intr_type = LEDC_INTR_DISABLE,
+                        .timer_sel = MICROSTEP_TIMER,
+                        .duty = 0,
+                        .hpoint = 0};
+                    ESP_ERROR_CHECK(ledc_channel_config(&ch));
+                    esp_rom_gpio_connect_out_signal(pin, SIG_GPIO_OUT_IDX, false, false);
+                    s_routed[m][w] = w;
+                }
+            }
+
+            s_ledc_signal = ledc_periph_signal[LEDC_LOW_SPEED_MODE].sig_out0_idx;
+
+            ESP_LOGI(TAG, "Mikroschritt: %lu pro Vollschritt, PWM %lu Hz",
+                     config::MICROSTEPS_PER_FULL_STEP, config::MICROSTEP_PWM_HZ);
+        }
+
+    } // namespace hal
+} // namespace tiny_turtle
+
+#endif // TT_STEPPER_MICROSTEP
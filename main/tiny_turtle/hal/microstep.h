@@ -0,0 +1,85 @@
+#pragma once
+/**
+ * @file hal/microstep.h
+ * @brief Sinus-Mikroschritt über LEDC-PWM (StepMode::MICRO)
+ *
+ * Statt die Spulen hart ein- und auszuschalten, bekommt jede Wicklung einen
+ * PWM-Strom nach Sinus (A) bzw. Kosinus (B) des elektrischen Winkels. Pro
+ * Wicklung und Motor gibt es einen LEDC-Kanal (2-5, Timer 2); je nach
+ * Vorzeichen wird er über die GPIO-Matrix auf die Spule A oder A' gelegt,
+ * die Gegenspule liegt dann als normaler GPIO auf 0. Der ULN2003 schaltet
+ * dabei nur gegen Masse - die Richtung des Stroms wählt die Spulenhälfte.
+ *
+ * Ein Zyklus hat 8 * MICROSTEPS_PER_HALF_STEP Positionen, die Halbschritt-
+ * Phase (phase1/phase2) bleibt als Position / MICROSTEPS_PER_HALF_STEP
+ * gültig. Mikroschritt ist damit ohne Positionsverlust mit HALF/FULL/WAVE
+ * kombinierbar, gewechselt wird auf einer Halbschritt-Grenze.
+ *
+ * Zur Compile-Zeit aktivieren, z.B. in main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_STEPPER_MICROSTEP=1)
+ * Ohne Flag fährt StepMode::MICRO im Halbschritt und die LEDC-Kanäle bleiben frei.
+ */
+
+#include <cstdint>
+#include "../core/config.h"
+#include "../core/context.h"
+
+#ifndef TT_STEPPER_MICROSTEP
+#define TT_STEPPER_MICROSTEP 0
+#endif
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        constexpr uint32_t MICROSTEPS_PER_HALF_STEP = config::MICROSTEPS_PER_FULL_STEP / 2;
+        constexpr uint32_t MICROSTEPS_PER_CYCLE = 8 * MICROSTEPS_PER_HALF_STEP;
+
+        constexpr uint8_t microstepShift(uint32_t n)
+        {
+            return n <= 1 ? 0 : 1 + microstepShift(n / 2);
+        }
+        constexpr uint8_t MICROSTEP_SHIFT = microstepShift(MICROSTEPS_PER_HALF_STEP);
+
+        static_assert(config::MICROSTEPS_PER_FULL_STEP >= 8 && config::MICROSTEPS_PER_FULL_STEP <= 32 &&
+                          (1u << MICROSTEP_SHIFT) == MICROSTEPS_PER_HALF_STEP,
+                      "MICROSTEPS_PER_FULL_STEP muss 8, 16 oder 32 sein");
+
+#if TT_STEPPER_MICROSTEP
+
+        /**
+         * @brief LEDC-Timer, -Kanäle und Sinustabelle einrichten
+         * @note Aus initStepperTimer() aufgerufen, nachdem die Stepper-GPIOs konfiguriert sind
+         */
+        void initMicrostep(TurtleContext &ctx);
+
+        /**
+         * @brief Einen Mikroschritt auf einem Motor ausführen
+         * @param stepper Motor-Nummer (1 oder 2)
+         * @param direction Richtung (-1, 0, 1)
+         * @note ISR-safe; aktualisiert auch die Halbschritt-Phase
+         */
+        void microstepMotor(TurtleContext &ctx, uint8_t stepper, int direction);
+
+        /**
+         * @brief Beide Motoren an ihrer Halbschritt-Phase auf PWM umschalten
+         * @note ISR-safe
+         */
+        void enterMicrostep(TurtleContext &ctx);
+
+        /**
+         * @brief PWM abschalten, Pins zurück an GPIO mit dem Halbschritt-Muster
+         * @note ISR-safe; die Phase ist der zuletzt erreichte Halbschritt
+         */
+        void exitMicrostep(TurtleContext &ctx);
+
+        /**
+         * @brief Alle Wicklungen stromlos (Duty 0), Pin-Zuordnung bleibt
+         * @note ISR-safe
+         */
+        void releaseMicrostep(TurtleContext &ctx);
+
+#endif
+
+    } // namespace hal
+} // namespace tiny_turtle
@@ -177,8 +177,11 @@ namespace
 
 } // namespace
 
-NeoPixel::NeoPixel(int pin, int pixels)
-    : pin_(pin), count_(pixels), buffer_(pixels * 3, 0) {}
+NeoPixel::NeoPixel(int pin, int pixels, uint8_t *buffer)
+    : pin_(pin), count_(pixels), buffer_(buffer)
+{
+  clear();
+}
 
 NeoPixel::~NeoPixel()
 {
@@ -268,7 +271,7 @@ void NeoPixel::ensure_started()
 
 void NeoPixel::clear()
 {
-    std::fill(buffer_.begin(), buffer_.end(), 0);
+    std::fill(buffer_, buffer_ + count_ * BYTES_PER_PIXEL, 0);
 }
 
 uint32_t NeoPixel::Color(uint8_t r, uint8_t g, uint8_t b) const
@@ -282,9 +285,10 @@ void NeoPixel::setPixelColor(int idx, uint32_t color)
         return;
 
     // WS2812 erwartet GRB-Reihenfolge!
-    buffer_[idx * 3 + 0] = (color >> 8) & 0xFF;  // G
-    buffer_[idx * 3 + 1] = (color >> 16) & 0xFF; // R
-    buffer_[idx * 3 + 2] = color & 0xFF;         // B
+    uint8_t *pixel = buffer_ + idx * BYTES_PER_PIXEL;
+    pixel[0] = (color >> 8) & 0xFF;  // G
+    pixel[1] = (color >> 16) & 0xFF; // R
+    pixel[2] = color & 0xFF;         // B
 }
 
 void NeoPixel::show()
@@ -305,8 +309,8 @@ void NeoPixel::show()
         },
     };
 
-    esp_err_t ret = rmt_transmit(rmt_channel_, rmt_encoder_, buffer_.data(),
-                                 buffer_.size(), &tx_config);
+    esp_err_t ret = rmt_transmit(rmt_channel_, rmt_encoder_, buffer_,
+                                 count_ * BYTES_PER_PIXEL, &tx_config);
     if (ret != ESP_OK)
     {
         ESP_LOGE(TAG, "Fehler beim Senden: %s", esp_err_to_name(ret));
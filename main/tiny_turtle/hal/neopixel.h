@@ -8,7 +8,6 @@
  */
 
 #include <cstdint>
-#include <vector>
 
 #include "driver/rmt_tx.h"
 #include "esp_err.h"
@@ -21,12 +20,15 @@
 class NeoPixel
 {
 public:
+  static constexpr int BYTES_PER_PIXEL = 3; // GRB
+
   /**
    * @brief Konstruktor
    * @param pin GPIO-Pin für die Datenleitung
    * @param pixels Anzahl der LEDs in der Kette
+   * @param buffer Farbpuffer mit pixels * BYTES_PER_PIXEL Bytes (statisch, gehört dem Aufrufer)
    */
-  NeoPixel(int pin, int pixels);
+  NeoPixel(int pin, int pixels, uint8_t *buffer);
 
   /**
    * @brief Destruktor - gibt RMT-Ressourcen frei
@@ -73,7 +75,7 @@ public:
 private:
   int pin_;
   int count_;
-  std::vector<uint8_t> buffer_; // RGB-Daten
+  uint8_t *buffer_; // GRB-Daten (vom Aufrufer, kein Heap)
 
   // RMT-Handles
   rmt_channel_handle_t rmt_channel_{nullptr};
@@ -12,35 +12,43 @@ namespace tiny_turtle
     namespace hal
     {
 
-        void initSensors()
+        void initSensors(const TurtleContext &ctx)
         {
-            pinMode(config::SWITCH_FRONT, INPUT_PULLUP);
-            pinMode(config::SWITCH_BACK, INPUT_PULLUP);
-            // Foto-Sensor wird über ADC gelesen, keine Init nötig
+            pinMode(ctx.pins.switchFront, INPUT_PULLUP);
+            pinMode(ctx.pins.switchBack, INPUT_PULLUP);
+            // ADC-Einheit und -Kanal schon beim Start einrichten, nicht erst beim ersten Lesen
+            analogReadInit(ctx.pins.photoSensor);
         }
 
-        BumperState readBumpers()
+        BumperState readBumpers(const TurtleContext &ctx)
         {
             return {
-                .front = !digitalRead(config::SWITCH_FRONT),
-                .back = !digitalRead(config::SWITCH_BACK)};
+                .front = !digitalRead(ctx.pins.switchFront),
+                .back = !digitalRead(ctx.pins.switchBack)};
         }
 
-        bool isBumperPressed()
+        bool isBumperPressed(const TurtleContext &ctx)
         {
-            return !digitalRead(config::SWITCH_FRONT) || !digitalRead(config::SWITCH_BACK);
+            return !digitalRead(ctx.pins.switchFront) || !digitalRead(ctx.pins.switchBack);
         }
 
-        int readPhotoSensor()
+        int readPhotoSensor(const TurtleContext &ctx)
         {
-            return analogRead(config::PHOTO_SENSOR);
+            return analogRead(ctx.pins.photoSensor);
         }
 
-        bool isDarkDetected()
+        bool isDarkDetected(const TurtleContext &ctx)
         {
-            return analogRead(config::PHOTO_SENSOR) < config::SENSOR_THRESHOLD;
+            return analogRead(ctx.pins.photoSensor) < config::SENSOR_THRESHOLD;
         }
 
+        // Kurzformen auf defaultContext()
+        void initSensors() { initSensors(defaultContext()); }
+        BumperState readBumpers() { return readBumpers(defaultContext()); }
+        bool isBumperPressed() { return isBumperPressed(defaultContext()); }
+        int readPhotoSensor() { return readPhotoSensor(defaultContext()); }
+        bool isDarkDetected() { return isDarkDetected(defaultContext()); }
+
     } // namespace hal
 } // namespace tiny_turtle
 
@@ -6,36 +6,42 @@
 
 #include <cstdint>
 #include "../core/types.h"
+#include "../core/context.h"
 
 namespace tiny_turtle
 {
     namespace hal
     {
         /**
-         * @brief Sensoren initialisieren (GPIO konfigurieren)
+         * @brief Sensoren initialisieren (GPIO und ADC-Einheit konfigurieren)
          */
+        void initSensors(const TurtleContext &ctx);
         void initSensors();
 
         /**
          * @brief Bumper-Schalter abfragen
          * @return BumperState mit front/back Zuständen
          */
+        BumperState readBumpers(const TurtleContext &ctx);
         BumperState readBumpers();
 
         /**
          * @brief Prüfen ob irgendein Bumper gedrückt ist
          */
+        bool isBumperPressed(const TurtleContext &ctx);
         bool isBumperPressed();
 
         /**
          * @brief Fotosensor lesen
          * @return ADC-Wert (0-4095)
          */
+        int readPhotoSensor(const TurtleContext &ctx);
         int readPhotoSensor();
 
         /**
          * @brief Prüfen ob Fotosensor etwas Dunkles erkennt
          */
+        bool isDarkDetected(const TurtleContext &ctx);
         bool isDarkDetected();
 
     } // namespace hal
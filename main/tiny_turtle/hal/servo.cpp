@@ -7,8 +7,11 @@
 #include "stepper.h"
 #include "led.h"
 #include "../core/config.h"
-#include "../core/globals.h"
+#include "../core/context.h"
 #include "gpio_hal.h"
+#include "../monitor/trace.h"
+#include "../monitor/perf.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -16,59 +19,114 @@ namespace tiny_turtle
 {
     namespace hal
     {
-        // Servo-Instanz (aus Arduino-Compat)
+        // Servo-Instanz des Standard-Roboters (aus Arduino-Compat)
         static Servo s_servo;
 
-        void initServo()
+        static monitor::PerfCounter s_pen_moves("pen.moves");
+        static monitor::PerfCounter s_pen_wait_ms("pen.wait_ms");
+
+        static Servo &servoOf(TurtleContext &ctx)
+        {
+            if (!ctx.hal.servo)
+                ctx.hal.servo = &s_servo;
+            return *ctx.hal.servo;
+        }
+
+        // Bewegung anstoßen, ohne zu warten - das Servo bleibt bis waitServo() angesteuert
+        static void startServo(TurtleContext &ctx, int angle)
+        {
+            Servo &servo = servoOf(ctx);
+            servo.attach(ctx.pins.servo);
+            servo.write(angle);
+            ctx.hal.servoSettleUs = esp_timer_get_time() + config::SERVO_MOVE_DELAY_MS * 1000LL;
+            s_pen_moves.add();
+        }
+
+        // Restzeit einer laufenden Bewegung abwarten, danach Servo freigeben
+        static void waitServo(TurtleContext &ctx)
+        {
+            if (ctx.hal.servoSettleUs == 0)
+                return;
+
+            int64_t remainingUs = ctx.hal.servoSettleUs - esp_timer_get_time();
+            if (remainingUs > 0)
+            {
+                uint32_t ms = static_cast<uint32_t>((remainingUs + 999) / 1000);
+                vTaskDelay(pdMS_TO_TICKS(ms) ? pdMS_TO_TICKS(ms) : 1);
+                s_pen_wait_ms.add(ms);
+            }
+            servoOf(ctx).detach();
+            ctx.hal.servoSettleUs = 0;
+        }
+
+        static void moveServo(TurtleContext &ctx, int angle)
+        {
+            waitServo(ctx);
+            startServo(ctx, angle);
+            waitServo(ctx);
+        }
+
+        void initServo(TurtleContext &ctx)
         {
-            // Servo wird bei Bedarf attached/detached
+            // Stellung nach dem Einschalten ist unbekannt: Stift heben, aber nicht
+            // darauf warten - die erste Bewegung bzw. der erste Stift-Befehl tut das
+            stopMotors(ctx);
+            startServo(ctx, config::SERVO_PEN_DOWN);
+            ctx.hot.drawing = false;
+            ctx.state.setPen(PenState::UP);
         }
 
-        void penUp()
+        void waitServoSettled(TurtleContext &ctx)
         {
-            stopMotors();
-            setLedColor(15, 15, 15);
+            waitServo(ctx);
+        }
 
-            if (isDrawing)
+        void penUp(TurtleContext &ctx)
+        {
+            stopMotors(ctx);
+            showStatus(LedStatus::PEN_UP);
+
+            if (ctx.hot.drawing)
             {
-                s_servo.attach(config::SERVO_PIN);
-                s_servo.write(config::SERVO_PEN_DOWN);
-                vTaskDelay(pdMS_TO_TICKS(config::SERVO_MOVE_DELAY_MS));
-                s_servo.detach();
+                TT_TRACE_SPAN(PEN_UP, config::SERVO_PEN_DOWN);
+                moveServo(ctx, config::SERVO_PEN_DOWN);
             }
-            isDrawing = false;
-            ::drawing = false; // Legacy global
+            ctx.hot.drawing = false;
+            ctx.state.setPen(PenState::UP);
         }
 
-        void penDown()
+        void penDown(TurtleContext &ctx)
         {
-            stopMotors();
-            setLedColor(50, 50, 50);
+            stopMotors(ctx);
+            showStatus(LedStatus::PEN_DOWN);
 
-            if (!isDrawing)
+            if (!ctx.hot.drawing)
             {
-                s_servo.attach(config::SERVO_PIN);
-                s_servo.write(config::SERVO_PEN_UP);
-                vTaskDelay(pdMS_TO_TICKS(config::SERVO_MOVE_DELAY_MS));
-                s_servo.detach();
+                TT_TRACE_SPAN(PEN_DOWN, config::SERVO_PEN_UP);
+                moveServo(ctx, config::SERVO_PEN_UP);
             }
-            isDrawing = true;
-            ::drawing = true; // Legacy global
+            ctx.hot.drawing = true;
+            ctx.state.setPen(PenState::DOWN);
         }
 
-        PenState getPenState()
+        PenState getPenState(const TurtleContext &ctx)
         {
-            return isDrawing ? PenState::DOWN : PenState::UP;
+            return ctx.hot.drawing ? PenState::DOWN : PenState::UP;
         }
 
-        void setServoAngle(int angle)
+        void setServoAngle(TurtleContext &ctx, int angle)
         {
-            s_servo.attach(config::SERVO_PIN);
-            s_servo.write(angle);
-            vTaskDelay(pdMS_TO_TICKS(config::SERVO_MOVE_DELAY_MS));
-            s_servo.detach();
+            moveServo(ctx, angle);
         }
 
+        // Kurzformen auf defaultContext()
+        void initServo() { initServo(defaultContext()); }
+        void waitServoSettled() { waitServoSettled(defaultContext()); }
+        void penUp() { penUp(defaultContext()); }
+        void penDown() { penDown(defaultContext()); }
+        PenState getPenState() { return getPenState(defaultContext()); }
+        void setServoAngle(int angle) { setServoAngle(defaultContext(), angle); }
+
     } // namespace hal
 } // namespace tiny_turtle
 
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include "../core/types.h"
+#include "../core/context.h"
 
 namespace tiny_turtle
 {
@@ -13,29 +14,45 @@ namespace tiny_turtle
     {
 
         /**
-         * @brief Servo initialisieren
+         * @brief Servo initialisieren und Stift heben (nicht blockierend)
+         *
+         * Das Servo fährt im Hintergrund in die obere Stellung; penUp()/penDown(),
+         * setServoAngle() und die Bewegungen in motion/ warten vorher die
+         * Restzeit ab.
          */
+        void initServo(TurtleContext &ctx);
         void initServo();
 
+        /**
+         * @brief Auf das Ende einer laufenden Servo-Bewegung warten
+         * @note Kehrt sofort zurück, wenn das Servo in Ruhe ist
+         */
+        void waitServoSettled(TurtleContext &ctx);
+        void waitServoSettled();
+
         /**
          * @brief Stift anheben
          */
+        void penUp(TurtleContext &ctx);
         void penUp();
 
         /**
          * @brief Stift absenken
          */
+        void penDown(TurtleContext &ctx);
         void penDown();
 
         /**
          * @brief Aktuellen Stift-Zustand abfragen
          */
+        PenState getPenState(const TurtleContext &ctx);
         PenState getPenState();
 
         /**
          * @brief Servo auf bestimmten Winkel setzen
          * @param angle Winkel in Grad (0-180)
          */
+        void setServoAngle(TurtleContext &ctx, int angle);
         void setServoAngle(int angle);
 
     } // namespace hal
@@ -0,0 +1,93 @@
+/**
+ * @file hal/stepdir.cpp
+ * @brief Implementierung der MCPWM-Pulserzeugung für STEP/DIR-Treiber
+ */
+
+#include "stepdir.h"
+
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "driver/mcpwm_prelude.h"
+
+#if !CONFIG_MCPWM_CTRL_FUNC_IN_IRAM
+#error "STEP/DIR-Backend braucht CONFIG_MCPWM_CTRL_FUNC_IN_IRAM=y (Pulse aus der Stepper-ISR)"
+#endif
+
+static const char *TAG = "hal.stepdir";
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        // 10 MHz = 100 ns pro Takt
+        static constexpr uint32_t PULSE_RESOLUTION_HZ = 10000000;
+        static constexpr uint32_t NS_PER_TICK = 1000000000 / PULSE_RESOLUTION_HZ;
+        static constexpr uint32_t RISE_TICKS = config::STEP_DIR_SETUP_NS / NS_PER_TICK;
+        static constexpr uint32_t FALL_TICKS = RISE_TICKS + config::STEP_DIR_PULSE_NS / NS_PER_TICK;
+        static constexpr uint32_t PERIOD_TICKS = FALL_TICKS + 1;
+
+        static_assert(RISE_TICKS > 0, "DIR-Setup-Zeit zu kurz für die MCPWM-Auflösung");
+        static_assert(PERIOD_TICKS * NS_PER_TICK < config::PROFILE.minIntervalUs * 1000,
+                      "STEP-Puls länger als das kürzeste Schrittintervall");
+
+        static DRAM_ATTR mcpwm_timer_handle_t s_pulse_timers[2];
+
+        void IRAM_ATTR pulseStepDir(uint8_t motor)
+        {
+            // Läuft einmal von 0 bis PERIOD_TICKS und bleibt dann stehen
+            mcpwm_timer_start_stop(s_pulse_timers[motor], MCPWM_TIMER_START_STOP_FULL);
+        }
+
+        void initStepDir(TurtleContext &ctx)
+        {
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                mcpwm_timer_config_t timerCfg = {};
+                timerCfg.group_id = 0;
+                timerCfg.clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT;
+                timerCfg.resolution_hz = PULSE_RESOLUTION_HZ;
+                timerCfg.count_mode = MCPWM_TIMER_COUNT_MODE_UP;
+                timerCfg.period_ticks = PERIOD_TICKS;
+                ESP_ERROR_CHECK(mcpwm_new_timer(&timerCfg, &s_pulse_timers[m]));
+
+                mcpwm_operator_config_t operCfg = {};
+                operCfg.group_id = 0;
+                mcpwm_oper_handle_t oper = nullptr;
+                ESP_ERROR_CHECK(mcpwm_new_operator(&operCfg, &oper));
+                ESP_ERROR_CHECK(mcpwm_operator_connect_timer(oper, s_pulse_timers[m]));
+
+                mcpwm_comparator_config_t cmpCfg = {};
+                cmpCfg.flags.update_cmp_on_tez = true;
+                mcpwm_cmpr_handle_t rise = nullptr;
+                mcpwm_cmpr_handle_t fall = nullptr;
+                ESP_ERROR_CHECK(mcpwm_new_comparator(oper, &cmpCfg, &rise));
+                ESP_ERROR_CHECK(mcpwm_new_comparator(oper, &cmpCfg, &fall));
+                ESP_ERROR_CHECK(mcpwm_comparator_set_compare_value(rise, RISE_TICKS));
+                ESP_ERROR_CHECK(mcpwm_comparator_set_compare_value(fall, FALL_TICKS));
+
+                // STEP-Pin wandert von GPIO an den Generator
+                mcpwm_generator_config_t genCfg = {};
+                genCfg.gen_gpio_num = ctx.pins.stepper[m][0];
+                mcpwm_gen_handle_t gen = nullptr;
+                ESP_ERROR_CHECK(mcpwm_new_generator(oper, &genCfg, &gen));
+                ESP_ERROR_CHECK(mcpwm_generator_set_action_on_timer_event(
+                    gen, MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_EVENT_EMPTY, MCPWM_GEN_ACTION_LOW)));
+                ESP_ERROR_CHECK(mcpwm_generator_set_action_on_compare_event(
+                    gen, MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, rise, MCPWM_GEN_ACTION_HIGH)));
+                ESP_ERROR_CHECK(mcpwm_generator_set_action_on_compare_event(
+                    gen, MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, fall, MCPWM_GEN_ACTION_LOW)));
+
+                ESP_ERROR_CHECK(mcpwm_timer_enable(s_pulse_timers[m]));
+            }
+
+            ESP_LOGI(TAG, "STEP-Pulse: %lu ns Setup, %lu ns hoch (%s)", config::STEP_DIR_SETUP_NS,
+                     config::STEP_DIR_PULSE_NS, config::PROFILE.name);
+        }
+
+    } // namespace hal
+} // namespace tiny_turtle
+
+#endif // TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
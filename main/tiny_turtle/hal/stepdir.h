@@ -0,0 +1,42 @@
+#pragma once
+/**
+ * @file hal/stepdir.h
+ * @brief STEP-Pulse für STEP/DIR-Treiber aus der MCPWM-Hardware
+ *
+ * Je Motor läuft ein MCPWM-Timer im Einzelschuss-Modus (START_STOP_FULL):
+ * die ISR stößt ihn an, den Puls formt die Hardware - STEP geht nach
+ * config::STEP_DIR_SETUP_NS hoch und nach weiteren config::STEP_DIR_PULSE_NS
+ * wieder herunter. Die ISR wartet nicht auf das Pulsende, damit sind
+ * Schrittraten von einigen 10 kHz möglich.
+ *
+ * Nur mit TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR (core/config.h).
+ */
+
+#include <cstdint>
+#include "../core/config.h"
+#include "../core/context.h"
+
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        /**
+         * @brief MCPWM-Timer und -Generatoren auf den STEP-Pins einrichten
+         * @note Aus initStepperTimer() aufgerufen, DIR/EN sind dann schon GPIO-Ausgänge
+         */
+        void initStepDir(TurtleContext &ctx);
+
+        /**
+         * @brief Einen STEP-Puls auslösen
+         * @param motor Motor-Index (0 oder 1)
+         * @note ISR-safe (CONFIG_MCPWM_CTRL_FUNC_IN_IRAM)
+         */
+        void pulseStepDir(uint8_t motor);
+
+    } // namespace hal
+} // namespace tiny_turtle
+
+#endif
@@ -1,13 +1,33 @@
 /**
  * @file hal/stepper.cpp
  * @brief Implementierung der Schrittmotor-Steuerung
+ *
+ * Flash-Sicherheit: die Timer-ISR ist als IRAM-safe registriert
+ * (CONFIG_GPTIMER_ISR_IRAM_SAFE) und läuft auch während NVS-/Partitions-
+ * Schreibzugriffen weiter. Alles, was sie erreicht, liegt deshalb im IRAM
+ * bzw. DRAM:
+ * - eigene Funktionen IRAM_ATTR, Tabellen DRAM_ATTR, Kontext im .bss
+ * - Header-Helfer (SeqLock, TraceRing, Histogram, Backends) TT_ISR_INLINE
+ * - gpio_set_level() und gptimer_set_alarm_action() per
+ *   CONFIG_GPIO_CTRL_FUNC_IN_IRAM / CONFIG_GPTIMER_CTRL_FUNC_IN_IRAM,
+ *   LEDC und MCPWM analog (hal/microstep.cpp, hal/stepdir.cpp)
+ * - ohne Sprungtabellen übersetzt (-fno-jump-tables in main/CMakeLists.txt),
+ *   die sonst als Konstanten im Flash landen würden
+ * Geprüft wird das auf dem Gerät von demos::runFlashSafetyTest().
  */
 
 #include "stepper.h"
+#include "stepper_backend.h"
+#include "microstep.h"
+#include "stepdir.h"
 #include "../core/config.h"
-#include "../core/globals.h"
+#include "../core/context.h"
+#include "../monitor/trace.h"
+#include "../monitor/isr_timing.h"
 #include "esp_log.h"
 #include "esp_attr.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
 #include "driver/gpio.h"
 #include "driver/gptimer.h"
 #include "freertos/FreeRTOS.h"
@@ -15,113 +35,474 @@
 
 static const char *TAG = "hal.stepper";
 
+// Debug-LED (DEBUG_LED_PIN) alle 500 ISR-Aufrufe toggeln - kostet einen
+// GPIO-Zugriff pro Alarm, daher nur auf Wunsch (TT_STEPPER_DEBUG_LED=1)
+#ifndef TT_STEPPER_DEBUG_LED
+#define TT_STEPPER_DEBUG_LED 0
+#endif
+
+#if !CONFIG_GPTIMER_ISR_IRAM_SAFE || !CONFIG_GPTIMER_CTRL_FUNC_IN_IRAM || !CONFIG_GPIO_CTRL_FUNC_IN_IRAM
+#error "Stepper-ISR braucht CONFIG_GPTIMER_ISR_IRAM_SAFE, CONFIG_GPTIMER_CTRL_FUNC_IN_IRAM und CONFIG_GPIO_CTRL_FUNC_IN_IRAM (Flash-Schreibzugriffe während der Fahrt)"
+#endif
+
+#if TT_STEPPER_MICROSTEP && TT_STEPPER_BACKEND != TT_STEPPER_BACKEND_UNIPOLAR
+#error "TT_STEPPER_MICROSTEP gibt es nur mit dem Unipolar-Backend"
+#endif
+
 namespace tiny_turtle
 {
     namespace hal
     {
 
         //===========================================================================
-        // Statische Daten (IRAM für ISR-Zugriff)
+        // Statische Daten (DRAM für ISR-Zugriff)
         //===========================================================================
 
-        static const DRAM_ATTR uint8_t STEPPER_PINS[2][4] = {
-            {config::STEP_1A, config::STEP_1B, config::STEP_1C, config::STEP_1D},
-            {config::STEP_2A, config::STEP_2B, config::STEP_2C, config::STEP_2D}};
-
-        static const DRAM_ATTR uint8_t HALF_STEP_PATTERN[8][4] = {
-            {1, 0, 0, 0},
-            {1, 1, 0, 0},
-            {0, 1, 0, 0},
-            {0, 1, 1, 0},
-            {0, 0, 1, 0},
-            {0, 0, 1, 1},
-            {0, 0, 0, 1},
-            {1, 0, 0, 1}};
-
-        // Timer-Handle
-        static gptimer_handle_t s_timer = nullptr;
-
-        // Motor-Zustand (volatile für ISR)
-        static volatile MotorCommand s_command = MotorCommand::STOP;
-        static volatile int s_motor1_dir = 0;
-        static volatile int s_motor2_dir = 0;
-        static volatile bool s_timer_running = false;
-        static volatile int32_t s_step_count = 0;
-
-        // Geschwindigkeits-Einstellungen
-        static volatile uint32_t s_current_speed_us = config::DEFAULT_STEP_DELAY_US;
-        static volatile uint32_t s_target_speed_us = config::DEFAULT_STEP_DELAY_US;
-        static volatile uint32_t s_start_speed_us = 5000;
-        static constexpr uint32_t MIN_SPEED_US = 500;
-        static constexpr uint32_t MAX_SPEED_US = 10000;
-
-        // Rampen-Parameter
-        static volatile uint32_t s_ramp_steps = 0;
-        static volatile uint32_t s_ramp_counter = 0;
-        static volatile bool s_ramping_up = false;
-        static volatile bool s_ramping_down = false;
-        static volatile bool s_smooth_stop = false;
+        static constexpr uint32_t MIN_SPEED_US = config::PROFILE.minIntervalUs;
+        static constexpr uint32_t MAX_SPEED_US = config::PROFILE.maxIntervalUs;
+
+        // Intervalle als Festkomma in Timer-Takten (Q24.8, siehe config::intervalToFx)
+        static constexpr uint32_t TICKS_PER_US = config::TIMER_TICKS_PER_US;
+        static constexpr uint32_t FX_SHIFT = config::INTERVAL_FX_SHIFT;
+        static constexpr uint32_t FX_FRAC_MASK = (1u << FX_SHIFT) - 1;
+        static constexpr uint32_t FX_PER_US = config::INTERVAL_FX_PER_US;
+        static_assert(static_cast<uint64_t>(MAX_SPEED_US) * FX_PER_US < (1ull << 31),
+                      "Festkomma-Intervall muss in int32 passen");
+
+        static constexpr uint32_t toFx(uint32_t us)
+        {
+            return config::intervalToFx(us);
+        }
+
+        static inline uint32_t IRAM_ATTR fromFx(uint32_t fx)
+        {
+            return (fx + FX_PER_US / 2) / FX_PER_US;
+        }
+
+        // Untergrenze pro Halbschritt-Einheit - mit Vollschritt darf die Einheit
+        // halb so lang sein, die Alarmrate bleibt dieselbe. Mikroschritt teilt
+        // die Einheit in mehrere Alarme und braucht längere Intervalle.
+        static inline uint32_t IRAM_ATTR minSpeedUs(const HotState &hot)
+        {
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+            // Der Treiber teilt selbst, es gibt nur eine Schrittfolge
+            return MIN_SPEED_US;
+#else
+            switch (hot.stepMode)
+            {
+            case StepMode::HALF:
+                return MIN_SPEED_US;
+            case StepMode::MICRO:
+                return TT_STEPPER_MICROSTEP ? config::MICROSTEP_MIN_US : MIN_SPEED_US;
+            default:
+                return MIN_SPEED_US / 2;
+            }
+#endif
+        }
+
+        static inline gptimer_handle_t timerOf(const TurtleContext &ctx)
+        {
+            return ctx.hal.timer;
+        }
+
+        // Pin-Senke der Backends auf dem Gerät (hal/stepper_backend.h)
+        struct GpioSink
+        {
+            TT_ISR_INLINE void write(uint8_t pin, bool level)
+            {
+                gpio_set_level(static_cast<gpio_num_t>(pin), level);
+            }
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+            TT_ISR_INLINE void pulse(uint8_t motor)
+            {
+                pulseStepDir(motor);
+            }
+#endif
+        };
+
+        static GpioSink s_gpio;
 
         //===========================================================================
         // Low-Level Motor-Funktionen
         //===========================================================================
 
-        void IRAM_ATTR stepMotor(uint8_t stepper, int direction)
+        //---------------------------------------------------------------------------
+        // Schrittfolgen: alle laufen auf dem Halbschritt-Muster. Gerade Phasen haben
+        // eine aktive Spule (Wave), ungerade zwei (Vollschritt). Vollschritt-Folgen
+        // springen um zwei Phasen und bleiben so auf ihrer Parität - der Phasen-Index
+        // bleibt über Modus-Wechsel hinweg gültig. Mikroschritt teilt jede Einheit
+        // in 2^SHIFT Alarme (hal/microstep.h).
+        //---------------------------------------------------------------------------
+
+        template <StepMode Mode>
+        struct StepSequence;
+
+        template <>
+        struct StepSequence<StepMode::HALF>
+        {
+            static constexpr int STRIDE = 1;
+            static constexpr uint8_t SHIFT = 0;
+        };
+
+        template <>
+        struct StepSequence<StepMode::FULL>
+        {
+            static constexpr int STRIDE = 2;
+            static constexpr uint8_t SHIFT = 0;
+            static constexpr uint8_t PARITY = 1;
+        };
+
+        template <>
+        struct StepSequence<StepMode::WAVE>
+        {
+            static constexpr int STRIDE = 2;
+            static constexpr uint8_t SHIFT = 0;
+            static constexpr uint8_t PARITY = 0;
+        };
+
+        template <>
+        struct StepSequence<StepMode::MICRO>
+        {
+            static constexpr int STRIDE = 1;
+#if TT_STEPPER_MICROSTEP
+            static constexpr uint8_t SHIFT = MICROSTEP_SHIFT;
+#else
+            static constexpr uint8_t SHIFT = 0;
+#endif
+        };
+
+        template <StepMode Mode>
+        void IRAM_ATTR stepMotor(TurtleContext &ctx, uint8_t stepper, int direction)
         {
             uint8_t idx = stepper - 1;
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+            // Schrittfolgen gibt es nur unipolar - ein Aufruf ist ein STEP-Puls
+            StepDirDriver<GpioSink>::step(s_gpio, idx, ctx.pins.stepper[idx], ctx.hot.driverDir[idx], direction);
+#else
+            uint8_t &phase = (stepper == 1) ? ctx.hot.phase1 : ctx.hot.phase2;
+            UnipolarDriver<GpioSink>::step(s_gpio, ctx.pins.stepper[idx], phase, direction * StepSequence<Mode>::STRIDE);
+#endif
+        }
 
-            if (stepper == 1)
+        template void stepMotor<StepMode::HALF>(TurtleContext &, uint8_t, int);
+        template void stepMotor<StepMode::FULL>(TurtleContext &, uint8_t, int);
+        template void stepMotor<StepMode::WAVE>(TurtleContext &, uint8_t, int);
+
+        template <>
+        void IRAM_ATTR stepMotor<StepMode::MICRO>(TurtleContext &ctx, uint8_t stepper, int direction)
+        {
+#if TT_STEPPER_MICROSTEP
+            microstepMotor(ctx, stepper, direction);
+#else
+            stepMotor<StepMode::HALF>(ctx, stepper, direction);
+#endif
+        }
+
+        void IRAM_ATTR stepMotor(TurtleContext &ctx, uint8_t stepper, int direction)
+        {
+            // Ein einzelner Halbschritt kippt die Parität dieses Motors - die Timer-Steuerung
+            // wählt Vollschritt-Folgen danach neu und richtet dabei aus (selectStepMode)
+            if (ctx.hot.activeMode == StepMode::FULL || ctx.hot.activeMode == StepMode::WAVE)
             {
-                stepCount1 = (8 + direction + stepCount1) % 8;
-                const uint8_t *pattern = HALF_STEP_PATTERN[stepCount1];
-                for (int i = 0; i < 4; i++)
-                {
-                    gpio_set_level(static_cast<gpio_num_t>(STEPPER_PINS[idx][i]), pattern[i]);
-                }
+                ctx.hot.activeMode = StepMode::HALF;
+                ctx.hot.activeStride = StepSequence<StepMode::HALF>::STRIDE;
+                ctx.hot.activeShift = StepSequence<StepMode::HALF>::SHIFT;
             }
-            else
+#if TT_STEPPER_MICROSTEP
+            // Blockierende Bewegungen schalten die Spulen direkt - PWM vorher abgeben
+            if (ctx.hot.activeMode == StepMode::MICRO)
             {
-                stepCount2 = (8 + direction + stepCount2) % 8;
-                const uint8_t *pattern = HALF_STEP_PATTERN[stepCount2];
-                for (int i = 0; i < 4; i++)
-                {
-                    gpio_set_level(static_cast<gpio_num_t>(STEPPER_PINS[idx][i]), pattern[i]);
-                }
+                exitMicrostep(ctx);
+                ctx.hot.activeMode = StepMode::HALF;
+                ctx.hot.activeStride = StepSequence<StepMode::HALF>::STRIDE;
+                ctx.hot.activeShift = StepSequence<StepMode::HALF>::SHIFT;
             }
+#endif
+            stepMotor<StepMode::HALF>(ctx, stepper, direction);
         }
 
-        void IRAM_ATTR stopMotors()
+        void IRAM_ATTR stopMotors(TurtleContext &ctx)
+        {
+#if TT_STEPPER_MICROSTEP
+            // Die Pins hängen an der PWM - GPIO-Pegel hätten keine Wirkung
+            if (ctx.hot.activeMode == StepMode::MICRO)
+            {
+                releaseMicrostep(ctx);
+                return;
+            }
+#endif
+            for (int m = 0; m < 2; m++)
+            {
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+                StepDirDriver<GpioSink>::release(s_gpio, ctx.pins.stepper[m], ctx.hot.driverDir[m]);
+#else
+                UnipolarDriver<GpioSink>::release(s_gpio, ctx.pins.stepper[m]);
+#endif
+            }
+        }
+
+        //===========================================================================
+        // Motor-Richtungen
+        //===========================================================================
+
+        static void IRAM_ATTR updateMotorDirections(HotState &hot, MotorCommand cmd)
         {
-            for (int i = 0; i < 4; i++)
+            // Neuer Befehl: ein offener Ausrichtungs-Halbschritt (stepSolo) verfällt
+            hot.lagMotor = 0;
+            hot.soloMotor = 0;
+            switch (cmd)
             {
-                gpio_set_level(static_cast<gpio_num_t>(STEPPER_PINS[0][i]), 0);
-                gpio_set_level(static_cast<gpio_num_t>(STEPPER_PINS[1][i]), 0);
+            case MotorCommand::STOP:
+                hot.motor1Dir = 0;
+                hot.motor2Dir = 0;
+                break;
+            case MotorCommand::FORWARD:
+                hot.motor1Dir = 1;
+                hot.motor2Dir = 1;
+                break;
+            case MotorCommand::BACKWARD:
+                hot.motor1Dir = -1;
+                hot.motor2Dir = -1;
+                break;
+            case MotorCommand::SPIN_CW:
+                hot.motor1Dir = 1;
+                hot.motor2Dir = -1;
+                break;
+            case MotorCommand::SPIN_CCW:
+                hot.motor1Dir = -1;
+                hot.motor2Dir = 1;
+                break;
             }
         }
 
+        //===========================================================================
+        // Abschluss-Ereignisse
+        //===========================================================================
+
+        // Schützt events/waitMask/waiter und das Folgesegment zwischen Task und ISR
+        static portMUX_TYPE s_event_mux = portMUX_INITIALIZER_UNLOCKED;
+
+        static constexpr uint32_t bitOf(StepperEvent event)
+        {
+            return static_cast<uint32_t>(event);
+        }
+
+        static void IRAM_ATTR signalFromISR(TurtleContext &ctx, uint32_t bits, BaseType_t *woken)
+        {
+            portENTER_CRITICAL_ISR(&s_event_mux);
+            ctx.hot.events = ctx.hot.events | bits;
+            TaskHandle_t waiter = (ctx.hot.waitMask & bits) ? ctx.hal.waiter : nullptr;
+            portEXIT_CRITICAL_ISR(&s_event_mux);
+
+            if (waiter)
+                xTaskNotifyIndexedFromISR(waiter, config::NOTIFY_INDEX_STEPPER, bits, eSetBits, woken);
+        }
+
+        static void signalEvents(TurtleContext &ctx, uint32_t bits)
+        {
+            portENTER_CRITICAL(&s_event_mux);
+            ctx.hot.events = ctx.hot.events | bits;
+            TaskHandle_t waiter = (ctx.hot.waitMask & bits) ? ctx.hal.waiter : nullptr;
+            portEXIT_CRITICAL(&s_event_mux);
+
+            if (waiter)
+                xTaskNotifyIndexed(waiter, config::NOTIFY_INDEX_STEPPER, bits, eSetBits);
+        }
+
+        static void clearEvents(TurtleContext &ctx, uint32_t bits)
+        {
+            portENTER_CRITICAL(&s_event_mux);
+            ctx.hot.events = ctx.hot.events & ~bits;
+            portEXIT_CRITICAL(&s_event_mux);
+        }
+
         //===========================================================================
         // Timer ISR
         //===========================================================================
 
-        // Debug: LED-Toggle-Zähler
+#if TT_STEPPER_DEBUG_LED
+        // Debug: LED-Toggle-Zähler (nur einmal vorhanden, unabhängig vom Kontext)
         static volatile uint32_t s_isr_counter = 0;
         static volatile bool s_led_state = false;
+#endif
+
+        // Ein Alarm: beide Motoren einen Schritt der Folge weiter und verbuchen.
+        // Liefert die zurückgelegten Halbschritt-Einheiten (Mikroschritt: 1 nur
+        // beim Erreichen einer Halbschritt-Grenze, sonst 0).
+        template <StepMode Mode>
+        static uint32_t IRAM_ATTR stepBoth(TurtleContext &ctx)
+        {
+            HotState &hot = ctx.hot;
+
+            if (hot.motor1Dir != 0)
+                stepMotor<Mode>(ctx, 1, hot.motor1Dir);
+            if (hot.motor2Dir != 0)
+                stepMotor<Mode>(ctx, 2, hot.motor2Dir);
+
+            int units = StepSequence<Mode>::STRIDE;
+            if (StepSequence<Mode>::SHIFT != 0)
+            {
+                // Beide Motoren laufen im Gleichtakt und sind gemeinsam ausgerichtet
+                uint16_t micro = hot.motor1Dir != 0 ? hot.microPhase1 : hot.microPhase2;
+                units = (micro & ((1u << StepSequence<Mode>::SHIFT) - 1)) == 0;
+            }
+
+            hot.stepCount += hot.motor1Dir * units;
+            ctx.state.stepFromISR(hot.motor1Dir * units, hot.motor2Dir * units, hot.currentSpeedUs, hot.command);
+            return units;
+        }
+
+        // Nach StepMode indiziert (ohne AUTO) - die ISR verzweigt nicht nach Modus
+        static uint32_t (*const DRAM_ATTR STEP_FUNCTIONS[])(TurtleContext &) = {
+            stepBoth<StepMode::HALF>, stepBoth<StepMode::FULL>, stepBoth<StepMode::WAVE>,
+            stepBoth<StepMode::MICRO>};
+        static const DRAM_ATTR uint8_t STEP_STRIDES[] = {
+            StepSequence<StepMode::HALF>::STRIDE, StepSequence<StepMode::FULL>::STRIDE,
+            StepSequence<StepMode::WAVE>::STRIDE, StepSequence<StepMode::MICRO>::STRIDE};
+        static const DRAM_ATTR uint8_t STEP_SHIFTS[] = {
+            StepSequence<StepMode::HALF>::SHIFT, StepSequence<StepMode::FULL>::SHIFT,
+            StepSequence<StepMode::WAVE>::SHIFT, StepSequence<StepMode::MICRO>::SHIFT};
+
+        static constexpr uint32_t AUTO_FULL_BELOW_FX = toFx(config::FULL_STEP_BELOW_US);
+        static constexpr uint32_t AUTO_HALF_ABOVE_FX = toFx(config::FULL_STEP_BELOW_US + config::FULL_STEP_HYSTERESIS_US);
+#if TT_STEPPER_MICROSTEP
+        static constexpr uint32_t AUTO_MICRO_ABOVE_FX = toFx(config::MICROSTEP_ABOVE_US);
+        static constexpr uint32_t AUTO_MICRO_LEAVE_FX = toFx(config::MICROSTEP_ABOVE_US - config::FULL_STEP_HYSTERESIS_US);
+#endif
+
+        static StepMode IRAM_ATTR autoStepMode(const HotState &hot)
+        {
+            uint32_t fullBelow = hot.activeMode == StepMode::FULL ? AUTO_HALF_ABOVE_FX : AUTO_FULL_BELOW_FX;
+            if (hot.intervalFx < fullBelow)
+                return StepMode::FULL;
+#if TT_STEPPER_MICROSTEP
+            uint32_t microAbove = hot.activeMode == StepMode::MICRO ? AUTO_MICRO_LEAVE_FX : AUTO_MICRO_ABOVE_FX;
+            if (hot.intervalFx > microAbove)
+                return StepMode::MICRO;
+#endif
+            return StepMode::HALF;
+        }
+
+        // Ein Alarm im Halbschritt-Takt, in dem nur hot.soloMotor einen Schritt
+        // macht. Ausrichten: der Motor liegt danach eine Einheit vorn, das Segment
+        // zählt weiter für den anderen (lagMotor). Nachholen: der zurückliegende
+        // Motor schließt auf (Segment-Ende oder Wechsel weg vom Vollschritt),
+        // erst das verbraucht die Einheit.
+        static uint32_t IRAM_ATTR stepSolo(TurtleContext &ctx)
+        {
+            HotState &hot = ctx.hot;
+            uint8_t motor = hot.soloMotor;
+            int dir = motor == 1 ? hot.motor1Dir : hot.motor2Dir;
+            hot.soloMotor = 0;
+
+            stepMotor<StepMode::HALF>(ctx, motor, dir);
+            if (motor == 1)
+                hot.stepCount += dir;
+            ctx.state.stepFromISR(motor == 1 ? dir : 0, motor == 2 ? dir : 0, hot.currentSpeedUs, hot.command);
+
+            if (hot.lagMotor == motor)
+            {
+                hot.lagMotor = 0;
+                return 1;
+            }
+            hot.lagMotor = motor == 1 ? 2 : 1;
+            return 0;
+        }
+
+        // Modus für den nächsten Schritt wählen. Vollschritt-Folgen brauchen in
+        // beiden Phasen die passende Parität: passen beide nicht, richtet der
+        // nächste gemeinsame Halbschritt sie aus, passt nur eine, macht der andere
+        // Motor einen Alarm lang allein einen Halbschritt (stepSolo) und der
+        // Wechsel folgt beim nächsten Alarm. Segmente bleiben exakt: segmentSteps
+        // zählt für den zurückliegenden Motor, der vor dem Ende aufholt.
+        // Mikroschritt wird nur auf einer Halbschritt-Grenze verlassen.
+        static void IRAM_ATTR selectStepMode(TurtleContext &ctx)
+        {
+            HotState &hot = ctx.hot;
+            StepMode want = hot.stepMode == StepMode::AUTO ? autoStepMode(hot) : hot.stepMode;
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+            want = StepMode::HALF;
+#elif !TT_STEPPER_MICROSTEP
+            if (want == StepMode::MICRO)
+                want = StepMode::HALF;
+#endif
+            bool stride = want == StepMode::FULL || want == StepMode::WAVE;
+
+            // Zurückliegender Motor holt auf, sobald keine Vollschritt-Folge mehr
+            // läuft oder das Segment dafür zu kurz wird (der vordere Motor hat
+            // eine Einheit weniger offen); danach gilt die gewünschte Folge wieder
+            uint32_t left = hot.segmentSteps;
+            if (hot.lagMotor != 0 && hot.command != MotorCommand::STOP && (!stride || (left != 0 && left < 3)))
+            {
+                hot.soloMotor = hot.lagMotor;
+                want = StepMode::HALF;
+            }
+            else if (stride && left == 1)
+            {
+                // Ein einzelner Rest-Halbschritt eines Segments
+                want = StepMode::HALF;
+            }
 
-        // Debug-LED aus config.h verwenden
+            if (want == hot.activeMode && hot.soloMotor == 0)
+                return;
+
+#if TT_STEPPER_MICROSTEP
+            if (hot.activeMode == StepMode::MICRO &&
+                ((hot.microPhase1 | hot.microPhase2) & (MICROSTEPS_PER_HALF_STEP - 1)) != 0)
+                return;
+#endif
+
+            if (want == StepMode::FULL || want == StepMode::WAVE)
+            {
+                uint8_t parity = want == StepMode::FULL ? StepSequence<StepMode::FULL>::PARITY
+                                                        : StepSequence<StepMode::WAVE>::PARITY;
+                bool wrong1 = (hot.phase1 & 1) != parity;
+                bool wrong2 = (hot.phase2 & 1) != parity;
+                // Ausrichten nur, wenn danach noch Vollschritte bleiben
+                if (wrong1 != wrong2 && hot.lagMotor == 0 && hot.command != MotorCommand::STOP &&
+                    (left == 0 || left >= 4))
+                    hot.soloMotor = wrong1 ? 1 : 2;
+                if (wrong1 || wrong2)
+                    want = StepMode::HALF;
+            }
+
+            if (want != hot.activeMode)
+            {
+#if TT_STEPPER_MICROSTEP
+                if (hot.activeMode == StepMode::MICRO)
+                    exitMicrostep(ctx);
+                else if (want == StepMode::MICRO)
+                    enterMicrostep(ctx);
+#endif
+                hot.activeMode = want;
+                hot.activeStride = STEP_STRIDES[static_cast<uint8_t>(want)];
+                hot.activeShift = STEP_SHIFTS[static_cast<uint8_t>(want)];
+                TT_TRACE_ISR(STEP_MODE, want, hot.currentSpeedUs);
+            }
+        }
 
-        static void IRAM_ATTR updateTimerAlarm(uint32_t intervalUs)
+        static void IRAM_ATTR updateTimerAlarm(gptimer_handle_t timer, uint32_t ticks)
         {
             gptimer_alarm_config_t cfg = {
-                .alarm_count = intervalUs,
+                .alarm_count = ticks,
                 .reload_count = 0,
                 .flags = {.auto_reload_on_alarm = true}};
-            gptimer_set_alarm_action(s_timer, &cfg);
+            gptimer_set_alarm_action(timer, &cfg);
         }
 
         static bool IRAM_ATTR timerISR(gptimer_handle_t timer,
                                        const gptimer_alarm_event_data_t *edata,
-                                       void *ctx)
+                                       void *user)
         {
+#if TT_ISR_TIMING
+            uint32_t entryCycles = esp_cpu_get_cycle_count();
+#endif
+            TurtleContext &ctx = *static_cast<TurtleContext *>(user);
+            HotState &hot = ctx.hot;
+            uint32_t events = 0;
+            BaseType_t woken = pdFALSE;
+
+#if TT_STEPPER_DEBUG_LED
             // Debug: LED alle 500 ISR-Aufrufe toggeln
             s_isr_counter++;
             if (s_isr_counter >= 500)
@@ -130,93 +511,123 @@ namespace tiny_turtle
                 s_led_state = !s_led_state;
                 gpio_set_level(static_cast<gpio_num_t>(config::DEBUG_LED_PIN), s_led_state ? 1 : 0);
             }
+#endif
 
-            // Rampen-Verarbeitung
-            if (s_ramping_up || s_ramping_down)
+            // Rampen-Verarbeitung: Intervall wächst/schrumpft pro Schritt um rampDeltaFx
+            if (hot.rampingUp || hot.rampingDown)
             {
-                s_ramp_counter = s_ramp_counter + 1;
+                hot.rampCounter = hot.rampCounter + 1;
 
-                if (s_ramp_counter >= s_ramp_steps)
+                if (hot.rampCounter >= hot.rampSteps)
                 {
-                    s_current_speed_us = s_ramping_up ? s_target_speed_us : s_start_speed_us;
-                    s_ramping_up = false;
-                    s_ramping_down = false;
-                    s_ramp_counter = 0;
-
-                    if (s_smooth_stop)
+                    hot.intervalFx = toFx(hot.targetSpeedUs);
+                    hot.currentSpeedUs = hot.targetSpeedUs;
+                    hot.rampingUp = false;
+                    hot.rampingDown = false;
+                    hot.rampCounter = 0;
+                    events |= bitOf(StepperEvent::RAMP_DONE);
+                    TT_TRACE_ISR(RAMP_DONE, hot.currentSpeedUs, 0);
+
+                    if (hot.smoothStop)
                     {
-                        s_smooth_stop = false;
-                        s_command = MotorCommand::STOP;
-                        s_motor1_dir = 0;
-                        s_motor2_dir = 0;
+                        hot.smoothStop = false;
+                        hot.command = MotorCommand::STOP;
+                        hot.motor1Dir = 0;
+                        hot.motor2Dir = 0;
+                        hot.lagMotor = 0;
+                        events |= bitOf(StepperEvent::STOPPED);
+
+                        // Abgebrochene Segmente gelten als erledigt
+                        if (hot.segmentSteps != 0)
+                        {
+                            hot.segmentSteps = 0;
+                            hot.nextSteps = 0;
+                            events |= bitOf(StepperEvent::SEGMENT_DONE);
+                        }
+                        TT_TRACE_ISR(SMOOTH_STOP_DONE, hot.stepCount, 0);
                     }
                 }
                 else
                 {
-                    uint32_t diff = s_start_speed_us - s_target_speed_us;
-                    if (s_ramping_up)
-                    {
-                        s_current_speed_us = s_start_speed_us - (diff * s_ramp_counter / s_ramp_steps);
-                    }
-                    else
-                    {
-                        s_current_speed_us = s_target_speed_us + (diff * s_ramp_counter / s_ramp_steps);
-                    }
+                    hot.intervalFx = hot.intervalFx + hot.rampDeltaFx;
+                    hot.currentSpeedUs = fromFx(hot.intervalFx);
                 }
-                updateTimerAlarm(s_current_speed_us);
             }
 
-            if (s_command == MotorCommand::STOP)
+            // Doppelpuffer: intervalFx ist das Schattenregister, alarmTicks das aktive.
+            // Der Zähler wurde gerade auf 0 zurückgesetzt - ein neuer Alarmwert gilt
+            // damit genau für das jetzt beginnende Intervall. Der Nachkomma-Anteil
+            // wird zum nächsten Intervall übertragen, im Mittel stimmt die Frequenz exakt.
+            // Vollschritt: ein Alarm deckt zwei Halbschritt-Einheiten ab,
+            // Mikroschritt: ein Alarm ist 1/2^activeShift Einheit
+            selectStepMode(ctx);
+            uint32_t fx = ((hot.intervalFx * hot.activeStride) >> hot.activeShift) + hot.alarmFrac;
+            uint32_t ticks = fx >> FX_SHIFT;
+            hot.alarmFrac = fx & FX_FRAC_MASK;
+            if (ticks != hot.alarmTicks)
             {
-                return true;
+                hot.alarmTicks = ticks;
+                updateTimerAlarm(timer, ticks);
             }
 
-            if (s_motor1_dir != 0)
-                stepMotor(1, s_motor1_dir);
-            if (s_motor2_dir != 0)
-                stepMotor(2, s_motor2_dir);
-
-            s_step_count += s_motor1_dir;
-
-            return true;
-        }
-
-        //===========================================================================
-        // Motor-Richtungen
-        //===========================================================================
-
-        static void updateMotorDirections(MotorCommand cmd)
-        {
-            switch (cmd)
+            if (hot.command == MotorCommand::STOP)
             {
-            case MotorCommand::STOP:
-                s_motor1_dir = 0;
-                s_motor2_dir = 0;
-                break;
-            case MotorCommand::FORWARD:
-                s_motor1_dir = 1;
-                s_motor2_dir = 1;
-                break;
-            case MotorCommand::BACKWARD:
-                s_motor1_dir = -1;
-                s_motor2_dir = -1;
-                break;
-            case MotorCommand::SPIN_CW:
-                s_motor1_dir = 1;
-                s_motor2_dir = -1;
-                break;
-            case MotorCommand::SPIN_CCW:
-                s_motor1_dir = -1;
-                s_motor2_dir = 1;
-                break;
+                ctx.state.stepFromISR(0, 0, hot.currentSpeedUs, MotorCommand::STOP);
             }
+            else
+            {
+                uint32_t units = hot.soloMotor != 0 ? stepSolo(ctx)
+                                                    : STEP_FUNCTIONS[static_cast<uint8_t>(hot.activeMode)](ctx);
+
+                // Segment-Ende: Folgesegment ohne Pause übernehmen oder anhalten
+                if (hot.segmentSteps != 0 && units != 0)
+                {
+                    hot.segmentSteps = hot.segmentSteps - units;
+                    if (hot.segmentSteps == 0)
+                    {
+                        portENTER_CRITICAL_ISR(&s_event_mux);
+                        if (hot.nextSteps != 0)
+                        {
+                            hot.command = hot.nextCommand;
+                            hot.stepMode = hot.nextMode;
+                            updateMotorDirections(hot, hot.nextCommand);
+                            hot.segmentSteps = hot.nextSteps;
+                            hot.nextSteps = 0;
+                            events |= bitOf(StepperEvent::SEGMENT_DONE);
+                        }
+                        else
+                        {
+                            hot.command = MotorCommand::STOP;
+                            updateMotorDirections(hot, MotorCommand::STOP);
+                            events |= bitOf(StepperEvent::SEGMENT_DONE) | bitOf(StepperEvent::STOPPED);
+                        }
+                        portEXIT_CRITICAL_ISR(&s_event_mux);
+
+                        if (hot.command == MotorCommand::STOP)
+                            stopMotors(ctx);
+                        TT_TRACE_ISR(SEGMENT_DONE, hot.command, hot.stepCount);
+                    }
+                }
+            }
+
+            if (events)
+                signalFromISR(ctx, events, &woken);
+
+#if TT_ISR_TIMING
+            // Auto-Reload auf 0: count_value = Timer-Takte seit dem Alarm beim Eintritt.
+            // Frist ist der gerade programmierte Alarm (Vollschritt zwei, Mikroschritt
+            // 1/2^activeShift Halbschritt-Einheiten), nicht currentSpeedUs
+            monitor::recordIsrTiming(static_cast<uint32_t>(edata->count_value) / TICKS_PER_US,
+                                     esp_cpu_get_cycle_count() - entryCycles, hot.alarmTicks / TICKS_PER_US);
+#endif
+            return woken == pdTRUE;
         }
 
         //===========================================================================
         // Timer-Steuerung
         //===========================================================================
 
-        void initStepperTimer()
+        void initStepperTimer(TurtleContext &ctx)
         {
             ESP_LOGI(TAG, "Initialisiere GPTimer...");
 
@@ -227,29 +638,34 @@ namespace tiny_turtle
             io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
             io_conf.intr_type = GPIO_INTR_DISABLE;
 
-            // Motor 1: Pins konfigurieren
-            io_conf.pin_bit_mask = (1ULL << config::STEP_1A) | (1ULL << config::STEP_1B) |
-                                   (1ULL << config::STEP_1C) | (1ULL << config::STEP_1D);
-            gpio_config(&io_conf);
-            ESP_LOGI(TAG, "Motor 1 GPIOs: %d, %d, %d, %d",
-                     config::STEP_1A, config::STEP_1B, config::STEP_1C, config::STEP_1D);
+            for (int m = 0; m < 2; m++)
+            {
+                const uint8_t *pins = ctx.pins.stepper[m];
+                io_conf.pin_bit_mask = (1ULL << pins[0]) | (1ULL << pins[1]) |
+                                       (1ULL << pins[2]) | (1ULL << pins[3]);
+                gpio_config(&io_conf);
+                ESP_LOGI(TAG, "Motor %d GPIOs: %d, %d, %d, %d", m + 1, pins[0], pins[1], pins[2], pins[3]);
+            }
 
-            // Motor 2: Pins konfigurieren
-            io_conf.pin_bit_mask = (1ULL << config::STEP_2A) | (1ULL << config::STEP_2B) |
-                                   (1ULL << config::STEP_2C) | (1ULL << config::STEP_2D);
-            gpio_config(&io_conf);
-            ESP_LOGI(TAG, "Motor 2 GPIOs: %d, %d, %d, %d",
-                     config::STEP_2A, config::STEP_2B, config::STEP_2C, config::STEP_2D);
+#if TT_STEPPER_MICROSTEP
+            initMicrostep(ctx);
+#endif
+#if TT_STEPPER_BACKEND == TT_STEPPER_BACKEND_STEP_DIR
+            initStepDir(ctx);
+#endif
+            stopMotors(ctx);
 
+#if TT_STEPPER_DEBUG_LED
             // Debug-LED Pin konfigurieren
             io_conf.pin_bit_mask = (1ULL << config::DEBUG_LED_PIN);
             gpio_config(&io_conf);
             ESP_LOGI(TAG, "Debug-LED GPIO: %d", config::DEBUG_LED_PIN);
+#endif
 
             gptimer_config_t cfg = {
                 .clk_src = GPTIMER_CLK_SRC_DEFAULT,
                 .direction = GPTIMER_COUNT_UP,
-                .resolution_hz = 1000000,
+                .resolution_hz = config::STEPPER_TIMER_RESOLUTION_HZ,
                 .intr_priority = 0,
                 .flags = {
                     .intr_shared = false,
@@ -257,156 +673,334 @@ namespace tiny_turtle
                     .backup_before_sleep = false,
                 }};
 
-            ESP_ERROR_CHECK(gptimer_new_timer(&cfg, &s_timer));
+            gptimer_handle_t timer = nullptr;
+            ESP_ERROR_CHECK(gptimer_new_timer(&cfg, &timer));
+            ctx.hal.timer = timer;
 
+            ctx.hot.intervalFx = toFx(ctx.hot.currentSpeedUs);
+            ctx.hot.alarmTicks = ctx.hot.intervalFx >> FX_SHIFT;
+            ctx.hot.alarmFrac = 0;
             gptimer_alarm_config_t alarm = {
-                .alarm_count = s_current_speed_us,
+                .alarm_count = ctx.hot.alarmTicks,
                 .reload_count = 0,
                 .flags = {.auto_reload_on_alarm = true}};
-            ESP_ERROR_CHECK(gptimer_set_alarm_action(s_timer, &alarm));
+            ESP_ERROR_CHECK(gptimer_set_alarm_action(timer, &alarm));
 
+            // Kontext als user_data - die ISR arbeitet nur auf diesem Roboter
             gptimer_event_callbacks_t cbs = {.on_alarm = timerISR};
-            ESP_ERROR_CHECK(gptimer_register_event_callbacks(s_timer, &cbs, nullptr));
-            ESP_ERROR_CHECK(gptimer_enable(s_timer));
+            ESP_ERROR_CHECK(gptimer_register_event_callbacks(timer, &cbs, &ctx));
+            ESP_ERROR_CHECK(gptimer_enable(timer));
 
-            ESP_LOGI(TAG, "GPTimer initialisiert (%lu µs)", s_current_speed_us);
+            ESP_LOGI(TAG, "GPTimer initialisiert (%lu µs, %lu MHz, %s)", ctx.hot.currentSpeedUs,
+                     config::STEPPER_TIMER_RESOLUTION_HZ / 1000000, config::PROFILE.name);
         }
 
-        void startStepperTimer()
+        void startStepperTimer(TurtleContext &ctx)
         {
-            if (!s_timer_running && s_timer)
+            if (!ctx.hot.timerRunning && timerOf(ctx))
             {
-                ESP_ERROR_CHECK(gptimer_start(s_timer));
-                s_timer_running = true;
-                ESP_LOGI(TAG, "Timer gestartet");
+                ESP_ERROR_CHECK(gptimer_start(timerOf(ctx)));
+                ctx.hot.timerRunning = true;
+                ctx.state.setTimerRunning(true);
+                TT_TRACE(TIMER_START, 0, 0);
             }
         }
 
-        void stopStepperTimer()
+        void stopStepperTimer(TurtleContext &ctx)
         {
-            if (s_timer_running && s_timer)
+            if (ctx.hot.timerRunning && timerOf(ctx))
             {
-                ESP_ERROR_CHECK(gptimer_stop(s_timer));
-                s_timer_running = false;
-                stopMotors();
-                ESP_LOGI(TAG, "Timer gestoppt");
+                ESP_ERROR_CHECK(gptimer_stop(timerOf(ctx)));
+                ctx.hot.timerRunning = false;
+                ctx.state.setTimerRunning(false);
+                stopMotors(ctx);
+                ctx.hot.segmentSteps = 0;
+                ctx.hot.nextSteps = 0;
+                signalEvents(ctx, bitOf(StepperEvent::STOPPED) | bitOf(StepperEvent::SEGMENT_DONE));
+                TT_TRACE(TIMER_STOP, 0, 0);
             }
         }
 
-        void setMotorCommand(MotorCommand cmd)
+        void setMotorCommand(TurtleContext &ctx, MotorCommand cmd)
         {
-            s_command = cmd;
-            updateMotorDirections(cmd);
+            // Direkter Befehl = Dauerbetrieb, laufende Segmente verfallen
+            portENTER_CRITICAL(&s_event_mux);
+            bool hadSegment = ctx.hot.segmentSteps != 0;
+            ctx.hot.segmentSteps = 0;
+            ctx.hot.nextSteps = 0;
+            ctx.hot.command = cmd;
+            updateMotorDirections(ctx.hot, cmd);
+            portEXIT_CRITICAL(&s_event_mux);
+            ctx.state.setCommand(cmd);
 
             if (cmd == MotorCommand::STOP)
             {
-                stopMotors();
+                stopMotors(ctx);
+                signalEvents(ctx, bitOf(StepperEvent::STOPPED) | bitOf(StepperEvent::SEGMENT_DONE));
             }
             else
             {
+                clearEvents(ctx, bitOf(StepperEvent::STOPPED));
+                if (hadSegment)
+                    signalEvents(ctx, bitOf(StepperEvent::SEGMENT_DONE));
+
                 // Timer starten wenn noch nicht läuft
-                startStepperTimer();
+                startStepperTimer(ctx);
             }
 
-            static const char *names[] = {"STOP", "FORWARD", "BACKWARD", "SPIN_CW", "SPIN_CCW"};
-            ESP_LOGI(TAG, "Befehl: %s (M1=%d, M2=%d)", names[static_cast<int>(cmd)], s_motor1_dir, s_motor2_dir);
+            TT_TRACE(MOTOR_COMMAND, cmd, static_cast<uint8_t>(ctx.hot.motor1Dir) | (static_cast<uint8_t>(ctx.hot.motor2Dir) << 8));
         }
 
-        void setStepSpeed(uint32_t intervalUs)
+        void setStepSpeed(TurtleContext &ctx, uint32_t intervalUs)
         {
-            if (intervalUs < MIN_SPEED_US)
-                intervalUs = MIN_SPEED_US;
+            if (intervalUs < minSpeedUs(ctx.hot))
+                intervalUs = minSpeedUs(ctx.hot);
             if (intervalUs > MAX_SPEED_US)
                 intervalUs = MAX_SPEED_US;
 
-            s_current_speed_us = intervalUs;
+            // Läuft der Timer, übernimmt die ISR den Wert beim nächsten Alarm -
+            // kein Stop/Start, die Zählerphase bleibt erhalten
+            ctx.hot.intervalFx = toFx(intervalUs);
+            ctx.hot.currentSpeedUs = intervalUs;
+            ctx.state.setStepInterval(intervalUs);
 
-            if (s_timer)
+            gptimer_handle_t timer = timerOf(ctx);
+            if (timer && !ctx.hot.timerRunning)
             {
-                bool wasRunning = s_timer_running;
-                if (wasRunning)
-                    gptimer_stop(s_timer);
-
-                gptimer_alarm_config_t alarm = {
-                    .alarm_count = s_current_speed_us,
-                    .reload_count = 0,
-                    .flags = {.auto_reload_on_alarm = true}};
-                gptimer_set_alarm_action(s_timer, &alarm);
-
-                if (wasRunning)
-                    gptimer_start(s_timer);
+                ctx.hot.alarmTicks = ctx.hot.intervalFx >> FX_SHIFT;
+                ctx.hot.alarmFrac = 0;
+                updateTimerAlarm(timer, ctx.hot.alarmTicks);
             }
 
-            ESP_LOGI(TAG, "Geschwindigkeit: %lu µs/Schritt", s_current_speed_us);
+            TT_TRACE(STEP_SPEED, ctx.hot.currentSpeedUs, 0);
+        }
+
+        void IRAM_ATTR setStepSpeedFromISR(TurtleContext &ctx, uint32_t intervalUs)
+        {
+            if (intervalUs < minSpeedUs(ctx.hot))
+                intervalUs = minSpeedUs(ctx.hot);
+            if (intervalUs > MAX_SPEED_US)
+                intervalUs = MAX_SPEED_US;
+            ctx.hot.intervalFx = toFx(intervalUs);
+            ctx.hot.currentSpeedUs = intervalUs;
         }
 
-        uint32_t getStepSpeed() { return s_current_speed_us; }
-        int32_t getStepCount() { return s_step_count; }
-        void resetStepCount() { s_step_count = 0; }
-        bool isMotorRunning() { return s_timer_running && (s_command != MotorCommand::STOP); }
+        uint32_t getStepSpeed(const TurtleContext &ctx) { return ctx.hot.currentSpeedUs; }
+        int32_t getStepCount(const TurtleContext &ctx) { return ctx.hot.stepCount; }
+        void resetStepCount(TurtleContext &ctx) { ctx.hot.stepCount = 0; }
+        bool isMotorRunning(const TurtleContext &ctx) { return ctx.hot.timerRunning && (ctx.hot.command != MotorCommand::STOP); }
 
         //===========================================================================
         // Rampen-Steuerung
         //===========================================================================
 
-        void setRamp(uint32_t steps)
+        void setRamp(TurtleContext &ctx, uint32_t steps)
         {
-            s_ramp_steps = steps;
-            ESP_LOGI(TAG, "Rampe: %lu Schritte", steps);
+            ctx.hot.rampSteps = steps;
+            TT_TRACE(RAMP, steps, 0);
         }
 
-        void setTargetSpeed(uint32_t targetUs)
+        // Lineare Rampe vom aktuellen Intervall (inkl. Nachkomma) zum Ziel. Die ISR
+        // schreibt intervalFx bei jedem Rampenschritt - Spanne und Rampen-Zustand
+        // deshalb in einem Stück unter s_event_mux. Gibt zurück, ob beschleunigt wird.
+        static bool beginRamp(HotState &hot, uint32_t targetUs, bool smoothStop = false)
         {
-            if (targetUs < MIN_SPEED_US)
-                targetUs = MIN_SPEED_US;
+            portENTER_CRITICAL(&s_event_mux);
+            int32_t span = static_cast<int32_t>(toFx(targetUs)) - static_cast<int32_t>(hot.intervalFx);
+            hot.startSpeedUs = hot.currentSpeedUs;
+            hot.targetSpeedUs = targetUs;
+            hot.rampDeltaFx = span / static_cast<int32_t>(hot.rampSteps);
+            hot.rampCounter = 0;
+            hot.rampingDown = span > 0;
+            hot.rampingUp = span <= 0;
+            if (smoothStop)
+                hot.smoothStop = true;
+            portEXIT_CRITICAL(&s_event_mux);
+            return span <= 0;
+        }
+
+        void setTargetSpeed(TurtleContext &ctx, uint32_t targetUs)
+        {
+            HotState &hot = ctx.hot;
+
+            if (targetUs < minSpeedUs(hot))
+                targetUs = minSpeedUs(hot);
             if (targetUs > MAX_SPEED_US)
                 targetUs = MAX_SPEED_US;
 
-            if (s_ramp_steps == 0)
+            if (hot.rampSteps == 0)
             {
-                setStepSpeed(targetUs);
+                setStepSpeed(ctx, targetUs);
+                signalEvents(ctx, bitOf(StepperEvent::RAMP_DONE));
                 return;
             }
 
-            s_target_speed_us = targetUs;
-            s_ramp_counter = 0;
-
-            if (s_current_speed_us > targetUs)
+            if (hot.currentSpeedUs == targetUs)
             {
-                s_start_speed_us = s_current_speed_us;
-                s_ramping_up = true;
-                s_ramping_down = false;
-                ESP_LOGI(TAG, "Beschleunigung: %lu -> %lu µs", s_start_speed_us, s_target_speed_us);
+                signalEvents(ctx, bitOf(StepperEvent::RAMP_DONE));
+                return;
             }
-            else if (s_current_speed_us < targetUs)
+
+            clearEvents(ctx, bitOf(StepperEvent::RAMP_DONE));
+            uint32_t startUs = hot.currentSpeedUs;
+            if (beginRamp(hot, targetUs))
+                TT_TRACE(ACCELERATE, startUs, targetUs);
+            else
+                TT_TRACE(DECELERATE, startUs, targetUs);
+        }
+
+        bool isRamping(const TurtleContext &ctx) { return ctx.hot.rampingUp || ctx.hot.rampingDown; }
+
+        void smoothStop(TurtleContext &ctx)
+        {
+            HotState &hot = ctx.hot;
+
+            if (hot.rampSteps == 0 || hot.command == MotorCommand::STOP)
             {
-                s_start_speed_us = s_current_speed_us;
-                s_ramping_down = true;
-                s_ramping_up = false;
-                ESP_LOGI(TAG, "Verzögerung: %lu -> %lu µs", s_start_speed_us, s_target_speed_us);
+                setMotorCommand(ctx, MotorCommand::STOP);
+                return;
             }
+
+            clearEvents(ctx, bitOf(StepperEvent::STOPPED) | bitOf(StepperEvent::RAMP_DONE));
+            beginRamp(hot, MAX_SPEED_US, true);
+
+            TT_TRACE(SMOOTH_STOP, hot.rampSteps, 0);
         }
 
-        bool isRamping() { return s_ramping_up || s_ramping_down; }
+        //===========================================================================
+        // Segmente und Warten
+        //===========================================================================
 
-        void smoothStop()
+        void setStepMode(TurtleContext &ctx, StepMode mode)
         {
-            if (s_ramp_steps == 0 || s_command == MotorCommand::STOP)
-            {
-                setMotorCommand(MotorCommand::STOP);
+            ctx.hot.stepMode = mode;
+        }
+
+        StepMode getStepMode(const TurtleContext &ctx) { return ctx.hot.activeMode; }
+
+        void queueSegment(TurtleContext &ctx, MotorCommand cmd, uint32_t steps)
+        {
+            queueSegment(ctx, cmd, steps, ctx.hot.stepMode);
+        }
+
+        void queueSegment(TurtleContext &ctx, MotorCommand cmd, uint32_t steps, StepMode mode)
+        {
+            if (steps == 0 || cmd == MotorCommand::STOP)
                 return;
+
+            HotState &hot = ctx.hot;
+            while (true)
+            {
+                bool started = false;
+                bool queued = false;
+
+                portENTER_CRITICAL(&s_event_mux);
+                if (hot.segmentSteps == 0)
+                {
+                    hot.command = cmd;
+                    hot.stepMode = mode;
+                    updateMotorDirections(hot, cmd);
+                    hot.segmentSteps = steps;
+                    hot.events = hot.events & ~(bitOf(StepperEvent::SEGMENT_DONE) | bitOf(StepperEvent::STOPPED));
+                    started = true;
+                }
+                else if (hot.nextSteps == 0)
+                {
+                    hot.nextCommand = cmd;
+                    hot.nextMode = mode;
+                    hot.nextSteps = steps;
+                    hot.events = hot.events & ~bitOf(StepperEvent::SEGMENT_DONE);
+                    queued = true;
+                }
+                portEXIT_CRITICAL(&s_event_mux);
+
+                if (started)
+                {
+                    ctx.state.setCommand(cmd);
+                    startStepperTimer(ctx);
+                    TT_TRACE(MOTOR_COMMAND, cmd, static_cast<uint8_t>(hot.motor1Dir) | (static_cast<uint8_t>(hot.motor2Dir) << 8));
+                    return;
+                }
+                if (queued)
+                    return;
+
+                // Beide Plätze belegt - bis zum nächsten Segmentwechsel warten
+                waitFor(ctx, StepperEvent::SEGMENT_DONE);
             }
+        }
 
-            s_smooth_stop = true;
-            s_target_speed_us = s_current_speed_us;
-            s_start_speed_us = MAX_SPEED_US;
-            s_ramp_counter = 0;
-            s_ramping_down = true;
-            s_ramping_up = false;
+        bool waitFor(TurtleContext &ctx, StepperEvent event, uint32_t timeoutMs)
+        {
+            const uint32_t bit = bitOf(event);
+            TaskHandle_t self = xTaskGetCurrentTaskHandle();
 
-            ESP_LOGI(TAG, "Sanftes Stoppen (%lu Schritte)", s_ramp_steps);
+            // Reste früherer Wartevorgänge verwerfen, dann anmelden
+            xTaskNotifyStateClearIndexed(self, config::NOTIFY_INDEX_STEPPER);
+            ulTaskNotifyValueClearIndexed(self, config::NOTIFY_INDEX_STEPPER, UINT32_MAX);
+
+            portENTER_CRITICAL(&s_event_mux);
+            bool done = (ctx.hot.events & bit) != 0;
+            if (!done)
+            {
+                ctx.hal.waiter = self;
+                ctx.hot.waitMask = bit;
+            }
+            portEXIT_CRITICAL(&s_event_mux);
+
+            if (done)
+                return true;
+
+            const TickType_t start = xTaskGetTickCount();
+            const TickType_t timeout = timeoutMs == WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs + portTICK_PERIOD_MS - 1);
+            while ((ctx.hot.events & bit) == 0)
+            {
+                TickType_t remaining = portMAX_DELAY;
+                if (timeout != portMAX_DELAY)
+                {
+                    TickType_t elapsed = xTaskGetTickCount() - start;
+                    if (elapsed >= timeout)
+                        break;
+                    remaining = timeout - elapsed;
+                }
+
+                uint32_t bits = 0;
+                if (xTaskNotifyWaitIndexed(config::NOTIFY_INDEX_STEPPER, 0, UINT32_MAX, &bits, remaining) != pdTRUE)
+                    break;
+            }
+
+            portENTER_CRITICAL(&s_event_mux);
+            done = (ctx.hot.events & bit) != 0;
+            ctx.hal.waiter = nullptr;
+            ctx.hot.waitMask = 0;
+            portEXIT_CRITICAL(&s_event_mux);
+            return done;
         }
 
+        //===========================================================================
+        // Kurzformen auf defaultContext()
+        //===========================================================================
+
+        void stepMotor(uint8_t stepper, int direction) { stepMotor(defaultContext(), stepper, direction); }
+        void stopMotors() { stopMotors(defaultContext()); }
+        void initStepperTimer() { initStepperTimer(defaultContext()); }
+        void startStepperTimer() { startStepperTimer(defaultContext()); }
+        void stopStepperTimer() { stopStepperTimer(defaultContext()); }
+        void setMotorCommand(MotorCommand cmd) { setMotorCommand(defaultContext(), cmd); }
+        void setStepSpeed(uint32_t intervalUs) { setStepSpeed(defaultContext(), intervalUs); }
+        uint32_t getStepSpeed() { return getStepSpeed(defaultContext()); }
+        int32_t getStepCount() { return getStepCount(defaultContext()); }
+        void resetStepCount() { resetStepCount(defaultContext()); }
+        bool isMotorRunning() { return isMotorRunning(defaultContext()); }
+        void setRamp(uint32_t steps) { setRamp(defaultContext(), steps); }
+        void setTargetSpeed(uint32_t targetUs) { setTargetSpeed(defaultContext(), targetUs); }
+        bool isRamping() { return isRamping(defaultContext()); }
+        void smoothStop() { smoothStop(defaultContext()); }
+        void setStepMode(StepMode mode) { setStepMode(defaultContext(), mode); }
+        StepMode getStepMode() { return getStepMode(defaultContext()); }
+        void queueSegment(MotorCommand cmd, uint32_t steps) { queueSegment(defaultContext(), cmd, steps); }
+        void queueSegment(MotorCommand cmd, uint32_t steps, StepMode mode) { queueSegment(defaultContext(), cmd, steps, mode); }
+        bool waitFor(StepperEvent event, uint32_t timeoutMs) { return waitFor(defaultContext(), event, timeoutMs); }
+
     } // namespace hal
 } // namespace tiny_turtle
 
@@ -414,12 +1008,12 @@ namespace tiny_turtle
 // Legacy-Kompatibilität
 //===========================================================================
 
-void IRAM_ATTR switchStepper(uint8_t stepper, int direction)
+void switchStepper(uint8_t stepper, int direction)
 {
     tiny_turtle::hal::stepMotor(stepper, direction);
 }
 
-void IRAM_ATTR stopSteppers()
+void stopSteppers()
 {
     tiny_turtle::hal::stopMotors();
 }
@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include "../core/types.h"
+#include "../core/context.h"
 #include "esp_attr.h"
 
 namespace tiny_turtle
@@ -22,68 +23,107 @@ namespace tiny_turtle
 
         /**
          * @brief Einen Schritt auf einem Motor ausführen
+         * @param ctx Turtle-Kontext (Phasen und Pins)
          * @param stepper Motor-Nummer (1 oder 2)
          * @param direction Richtung (-1, 0, 1)
-         * @note ISR-safe, kann aus Interrupts aufgerufen werden
+         * @note Kontext-Variante ist ISR-safe, kann aus Interrupts aufgerufen werden
          */
+        void stepMotor(TurtleContext &ctx, uint8_t stepper, int direction);
         void stepMotor(uint8_t stepper, int direction);
 
+        /**
+         * @brief Einen Schritt einer bestimmten Schrittfolge ausführen
+         *
+         * Zur Compile-Zeit spezialisiert (HALF, FULL, WAVE, MICRO), ohne Verzweigung
+         * nach Modus. FULL/WAVE bewegen um zwei Halbschritt-Einheiten und setzen eine
+         * passende Phasen-Parität voraus (ungerade bzw. gerade). MICRO bewegt um
+         * einen Mikroschritt (hal/microstep.h), ohne TT_STEPPER_MICROSTEP um einen
+         * Halbschritt.
+         * @note ISR-safe
+         */
+        template <StepMode Mode>
+        void stepMotor(TurtleContext &ctx, uint8_t stepper, int direction);
+
         /**
          * @brief Alle Motor-Spulen stromlos schalten
-         * @note ISR-safe, spart Energie wenn Motoren nicht benötigt werden
+         * @note Kontext-Variante ist ISR-safe, spart Energie wenn Motoren nicht benötigt werden
          */
+        void stopMotors(TurtleContext &ctx);
         void stopMotors();
 
         //===========================================================================
         // Timer-basierte Motor-Steuerung
+        //
+        // Jede Funktion gibt es mit explizitem Kontext und als Kurzform,
+        // die auf defaultContext() arbeitet.
         //===========================================================================
 
         /**
          * @brief GPTimer für Motorsteuerung initialisieren
          */
+        void initStepperTimer(TurtleContext &ctx);
         void initStepperTimer();
 
         /**
          * @brief Timer starten (Motoren beginnen zu laufen)
          */
+        void startStepperTimer(TurtleContext &ctx);
         void startStepperTimer();
 
         /**
          * @brief Timer stoppen
          */
+        void stopStepperTimer(TurtleContext &ctx);
         void stopStepperTimer();
 
         /**
          * @brief Motor-Befehl setzen
          * @param cmd Gewünschte Bewegung (FORWARD, BACKWARD, SPIN_CW, etc.)
          */
+        void setMotorCommand(TurtleContext &ctx, MotorCommand cmd);
         void setMotorCommand(MotorCommand cmd);
 
         /**
          * @brief Schrittgeschwindigkeit setzen
+         *
+         * Bei laufendem Timer gilt der neue Wert ab dem nächsten Alarm - der Timer
+         * wird nicht angehalten, kein Intervall wird verkürzt oder verlängert.
+         *
          * @param stepIntervalUs Intervall zwischen Schritten in Mikrosekunden
-         *                       Kleiner = schneller (min: 500, max: 10000)
+         *                       Kleiner = schneller (min: 500, mit Vollschritt 250,
+         *                       mit Mikroschritt config::MICROSTEP_MIN_US; max: 10000)
          */
+        void setStepSpeed(TurtleContext &ctx, uint32_t stepIntervalUs);
         void setStepSpeed(uint32_t stepIntervalUs);
 
+        /**
+         * @brief Schrittgeschwindigkeit aus einem Interrupt setzen (z.B. pro Schritt)
+         * @note ISR-safe; eine laufende Rampe überschreibt den Wert beim nächsten Alarm
+         */
+        void setStepSpeedFromISR(TurtleContext &ctx, uint32_t stepIntervalUs);
+
         /**
          * @brief Aktuelle Geschwindigkeit abfragen
          */
+        uint32_t getStepSpeed(const TurtleContext &ctx);
         uint32_t getStepSpeed();
 
         /**
          * @brief Schrittzähler abfragen
          */
+        int32_t getStepCount(const TurtleContext &ctx);
         int32_t getStepCount();
 
         /**
          * @brief Schrittzähler zurücksetzen
          */
+        void resetStepCount(TurtleContext &ctx);
         void resetStepCount();
 
         /**
          * @brief Prüfen ob Motoren aktiv sind
          */
+        bool isMotorRunning(const TurtleContext &ctx);
         bool isMotorRunning();
 
         //===========================================================================
@@ -94,28 +134,92 @@ namespace tiny_turtle
          * @brief Beschleunigungs-/Verzögerungsrampe aktivieren
          * @param rampSteps Anzahl Schritte für volle Rampe (0 = deaktiviert)
          */
+        void setRamp(TurtleContext &ctx, uint32_t rampSteps);
         void setRamp(uint32_t rampSteps);
 
         /**
          * @brief Zielgeschwindigkeit mit Rampe anfahren
          * @param targetSpeedUs Ziel-Intervall in Mikrosekunden
          */
+        void setTargetSpeed(TurtleContext &ctx, uint32_t targetSpeedUs);
         void setTargetSpeed(uint32_t targetSpeedUs);
 
         /**
          * @brief Prüfen ob Rampe aktiv ist
          */
+        bool isRamping(const TurtleContext &ctx);
         bool isRamping();
 
         /**
          * @brief Sanft stoppen (mit Verzögerungsrampe)
          */
+        void smoothStop(TurtleContext &ctx);
         void smoothStop();
 
+        //===========================================================================
+        // Segmente und Abschluss-Ereignisse
+        //
+        // Die ISR meldet RAMP_DONE, SEGMENT_DONE und STOPPED per Task-Notification
+        // direkt an den wartenden Task - kein Polling, keine Tick-Verzögerung.
+        //===========================================================================
+
+        constexpr uint32_t WAIT_FOREVER = UINT32_MAX;
+
+        /**
+         * @brief Schrittfolge für die Timer-Steuerung wählen
+         *
+         * AUTO wechselt unterhalb von config::FULL_STEP_BELOW_US in den Vollschritt,
+         * oberhalb von config::MICROSTEP_ABOVE_US in den Mikroschritt (falls
+         * TT_STEPPER_MICROSTEP) und dazwischen in den Halbschritt. Intervalle und
+         * Schrittzahlen bleiben in Halbschritt-Einheiten, die Geschwindigkeit springt
+         * beim Wechsel nicht. Gewechselt wird, sobald die Phasen-Parität passt bzw.
+         * der Mikroschritt eine Halbschritt-Grenze erreicht (höchstens ein Halbschritt
+         * später). Passt die Parität nur bei einem Motor, macht der andere vorher
+         * einen Halbschritt allein; Segmente behalten je Motor ihre Schrittzahl.
+         */
+        void setStepMode(TurtleContext &ctx, StepMode mode);
+        void setStepMode(StepMode mode);
+
+        /**
+         * @brief Aktuell von der ISR verwendete Schrittfolge (nie AUTO)
+         */
+        StepMode getStepMode(const TurtleContext &ctx);
+        StepMode getStepMode();
+
+        /**
+         * @brief Segment mit fester Schrittzahl fahren (nicht blockierend)
+         *
+         * Läuft bereits ein Segment, wird das neue als Folgesegment vorgemerkt und
+         * von der ISR im selben Alarm gestartet, in dem das laufende endet. Ist
+         * auch dieser Platz belegt, blockiert der Aufruf bis SEGMENT_DONE.
+         * Nach dem letzten Segment stoppen die Motoren (STOPPED).
+         *
+         * @param cmd Bewegung (FORWARD, BACKWARD, SPIN_CW, SPIN_CCW)
+         * @param steps Schritte in Halbschritt-Einheiten (Motor 1)
+         * @param mode Schrittfolge für dieses Segment (gilt danach weiter, siehe setStepMode)
+         */
+        void queueSegment(TurtleContext &ctx, MotorCommand cmd, uint32_t steps);
+        void queueSegment(MotorCommand cmd, uint32_t steps);
+        void queueSegment(TurtleContext &ctx, MotorCommand cmd, uint32_t steps, StepMode mode);
+        void queueSegment(MotorCommand cmd, uint32_t steps, StepMode mode);
+
+        /**
+         * @brief Blockierend auf ein Ereignis warten
+         *
+         * Kehrt sofort zurück, wenn das Ereignis seit dem letzten passenden Befehl
+         * schon eingetreten ist (setTargetSpeed -> RAMP_DONE, smoothStop/Stopp ->
+         * STOPPED, queueSegment -> SEGMENT_DONE). Pro Kontext wartet höchstens ein Task.
+         *
+         * @param timeoutMs Maximale Wartezeit (WAIT_FOREVER = unbegrenzt)
+         * @return true wenn das Ereignis eingetreten ist, false bei Timeout
+         */
+        bool waitFor(TurtleContext &ctx, StepperEvent event, uint32_t timeoutMs = WAIT_FOREVER);
+        bool waitFor(StepperEvent event, uint32_t timeoutMs = WAIT_FOREVER);
+
     } // namespace hal
 } // namespace tiny_turtle
 
-// Legacy-Kompatibilität (IRAM_ATTR nur in Definition, nicht Deklaration)
+// Legacy-Kompatibilität (arbeiten auf defaultContext(), nicht aus ISRs aufrufen)
 void switchStepper(uint8_t stepper, int direction);
 void stopSteppers();
 
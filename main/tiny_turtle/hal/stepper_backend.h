@@ -0,0 +1,126 @@
+#pragma once
+/**
+ * @file hal/stepper_backend.h
+ * @brief Motortreiber-Backends der Stepper-Steuerung
+ *
+ * Die Timer-ISR (hal/stepper.cpp) rechnet nur in Schritt-Einheiten; wie ein
+ * Schritt an die Hardware geht, entscheidet das Backend:
+ *
+ * - UNIPOLAR: 28BYJ-48 am ULN2003, vier Spulen im Halbschritt-Muster
+ *   (Pins A, B, C, D)
+ * - STEP_DIR: A4988/DRV8825/TMC-Treiber, ein STEP-Puls pro Schritt aus der
+ *   MCPWM-Hardware (Pins STEP, DIR, EN), siehe hal/stepdir.h
+ *
+ * Gewählt wird zur Compile-Zeit über TT_STEPPER_BACKEND (core/config.h), die
+ * Kinematik kommt aus dem passenden config::StepperProfile.
+ *
+ * Die Treiber-Logik hier ist frei von ESP-IDF und schreibt über eine Pin-Senke:
+ *
+ *   struct Sink
+ *   {
+ *       void write(uint8_t pin, bool level); // GPIO-Pegel setzen
+ *       void pulse(uint8_t motor);           // Einen STEP-Puls auslösen
+ *   };
+ *
+ * Auf dem Gerät sind das gpio_set_level() und MCPWM, im Host-Build eine
+ * Mock-Senke, die alle Flanken aufzeichnet (host/mock_pins.h).
+ */
+
+#include <cstdint>
+#include "../core/isr_attr.h"
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        // Spulen A-D je Halbschritt-Phase (gerade: eine Spule, ungerade: zwei)
+        static const DRAM_ATTR uint8_t HALF_STEP_PATTERN[8][4] = {
+            {1, 0, 0, 0},
+            {1, 1, 0, 0},
+            {0, 1, 0, 0},
+            {0, 1, 1, 0},
+            {0, 0, 1, 0},
+            {0, 0, 1, 1},
+            {0, 0, 0, 1},
+            {1, 0, 0, 1}};
+
+        /**
+         * @brief Unipolarer Vierphasen-Antrieb (28BYJ-48)
+         */
+        template <class Sink>
+        struct UnipolarDriver
+        {
+            /**
+             * @brief Phase weiterschalten und das Spulenmuster ausgeben
+             * @param pins Spulen A-D
+             * @param phase Halbschritt-Phase (0-7), wird fortgeschrieben
+             * @param delta Halbschritte (-2 bis 2, 0 = Muster erneut ausgeben)
+             */
+            static TT_ISR_INLINE void step(Sink &sink, const uint8_t pins[4], uint8_t &phase, int delta)
+            {
+                phase = (phase + 8 + delta) & 7;
+                const uint8_t *pattern = HALF_STEP_PATTERN[phase];
+                for (int i = 0; i < 4; i++)
+                    sink.write(pins[i], pattern[i]);
+            }
+
+            /**
+             * @brief Alle Spulen stromlos
+             */
+            static TT_ISR_INLINE void release(Sink &sink, const uint8_t pins[4])
+            {
+                for (int i = 0; i < 4; i++)
+                    sink.write(pins[i], false);
+            }
+        };
+
+        /**
+         * @brief STEP/DIR-Treiber (A4988, DRV8825, TMC2208 im Legacy-Modus)
+         *
+         * Der Zustand je Motor ist der zuletzt ausgegebene DIR-Pegel als -1/1;
+         * 0 heißt Treiber abgeschaltet (EN high). DIR wird nur bei einem
+         * Richtungswechsel geschrieben, immer vor dem Puls - die Setup-Zeit bis
+         * zur steigenden Flanke liefert die Pulserzeugung (config::STEP_DIR_SETUP_NS).
+         */
+        template <class Sink>
+        struct StepDirDriver
+        {
+            static constexpr int PIN_STEP = 0;
+            static constexpr int PIN_DIR = 1;
+            static constexpr int PIN_ENABLE = 2; // low-aktiv
+
+            /**
+             * @brief Einen Schritt ausgeben
+             * @param motor Motor-Index (0 oder 1) für die Pulserzeugung
+             * @param pins STEP, DIR, EN
+             * @param state DIR-Zustand des Motors, wird fortgeschrieben
+             * @param direction Richtung (-1, 0, 1)
+             */
+            static TT_ISR_INLINE void step(Sink &sink, uint8_t motor, const uint8_t pins[4], int8_t &state,
+                                               int direction)
+            {
+                if (direction == 0)
+                    return;
+                if (state == 0)
+                    sink.write(pins[PIN_ENABLE], false);
+                if (direction != state)
+                {
+                    sink.write(pins[PIN_DIR], direction > 0);
+                    state = static_cast<int8_t>(direction);
+                }
+                sink.pulse(motor);
+            }
+
+            /**
+             * @brief Treiber abschalten (Motor stromlos, kein Haltemoment)
+             */
+            static TT_ISR_INLINE void release(Sink &sink, const uint8_t pins[4], int8_t &state)
+            {
+                sink.write(pins[PIN_ENABLE], true);
+                state = 0;
+            }
+        };
+
+    } // namespace hal
+} // namespace tiny_turtle
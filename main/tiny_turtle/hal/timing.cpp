@@ -0,0 +1,114 @@
+/**
+ * @file hal/timing.cpp
+ * @brief Implementierung von sleepUs() über esp_timer
+ */
+
+#include "timing.h"
+#include "../core/config.h"
+
+#include <atomic>
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "hal.timing";
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        /**
+         * @brief Ein Timer pro gleichzeitig schlafendem Task (einmal angelegt)
+         */
+        struct SleepSlot
+        {
+            std::atomic<bool> busy;
+            esp_timer_handle_t timer;
+            TaskHandle_t task;
+        };
+
+        static SleepSlot s_slots[config::SLEEP_TIMER_SLOTS];
+
+        static void sleepTimerCallback(void *arg)
+        {
+            auto *slot = static_cast<SleepSlot *>(arg);
+            xTaskNotifyGiveIndexed(slot->task, config::NOTIFY_INDEX_SLEEP);
+        }
+
+        static bool createSlotTimer(SleepSlot &slot)
+        {
+            esp_timer_create_args_t args = {
+                .callback = sleepTimerCallback,
+                .arg = &slot,
+                .dispatch_method = ESP_TIMER_TASK,
+                .name = "sleep_us",
+                .skip_unhandled_events = false};
+            if (esp_timer_create(&args, &slot.timer) != ESP_OK)
+            {
+                ESP_LOGE(TAG, "esp_timer_create fehlgeschlagen");
+                slot.timer = nullptr;
+                return false;
+            }
+            return true;
+        }
+
+        static SleepSlot *claimSlot()
+        {
+            for (SleepSlot &slot : s_slots)
+            {
+                bool expected = false;
+                if (slot.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    // Ohne initSleepTimers() beim ersten Gebrauch anlegen
+                    if (!slot.timer && !createSlotTimer(slot))
+                    {
+                        slot.busy.store(false, std::memory_order_release);
+                        return nullptr;
+                    }
+                    return &slot;
+                }
+            }
+            return nullptr;
+        }
+
+        void initSleepTimers()
+        {
+            for (SleepSlot &slot : s_slots)
+            {
+                bool expected = false;
+                if (!slot.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    continue;
+                if (!slot.timer)
+                    createSlotTimer(slot);
+                slot.busy.store(false, std::memory_order_release);
+            }
+        }
+
+        void sleepUs(uint32_t us)
+        {
+            if (us < config::SLEEP_SPIN_THRESHOLD_US)
+            {
+                esp_rom_delay_us(us);
+                return;
+            }
+
+            SleepSlot *slot = claimSlot();
+            if (!slot)
+            {
+                // Alle Timer belegt - lieber aktiv warten als zu lange schlafen
+                esp_rom_delay_us(us);
+                return;
+            }
+
+            slot->task = xTaskGetCurrentTaskHandle();
+            ulTaskNotifyValueClearIndexed(slot->task, config::NOTIFY_INDEX_SLEEP, UINT32_MAX);
+            ESP_ERROR_CHECK(esp_timer_start_once(slot->timer, us));
+            ulTaskNotifyTakeIndexed(config::NOTIFY_INDEX_SLEEP, pdTRUE, portMAX_DELAY);
+
+            slot->busy.store(false, std::memory_order_release);
+        }
+
+    } // namespace hal
+} // namespace tiny_turtle
@@ -0,0 +1,32 @@
+#pragma once
+/**
+ * @file hal/timing.h
+ * @brief Warten unterhalb der Tick-Auflösung
+ *
+ * vTaskDelay() rechnet in Ticks (CONFIG_FREERTOS_HZ=100 -> 10 ms). sleepUs()
+ * blockiert den Task stattdessen über einen einmaligen esp_timer und gibt
+ * die CPU in der Zwischenzeit frei. Sehr kurze Wartezeiten, bei denen sich
+ * der Kontextwechsel nicht lohnt, werden aktiv abgewartet.
+ */
+
+#include <cstdint>
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        /**
+         * @brief Alle Schlaf-Timer vorab anlegen (in tiny_turtle::init(), danach kein Heap mehr)
+         */
+        void initSleepTimers();
+
+        /**
+         * @brief Task für eine Anzahl Mikrosekunden schlafen legen
+         * @param us Wartezeit in Mikrosekunden
+         * @note Nicht aus ISRs aufrufen
+         */
+        void sleepUs(uint32_t us);
+
+    } // namespace hal
+} // namespace tiny_turtle
@@ -0,0 +1,158 @@
+#pragma once
+/**
+ * @file hal/wave_encoder.h
+ * @brief Spulenzustände beider Motoren als Zeitschlitz-Wellenform
+ *
+ * Für das DMA-Streaming (hal/wave_stream.h) wird die Bewegung vorab in einen
+ * Puffer mit einem Byte pro Zeitschlitz übersetzt: Bit 0-3 sind die Spulen
+ * A-D von Motor 1, Bit 4-7 die von Motor 2. Die Peripherie gibt die Bytes mit
+ * fester Schlitzrate aus - ein Schritt fällt damit exakt auf eine Schlitzgrenze,
+ * der Nachkomma-Anteil des Intervalls wird wie in der Stepper-ISR auf das
+ * nächste Intervall übertragen.
+ *
+ * Schrittfolgen und Segment-Regeln entsprechen der Timer-Steuerung:
+ * Intervalle und Schrittzahlen in Halbschritt-Einheiten, Vollschritt nur bei
+ * passender Phasen-Parität je Motor (passt keiner, richtet ein gemeinsamer
+ * Halbschritt aus, passt nur einer, macht der andere einen Schritt-Takt lang
+ * allein einen Halbschritt und der zurückliegende Motor holt vor dem
+ * Segment-Ende auf), ein einzelner Rest-Halbschritt wird als Halbschritt
+ * gefahren. Jeder Motor fährt damit genau die Schrittzahl des Segments.
+ *
+ * Frei von ESP-IDF, damit der Encoder auf dem Host geprüft werden kann
+ * (host/stepper_sim).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "stepper_backend.h"
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        constexpr uint32_t WAVE_FX_SHIFT = 8;
+        constexpr uint32_t WAVE_FX_ONE = 1u << WAVE_FX_SHIFT;
+
+        /**
+         * @brief Zustand des Encoders (überdauert Puffer- und Segmentgrenzen)
+         */
+        struct WaveState
+        {
+            uint8_t phase[2];     // Halbschritt-Phase je Motor
+            int8_t dir[2];        // Richtung je Motor (-1, 0, 1)
+            uint8_t stride;       // Halbschritte pro Schritt (1 = HALF, 2 = FULL/WAVE)
+            uint8_t parity;       // Phasen-Parität der Vollschritt-Folge (FULL 1, WAVE 0)
+            uint32_t intervalFx;  // Schlitze pro Halbschritt-Einheit, Q24.8 (>= WAVE_FX_ONE)
+            uint32_t targetFx;    // Ziel-Intervall der Rampe
+            int32_t rampDeltaFx;  // Intervall-Änderung pro Schritt (0 = keine Rampe)
+            uint32_t elapsedFx;   // Fortschritt zum nächsten Schritt
+            uint32_t stepsLeft;   // Verbleibende Halbschritt-Einheiten im Segment (des zurückliegenden Motors)
+            int32_t position[2];  // Zurückgelegte Halbschritt-Einheiten je Motor
+            uint8_t lag;          // Motor 1/2 liegt nach einer Ausrichtung eine Einheit zurück (0 = keiner)
+        };
+
+        /**
+         * @brief Ein Schritt beider Motoren
+         */
+        struct WaveStep
+        {
+            uint8_t units[2]; // Halbschritt-Einheiten je Motor
+            uint8_t span;     // Dauer in Halbschritt-Intervallen
+            uint8_t consumed; // Vom Segment verbrauchte Einheiten
+            uint8_t lag;      // WaveState::lag danach
+        };
+
+        /**
+         * @brief Ausgabebyte für die aktuellen Phasen
+         */
+        inline uint8_t waveSlot(const WaveState &st)
+        {
+            uint8_t out = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                out |= HALF_STEP_PATTERN[st.phase[0]][i] << i;
+                out |= HALF_STEP_PATTERN[st.phase[1]][i] << (4 + i);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Nächsten Schritt wählen (wie selectStepMode() der Timer-Steuerung)
+         *
+         * Passt die Parität nur bei einem von zwei bewegten Motoren, macht der
+         * andere allein einen Halbschritt, ohne das Segment zu verbrauchen; der
+         * zurückliegende holt auf, bevor das Segment für Vollschritte zu kurz wird.
+         */
+        inline WaveStep waveStep(const WaveState &st)
+        {
+            if (st.lag != 0 && (st.stride == 1 || st.stepsLeft < 3))
+                return st.lag == 1 ? WaveStep{{1, 0}, 1, 1, 0} : WaveStep{{0, 1}, 1, 1, 0};
+            if (st.stride == 1 || st.stepsLeft == 1)
+                return {{1, 1}, 1, 1, st.lag};
+
+            bool wrong[2];
+            for (int m = 0; m < 2; m++)
+                wrong[m] = st.dir[m] != 0 && (st.phase[m] & 1) != st.parity;
+            if (!wrong[0] && !wrong[1])
+                return {{st.stride, st.stride}, st.stride, st.stride, st.lag};
+            if (wrong[0] != wrong[1] && st.dir[0] != 0 && st.dir[1] != 0 && st.lag == 0 && st.stepsLeft >= 4)
+                return wrong[0] ? WaveStep{{1, 0}, 1, 0, 2} : WaveStep{{0, 1}, 1, 0, 1};
+            return {{1, 1}, 1, 1, st.lag};
+        }
+
+        /**
+         * @brief Wellenform bis zum Segment-Ende oder Pufferende erzeugen
+         *
+         * @param out Zielpuffer (ein Byte pro Zeitschlitz)
+         * @param slots Größe des Zielpuffers
+         * @return Geschriebene Schlitze. Endet das Segment (stepsLeft == 0), enthält
+         *         der letzte geschriebene Schlitz den letzten Schritt und der Rest
+         *         des Puffers ist frei für das nächste Segment.
+         */
+        inline size_t encodeWave(WaveState &st, uint8_t *out, size_t slots)
+        {
+            uint8_t current = waveSlot(st);
+            size_t i = 0;
+
+            while (i < slots && st.stepsLeft != 0)
+            {
+                WaveStep step = waveStep(st);
+                uint32_t waitFx = st.intervalFx * step.span;
+                size_t need = (waitFx - st.elapsedFx + WAVE_FX_ONE - 1) / WAVE_FX_ONE;
+
+                if (i + need > slots)
+                {
+                    std::memset(out + i, current, slots - i);
+                    st.elapsedFx += static_cast<uint32_t>(slots - i) * WAVE_FX_ONE;
+                    return slots;
+                }
+
+                std::memset(out + i, current, need - 1);
+                st.elapsedFx = st.elapsedFx + static_cast<uint32_t>(need) * WAVE_FX_ONE - waitFx;
+
+                for (int m = 0; m < 2; m++)
+                {
+                    st.phase[m] = (st.phase[m] + 8 + st.dir[m] * step.units[m]) & 7;
+                    st.position[m] += st.dir[m] * step.units[m];
+                }
+                current = waveSlot(st);
+                out[i + need - 1] = current;
+                i += need;
+                st.stepsLeft -= step.consumed;
+                st.lag = step.lag;
+
+                if (st.rampDeltaFx != 0)
+                {
+                    int64_t next = static_cast<int64_t>(st.intervalFx) + st.rampDeltaFx;
+                    bool reached = st.rampDeltaFx < 0 ? next <= st.targetFx : next >= st.targetFx;
+                    st.intervalFx = reached ? st.targetFx : static_cast<uint32_t>(next);
+                    if (reached)
+                        st.rampDeltaFx = 0;
+                }
+            }
+            return i;
+        }
+
+    } // namespace hal
+} // namespace tiny_turtle
@@ -0,0 +1,252 @@
+/**
+ * @file hal/wave_stream.cpp
+ * @brief Implementierung der PARLIO-Wellenform-Ausgabe
+ */
+
+#include "wave_stream.h"
+
+#if TT_STEPPER_WAVE
+
+#include "stepper.h"
+#include "wave_encoder.h"
+#include "../core/config.h"
+#include "../monitor/alloc_tracking.h"
+#include "../monitor/perf.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_gpio.h"
+#include "driver/parlio_tx.h"
+#include "soc/gpio_sig_map.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if TT_STEPPER_BACKEND != TT_STEPPER_BACKEND_UNIPOLAR
+#error "TT_STEPPER_WAVE gibt es nur mit dem Unipolar-Backend"
+#endif
+
+static const char *TAG = "hal.wave";
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+        static constexpr size_t SLOTS = config::WAVE_BUFFER_SLOTS;
+
+        // Zwei Halbpuffer im internen RAM (DMA-fähig, wortausgerichtet)
+        static DMA_ATTR uint8_t s_buffers[2][SLOTS];
+
+        static monitor::PerfCounter s_blocks("wave.blocks");
+        static monitor::PerfHistogram s_fill_cycles("wave.fill_cycles");
+
+        struct WaveJob
+        {
+            WaveState state;
+            const WaveSegment *segments;
+            size_t count;
+            size_t next;
+        };
+
+        // Intervall in Zeitschlitzen (Q24.8), mindestens ein Schlitz
+        static uint32_t toSlotsFx(uint32_t us)
+        {
+            uint64_t fx = (static_cast<uint64_t>(us) * config::WAVE_SLOT_RATE_HZ << WAVE_FX_SHIFT) / 1000000;
+            return fx < WAVE_FX_ONE ? WAVE_FX_ONE : static_cast<uint32_t>(fx);
+        }
+
+        static void loadSegment(WaveState &st, const WaveSegment &seg)
+        {
+            switch (seg.command)
+            {
+            case MotorCommand::FORWARD:
+                st.dir[0] = 1;
+                st.dir[1] = 1;
+                break;
+            case MotorCommand::BACKWARD:
+                st.dir[0] = -1;
+                st.dir[1] = -1;
+                break;
+            case MotorCommand::SPIN_CW:
+                st.dir[0] = 1;
+                st.dir[1] = -1;
+                break;
+            case MotorCommand::SPIN_CCW:
+                st.dir[0] = -1;
+                st.dir[1] = 1;
+                break;
+            default:
+                st.dir[0] = 0;
+                st.dir[1] = 0;
+                break;
+            }
+
+            bool full = seg.mode == StepMode::FULL || seg.mode == StepMode::WAVE;
+            st.stride = full ? 2 : 1;
+            st.parity = seg.mode == StepMode::FULL ? 1 : 0;
+
+            st.targetFx = toSlotsFx(seg.intervalUs);
+            st.intervalFx = st.targetFx;
+            st.rampDeltaFx = 0;
+            if (seg.startUs != 0 && seg.rampSteps != 0)
+            {
+                st.intervalFx = toSlotsFx(seg.startUs);
+                st.rampDeltaFx = (static_cast<int32_t>(st.targetFx) - static_cast<int32_t>(st.intervalFx)) /
+                                 static_cast<int32_t>(seg.rampSteps);
+                if (st.rampDeltaFx == 0)
+                    st.intervalFx = st.targetFx;
+            }
+
+            st.stepsLeft = seg.command == MotorCommand::STOP ? 0 : seg.steps;
+            st.lag = 0;
+        }
+
+        // Einen Halbpuffer füllen, über Segmentgrenzen hinweg; 0 = Auftrag fertig
+        static size_t fillBuffer(WaveJob &job, uint8_t *buf)
+        {
+            size_t used = 0;
+            while (used < SLOTS)
+            {
+                if (job.state.stepsLeft == 0)
+                {
+                    if (job.next >= job.count)
+                        break;
+                    loadSegment(job.state, job.segments[job.next++]);
+                    continue;
+                }
+                used += encodeWave(job.state, buf + used, SLOTS - used);
+            }
+            return used;
+        }
+
+        static bool IRAM_ATTR onBlockDone(parlio_tx_unit_handle_t unit, const parlio_tx_done_event_data_t *edata,
+                                          void *user)
+        {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(static_cast<TaskHandle_t>(user), config::NOTIFY_INDEX_STEPPER, &woken);
+            return woken == pdTRUE;
+        }
+
+        static parlio_tx_unit_handle_t createUnit(const TurtleContext &ctx)
+        {
+            parlio_tx_unit_config_t cfg = {};
+            cfg.clk_src = PARLIO_CLK_SRC_DEFAULT;
+            cfg.clk_in_gpio_num = GPIO_NUM_NC;
+            cfg.output_clk_freq_hz = config::WAVE_SLOT_RATE_HZ;
+            cfg.data_width = 8;
+            for (auto &pin : cfg.data_gpio_nums)
+                pin = GPIO_NUM_NC;
+            // Bit 0-3: Motor 1 Spulen A-D, Bit 4-7: Motor 2 (wie hal/wave_encoder.h)
+            for (int m = 0; m < 2; m++)
+                for (int i = 0; i < 4; i++)
+                    cfg.data_gpio_nums[m * 4 + i] = static_cast<gpio_num_t>(ctx.pins.stepper[m][i]);
+            cfg.clk_out_gpio_num = GPIO_NUM_NC;
+            cfg.valid_gpio_num = GPIO_NUM_NC;
+            cfg.trans_queue_depth = 2;
+            cfg.max_transfer_size = SLOTS;
+            cfg.sample_edge = PARLIO_SAMPLE_EDGE_POS;
+            cfg.bit_pack_order = PARLIO_BIT_PACK_ORDER_LSB;
+
+            parlio_tx_unit_handle_t unit = nullptr;
+            if (parlio_new_tx_unit(&cfg, &unit) != ESP_OK)
+                return nullptr;
+            return unit;
+        }
+
+        bool playWave(TurtleContext &ctx, const WaveSegment *segments, size_t count)
+        {
+            if (ctx.hot.timerRunning)
+            {
+                ESP_LOGW(TAG, "Stepper-Timer läuft - erst stopStepperTimer()");
+                return false;
+            }
+
+            // Die TX-Einheit belegt die Spulen-Pins nur für die Dauer der Wiedergabe;
+            // Anlegen und Freigeben sind die einzigen Heap-Zugriffe dieses Pfads
+            parlio_tx_unit_handle_t unit;
+            {
+                monitor::AllocPermit permit;
+                unit = createUnit(ctx);
+            }
+            if (!unit)
+            {
+                ESP_LOGE(TAG, "PARLIO-TX nicht verfügbar");
+                return false;
+            }
+
+            TaskHandle_t self = xTaskGetCurrentTaskHandle();
+            parlio_tx_event_callbacks_t cbs = {.on_trans_done = onBlockDone};
+            ESP_ERROR_CHECK(parlio_tx_unit_register_event_callbacks(unit, &cbs, self));
+            ESP_ERROR_CHECK(parlio_tx_unit_enable(unit));
+            ulTaskNotifyValueClearIndexed(self, config::NOTIFY_INDEX_STEPPER, UINT32_MAX);
+
+            WaveJob job = {};
+            job.state.phase[0] = ctx.hot.phase1;
+            job.state.phase[1] = ctx.hot.phase2;
+            job.segments = segments;
+            job.count = count;
+
+            int32_t counted[2] = {0, 0};
+            int inFlight = 0;
+            uint8_t next = 0;
+
+            // Beide Halbpuffer vorfüllen, danach je Puffer-Ende einen nachfüllen
+            while (true)
+            {
+                while (inFlight < 2)
+                {
+                    size_t used;
+                    {
+                        monitor::PerfCycleScope measure(s_fill_cycles);
+                        used = fillBuffer(job, s_buffers[next]);
+                    }
+                    if (used == 0)
+                        break;
+
+                    // In der Lücke bis zum nächsten Puffer den letzten Zustand halten
+                    parlio_transmit_config_t tx = {};
+                    tx.idle_value = s_buffers[next][used - 1];
+                    ESP_ERROR_CHECK(parlio_tx_unit_transmit(unit, s_buffers[next], used * 8, &tx));
+                    s_blocks.add();
+
+                    // Schrittzähler laufen der Ausgabe um höchstens zwei Halbpuffer voraus
+                    int32_t d1 = job.state.position[0] - counted[0];
+                    int32_t d2 = job.state.position[1] - counted[1];
+                    counted[0] = job.state.position[0];
+                    counted[1] = job.state.position[1];
+                    ctx.hot.stepCount = ctx.hot.stepCount + d1;
+                    ctx.state.addSteps(d1, d2);
+
+                    next ^= 1;
+                    inFlight++;
+                }
+
+                if (inFlight == 0)
+                    break;
+                ulTaskNotifyTakeIndexed(config::NOTIFY_INDEX_STEPPER, pdFALSE, portMAX_DELAY);
+                inFlight--;
+            }
+
+            ESP_ERROR_CHECK(parlio_tx_unit_wait_all_done(unit, -1));
+            ESP_ERROR_CHECK(parlio_tx_unit_disable(unit));
+            {
+                monitor::AllocPermit permit;
+                ESP_ERROR_CHECK(parlio_del_tx_unit(unit));
+            }
+
+            // Pins zurück an GPIO, Phasen an die Timer-Steuerung übergeben
+            for (int m = 0; m < 2; m++)
+                for (int i = 0; i < 4; i++)
+                    esp_rom_gpio_connect_out_signal(ctx.pins.stepper[m][i], SIG_GPIO_OUT_IDX, false, false);
+            ctx.hot.phase1 = job.state.phase[0];
+            ctx.hot.phase2 = job.state.phase[1];
+            stopMotors(ctx);
+
+            ESP_LOGI(TAG, "%u Segmente ausgegeben (Schritt %ld)", static_cast<unsigned>(count), ctx.hot.stepCount);
+            return true;
+        }
+
+        bool playWave(const WaveSegment *segments, size_t count) { return playWave(defaultContext(), segments, count); }
+
+    } // namespace hal
+} // namespace tiny_turtle
+
+#endif // TT_STEPPER_WAVE
@@ -0,0 +1,66 @@
+#pragma once
+/**
+ * @file hal/wave_stream.h
+ * @brief Segmente als DMA-Wellenform über PARLIO ausgeben
+ *
+ * Statt pro Schritt eine Timer-ISR auszulösen, werden die Spulenzustände
+ * beider Motoren vorab in Puffer kodiert (hal/wave_encoder.h) und vom
+ * PARLIO-TX (8 Bit breit, config::WAVE_SLOT_RATE_HZ) per DMA auf die acht
+ * Spulen-Pins ausgegeben. Zwei Halbpuffer wechseln sich ab: während einer
+ * läuft, füllt der aufrufende Task den anderen und schläft danach bis zum
+ * nächsten Puffer-Ende - ein Interrupt pro Halbpuffer statt einer pro Schritt.
+ *
+ * Schrittzeiten liegen exakt auf dem Schlitzraster und hängen nicht von
+ * anderen Interrupts ab. Phasen und Schrittzähler teilt sich die Ausgabe
+ * mit der Timer-Steuerung; beide lassen sich abwechselnd, aber nicht
+ * gleichzeitig nutzen.
+ *
+ * Zur Compile-Zeit aktivieren (nur Unipolar-Backend), z.B. in main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_STEPPER_WAVE=1)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/types.h"
+#include "../core/context.h"
+
+#ifndef TT_STEPPER_WAVE
+#define TT_STEPPER_WAVE 0
+#endif
+
+namespace tiny_turtle
+{
+    namespace hal
+    {
+
+        /**
+         * @brief Ein Segment der Wellenform-Ausgabe
+         */
+        struct WaveSegment
+        {
+            MotorCommand command; // FORWARD, BACKWARD, SPIN_CW, SPIN_CCW
+            uint32_t steps;       // Halbschritt-Einheiten (Motor 1)
+            uint32_t intervalUs;  // Ziel-Intervall pro Halbschritt-Einheit
+            uint32_t startUs;     // Start-Intervall der Rampe (0 = ohne Rampe)
+            uint32_t rampSteps;   // Schritte bis zum Ziel-Intervall
+            StepMode mode;        // HALF, FULL oder WAVE (sonst HALF)
+        };
+
+#if TT_STEPPER_WAVE
+
+        /**
+         * @brief Segmente lückenlos nacheinander ausgeben (blockierend)
+         *
+         * Nach dem letzten Segment sind die Spulen stromlos, die Phasen stehen
+         * in ctx.hot für die Timer-Steuerung bereit.
+         *
+         * @return false wenn der Stepper-Timer läuft oder PARLIO nicht verfügbar ist
+         * @note Nicht aus ISRs aufrufen; belegt den Notification-Slot NOTIFY_INDEX_STEPPER
+         */
+        bool playWave(TurtleContext &ctx, const WaveSegment *segments, size_t count);
+        bool playWave(const WaveSegment *segments, size_t count);
+
+#endif
+
+    } // namespace hal
+} // namespace tiny_turtle
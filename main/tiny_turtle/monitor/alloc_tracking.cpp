@@ -0,0 +1,130 @@
+/**
+ * @file monitor/alloc_tracking.cpp
+ * @brief Heap-Hook und Zähler für Allokationen nach dem Start
+ */
+
+#include "alloc_tracking.h"
+
+#include <atomic>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF && !CONFIG_HEAP_USE_HOOKS
+#error "TT_ALLOC_TRACKING braucht CONFIG_HEAP_USE_HOOKS=y (menuconfig: Heap memory debugging -> Use allocation and free hooks)"
+#endif
+
+static const char *TAG = "monitor.alloc";
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        static std::atomic<bool> s_armed{false};
+        static std::atomic<uint32_t> s_permits{0};
+
+        // Nur im Hook geschrieben (Zeitpunkte in ms, 32 Bit reichen für Wochen Laufzeit)
+        static std::atomic<uint32_t> s_count{0};
+        static std::atomic<uint32_t> s_bytes{0};
+        static std::atomic<uint32_t> s_largest{0};
+        static std::atomic<uint32_t> s_first_ms{0};
+        static std::atomic<uint32_t> s_last_ms{0};
+
+        void armAllocTracking()
+        {
+            resetAllocStats();
+            s_armed.store(true, std::memory_order_release);
+#if TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF
+            ESP_LOGI(TAG, "Heap-Überwachung aktiv (%s)",
+                     TT_ALLOC_TRACKING == TT_ALLOC_TRACKING_FATAL ? "Abbruch" : "Zählen");
+#endif
+        }
+
+        bool isAllocTrackingArmed()
+        {
+            return TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF && s_armed.load(std::memory_order_acquire);
+        }
+
+        AllocStats getAllocStats()
+        {
+            return {s_count.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed),
+                    s_largest.load(std::memory_order_relaxed), s_first_ms.load(std::memory_order_relaxed),
+                    s_last_ms.load(std::memory_order_relaxed)};
+        }
+
+        void resetAllocStats()
+        {
+            s_count.store(0, std::memory_order_relaxed);
+            s_bytes.store(0, std::memory_order_relaxed);
+            s_largest.store(0, std::memory_order_relaxed);
+            s_first_ms.store(0, std::memory_order_relaxed);
+            s_last_ms.store(0, std::memory_order_relaxed);
+        }
+
+        void logAllocStats()
+        {
+#if TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF
+            AllocStats stats = getAllocStats();
+            if (stats.count == 0)
+                ESP_LOGI(TAG, "Keine Allokation seit dem Start");
+            else
+                ESP_LOGW(TAG, "%lu Allokationen (%lu Bytes, größte %lu) zwischen %lu und %lu ms", stats.count,
+                         stats.bytes, stats.largest, stats.firstMs, stats.lastMs);
+#else
+            ESP_LOGI(TAG, "Heap-Überwachung deaktiviert (TT_ALLOC_TRACKING=0)");
+#endif
+            ESP_LOGI(TAG, "Heap frei %u, Minimum %u", static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_DEFAULT)),
+                     static_cast<unsigned>(heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT)));
+        }
+
+        AllocPermit::AllocPermit()
+        {
+            s_permits.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        AllocPermit::~AllocPermit()
+        {
+            s_permits.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+#if TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF
+        static void IRAM_ATTR recordAlloc(size_t size)
+        {
+            if (!s_armed.load(std::memory_order_relaxed) || s_permits.load(std::memory_order_relaxed) != 0)
+                return;
+
+#if TT_ALLOC_TRACKING == TT_ALLOC_TRACKING_FATAL
+            (void)size;
+            esp_system_abort("Heap-Allokation nach tiny_turtle::init()");
+#else
+            uint32_t now = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+            uint32_t bytes = static_cast<uint32_t>(size);
+            if (s_count.fetch_add(1, std::memory_order_relaxed) == 0)
+                s_first_ms.store(now, std::memory_order_relaxed);
+            s_last_ms.store(now, std::memory_order_relaxed);
+            s_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+            uint32_t largest = s_largest.load(std::memory_order_relaxed);
+            while (bytes > largest && !s_largest.compare_exchange_weak(largest, bytes, std::memory_order_relaxed))
+            {
+            }
+#endif
+        }
+#endif
+
+    } // namespace monitor
+} // namespace tiny_turtle
+
+#if TT_ALLOC_TRACKING != TT_ALLOC_TRACKING_OFF
+// Hook des IDF-Heaps (schwach definiert in heap/heap_caps.c, wird nach jeder Allokation gerufen)
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+    (void)caps;
+    if (ptr)
+        tiny_turtle::monitor::recordAlloc(size);
+}
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+/**
+ * @file monitor/alloc_tracking.h
+ * @brief Heap-Allokationen nach dem Start erkennen
+ *
+ * Nach tiny_turtle::init() soll der Roboter ohne Heap auskommen: Puffer sind
+ * statisch, Texte werden als std::string_view übergeben. Mit
+ * TT_ALLOC_TRACKING hängt sich dieses Modul in den IDF-Heap
+ * (CONFIG_HEAP_USE_HOOKS) und zählt jede Allokation ab armAllocTracking()
+ * mit Zeitpunkt und Größe:
+ *
+ *   TT_ALLOC_TRACKING=0  aus (Standard, kein Hook)
+ *   TT_ALLOC_TRACKING=1  zählen, logAllocStats() / getAllocStats()
+ *   TT_ALLOC_TRACKING=2  erste Allokation bricht mit Backtrace ab (Test-Builds)
+ *
+ * z.B. in main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_ALLOC_TRACKING=2)
+ *
+ * Bewusste Allokationen nach dem Start (NVS öffnen, Tasks der Anwendung)
+ * stehen in einem AllocPermit-Block. Der Block gilt für alle Tasks.
+ */
+
+#include <cstdint>
+
+#define TT_ALLOC_TRACKING_OFF 0
+#define TT_ALLOC_TRACKING_COUNT 1
+#define TT_ALLOC_TRACKING_FATAL 2
+
+#ifndef TT_ALLOC_TRACKING
+#define TT_ALLOC_TRACKING TT_ALLOC_TRACKING_OFF
+#endif
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        /**
+         * @brief Allokationen seit armAllocTracking() bzw. resetAllocStats()
+         */
+        struct AllocStats
+        {
+            uint32_t count;     // Anzahl Allokationen
+            uint32_t bytes;     // Summe der angeforderten Bytes
+            uint32_t largest;   // Größte einzelne Allokation
+            uint32_t firstMs;   // esp_timer-Zeit der ersten (0 = keine)
+            uint32_t lastMs;    // esp_timer-Zeit der letzten
+        };
+
+        /**
+         * @brief Ab jetzt jede Allokation melden (am Ende von tiny_turtle::init())
+         */
+        void armAllocTracking();
+
+        /**
+         * @brief Ist die Überwachung aktiv?
+         */
+        bool isAllocTrackingArmed();
+
+        /**
+         * @brief Aktuelle Zählerstände
+         */
+        AllocStats getAllocStats();
+
+        /**
+         * @brief Zähler zurücksetzen (z.B. vor einem Dauertest)
+         */
+        void resetAllocStats();
+
+        /**
+         * @brief Zählerstände und Heap-Minimum ausgeben
+         */
+        void logAllocStats();
+
+        /**
+         * @brief Allokationen im umschließenden Block erlauben
+         */
+        class AllocPermit
+        {
+        public:
+            AllocPermit();
+            ~AllocPermit();
+
+            AllocPermit(const AllocPermit &) = delete;
+            AllocPermit &operator=(const AllocPermit &) = delete;
+        };
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,67 @@
+/**
+ * @file monitor/boot_timeline.cpp
+ * @brief Implementierung der Start-Zeitmessung
+ */
+
+#include "boot_timeline.h"
+#include "../core/context.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "monitor.boot";
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        static constexpr size_t PHASES = static_cast<size_t>(BootPhase::COUNT);
+
+        static const char *const PHASE_NAMES[PHASES] = {"startup", "stepper", "servo", "sensors", "audio", "led"};
+
+        // Ende jeder Phase (esp_timer-Zeit), 0 = nicht markiert
+        static int64_t s_marks[PHASES];
+
+        void markBootPhase(BootPhase phase)
+        {
+            s_marks[static_cast<size_t>(phase)] = esp_timer_get_time();
+        }
+
+        uint32_t getBootPhaseUs(BootPhase phase)
+        {
+            size_t i = static_cast<size_t>(phase);
+            if (s_marks[i] == 0)
+                return 0;
+            int64_t begin = i == 0 ? 0 : s_marks[i - 1];
+            return static_cast<uint32_t>(s_marks[i] - begin);
+        }
+
+        uint32_t getBootReadyUs()
+        {
+            for (size_t i = PHASES; i > 0; i--)
+            {
+                if (s_marks[i - 1] != 0)
+                    return static_cast<uint32_t>(s_marks[i - 1]);
+            }
+            return 0;
+        }
+
+        void logBootTimeline()
+        {
+            for (size_t i = 0; i < PHASES; i++)
+            {
+                uint32_t us = getBootPhaseUs(static_cast<BootPhase>(i));
+                ESP_LOGI(TAG, "  %-8s %4lu.%01lu ms", PHASE_NAMES[i], us / 1000, (us % 1000) / 100);
+            }
+
+            uint32_t readyUs = getBootReadyUs();
+            ESP_LOGI(TAG, "Bereit nach %lu.%01lu ms", readyUs / 1000, (readyUs % 1000) / 100);
+
+            // Stift hebt noch im Hintergrund - die erste Bewegung wartet den Rest ab
+            int64_t settleUs = defaultContext().hal.servoSettleUs;
+            if (settleUs > static_cast<int64_t>(readyUs))
+                ESP_LOGI(TAG, "Stift oben nach %lu ms (im Hintergrund)", static_cast<uint32_t>(settleUs / 1000));
+        }
+
+    } // namespace monitor
+} // namespace tiny_turtle
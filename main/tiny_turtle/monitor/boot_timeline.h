@@ -0,0 +1,54 @@
+#pragma once
+/**
+ * @file monitor/boot_timeline.h
+ * @brief Zeitmessung der Start-Phasen bis "bereit"
+ *
+ * tiny_turtle::init() markiert das Ende jeder Phase mit markBootPhase().
+ * Die erste Phase (STARTUP) reicht vom Start des Systemtimers - kurz nach
+ * dem Reset, ohne ROM und Bootloader - bis zum Aufruf von init(). Was
+ * danach im Hintergrund weiterläuft (Servo hebt den Stift, Startton), steht
+ * als eigene Zeile in logBootTimeline().
+ */
+
+#include <cstdint>
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        /**
+         * @brief Start-Phasen in der Reihenfolge von tiny_turtle::init()
+         */
+        enum class BootPhase : uint8_t
+        {
+            STARTUP, // Systemtimer -> init()
+            STEPPER, // GPTimer, Spulen stromlos
+            SERVO,   // Stift heben anstoßen (wartet nicht)
+            SENSORS, // Bumper-GPIOs, ADC-Einheit
+            AUDIO,   // LEDC-Tonkanal, Startton anstoßen
+            LED,     // RMT-Kanal, Animations-Task, Status
+            COUNT
+        };
+
+        /**
+         * @brief Ende einer Phase markieren (Phasen der Reihe nach)
+         */
+        void markBootPhase(BootPhase phase);
+
+        /**
+         * @brief Dauer einer Phase in µs (0 = noch nicht markiert)
+         */
+        uint32_t getBootPhaseUs(BootPhase phase);
+
+        /**
+         * @brief Zeit vom Systemstart bis zum Ende der letzten markierten Phase in µs
+         */
+        uint32_t getBootReadyUs();
+
+        /**
+         * @brief Phasen, Gesamtzeit und Hintergrund-Restzeit (Servo) ausgeben
+         */
+        void logBootTimeline();
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * @file monitor/histogram.h
+ * @brief Histogramm mit festen Zweierpotenz-Klassen
+ *
+ * Klasse 0 enthält den Wert 0, Klasse i (i >= 1) die Werte 2^(i-1) .. 2^i - 1,
+ * die letzte Klasse zusätzlich alles darüber. Das Einsortieren kostet nur ein
+ * count-leading-zeros und ist damit auch für ISRs geeignet.
+ *
+ * Header-only und ohne ESP-IDF-Abhängigkeit.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/isr_attr.h"
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+
+        template <size_t Buckets = 16>
+        struct Histogram
+        {
+            static_assert(Buckets >= 2 && Buckets <= 32, "1..31 Zweierpotenz-Klassen");
+
+            uint32_t counts[Buckets];
+            uint32_t count;
+            uint32_t min;
+            uint32_t max;
+            uint64_t sum;
+
+            static constexpr size_t buckets() { return Buckets; }
+
+            TT_ISR_INLINE void reset()
+            {
+                for (size_t i = 0; i < Buckets; i++)
+                    counts[i] = 0;
+                count = 0;
+                min = UINT32_MAX;
+                max = 0;
+                sum = 0;
+            }
+
+            static TT_ISR_INLINE size_t bucketOf(uint32_t value)
+            {
+                size_t idx = value ? static_cast<size_t>(32 - __builtin_clz(value)) : 0;
+                return idx < Buckets ? idx : Buckets - 1;
+            }
+
+            /**
+             * @brief Untere Grenze einer Klasse
+             */
+            static constexpr uint32_t bucketLow(size_t idx)
+            {
+                return idx == 0 ? 0 : (1u << (idx - 1));
+            }
+
+            /**
+             * @brief Obere Grenze einer Klasse (letzte Klasse: offen)
+             */
+            static constexpr uint32_t bucketHigh(size_t idx)
+            {
+                return idx == 0 ? 0 : (idx == Buckets - 1 ? UINT32_MAX : (1u << idx) - 1);
+            }
+
+            TT_ISR_INLINE void add(uint32_t value)
+            {
+                counts[bucketOf(value)]++;
+                count++;
+                sum += value;
+                if (value < min)
+                    min = value;
+                if (value > max)
+                    max = value;
+            }
+
+            uint32_t average() const { return count ? static_cast<uint32_t>(sum / count) : 0; }
+
+            /**
+             * @brief Perzentil als obere Klassengrenze (konservative Schätzung)
+             * @param p Anteil 0.0 .. 1.0
+             */
+            uint32_t percentile(float p) const
+            {
+                if (count == 0)
+                    return 0;
+
+                uint32_t target = static_cast<uint32_t>(p * count + 0.5f);
+                if (target == 0)
+                    target = 1;
+
+                uint32_t seen = 0;
+                for (size_t i = 0; i < Buckets; i++)
+                {
+                    seen += counts[i];
+                    if (seen >= target)
+                        return bucketHigh(i) < max ? bucketHigh(i) : max;
+                }
+                return max;
+            }
+        };
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,105 @@
+/**
+ * @file monitor/isr_timing.cpp
+ * @brief Implementierung der ISR-Laufzeit-Messung
+ */
+
+#include "isr_timing.h"
+#include "../core/seqlock.h"
+
+#include <atomic>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+
+static const char *TAG = "monitor.isr";
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        static IsrTiming makeEmpty()
+        {
+            IsrTiming t;
+            t.latencyUs.reset();
+            t.durationCycles.reset();
+            t.overruns = 0;
+            t.cyclesPerUs = 0;
+            return t;
+        }
+
+        // Einziger Schreiber ist die Stepper-ISR (auch für das Zurücksetzen)
+        static DRAM_ATTR SeqLock<IsrTiming> s_timing(makeEmpty());
+        static DRAM_ATTR std::atomic<bool> s_reset_requested{false};
+
+        void IRAM_ATTR recordIsrTiming(uint32_t latencyUs, uint32_t cycles, uint32_t intervalUs)
+        {
+            uint32_t cyclesPerUs = esp_rom_get_cpu_ticks_per_us();
+            bool reset = s_reset_requested.exchange(false, std::memory_order_acquire);
+
+            s_timing.write([&](IsrTiming &t) __attribute__((always_inline))
+                           {
+                if (reset)
+                {
+                    t.latencyUs.reset();
+                    t.durationCycles.reset();
+                    t.overruns = 0;
+                }
+                t.cyclesPerUs = cyclesPerUs;
+                t.latencyUs.add(latencyUs);
+                t.durationCycles.add(cycles);
+
+                // Ende der ISR relativ zum Alarm - liegt es hinter dem nächsten Alarm?
+                uint32_t endUs = latencyUs + (cycles + cyclesPerUs - 1) / cyclesPerUs;
+                if (endUs >= intervalUs)
+                    t.overruns++; });
+        }
+
+        IsrTiming getIsrTiming()
+        {
+            return s_timing.read();
+        }
+
+        void resetIsrTiming()
+        {
+            s_reset_requested.store(true, std::memory_order_release);
+        }
+
+        void logIsrTiming()
+        {
+#if TT_ISR_TIMING
+            IsrTiming t = getIsrTiming();
+            uint32_t calls = t.latencyUs.count;
+            if (calls == 0)
+            {
+                ESP_LOGI(TAG, "Keine ISR-Messwerte (Timer lief noch nicht)");
+                return;
+            }
+
+            uint32_t cpu = t.cyclesPerUs ? t.cyclesPerUs : 1;
+            ESP_LOGI(TAG, "%lu Aufrufe, %lu Überläufe", calls, t.overruns);
+            ESP_LOGI(TAG, "Latenz:   min %lu / avg %lu / p99 <= %lu / max %lu µs",
+                     t.latencyUs.min, t.latencyUs.average(), t.latencyUs.percentile(0.99f), t.latencyUs.max);
+            ESP_LOGI(TAG, "Laufzeit: min %lu / avg %lu / p99 <= %lu / max %lu Takte (max %lu µs)",
+                     t.durationCycles.min, t.durationCycles.average(), t.durationCycles.percentile(0.99f),
+                     t.durationCycles.max, t.durationCycles.max / cpu);
+
+            // Schlechtester Fall: Latenz + Laufzeit müssen in ein Schrittintervall passen
+            uint32_t worstUs = t.latencyUs.max + (t.durationCycles.max + cpu - 1) / cpu;
+            ESP_LOGI(TAG, "Worst case %lu µs pro Alarm -> Grenze ca. %lu Schritte/s",
+                     worstUs, worstUs ? 1000000UL / worstUs : 0UL);
+
+            for (size_t i = 0; i < t.latencyUs.buckets(); i++)
+            {
+                if (t.latencyUs.counts[i] == 0 && t.durationCycles.counts[i] == 0)
+                    continue;
+                ESP_LOGI(TAG, "  [%5lu..%5lu] Latenz(µs) %8lu | Laufzeit(Takte) %8lu",
+                         Histogram<16>::bucketLow(i), Histogram<16>::bucketHigh(i) == UINT32_MAX ? 99999UL : Histogram<16>::bucketHigh(i),
+                         t.latencyUs.counts[i], t.durationCycles.counts[i]);
+            }
+#else
+            ESP_LOGI(TAG, "ISR-Messung deaktiviert (TT_ISR_TIMING=0)");
+#endif
+        }
+
+    } // namespace monitor
+} // namespace tiny_turtle
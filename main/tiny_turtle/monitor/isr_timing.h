@@ -0,0 +1,66 @@
+#pragma once
+/**
+ * @file monitor/isr_timing.h
+ * @brief Laufzeit-Messung der Stepper-Timer-ISR
+ *
+ * Erfasst pro Alarm:
+ * - Eintritts-Latenz: Zeit vom geplanten Alarm bis zum Start des Callbacks (µs)
+ * - Ausführungszeit des Callbacks in CPU-Takten
+ * - Überläufe: der nächste Alarm war bereits fällig, als die ISR fertig war
+ *
+ * Die Werte landen in Histogrammen mit festen Klassen, die ein Task jederzeit
+ * konsistent auslesen kann (Seqlock, die ISR ist der einzige Schreiber).
+ * Daraus lässt sich ablesen, wie weit die Schrittrate gesteigert werden kann
+ * und wie viel Luft andere Interrupts (RMT, ADC, USB) noch lassen.
+ *
+ * Zur Compile-Zeit abschaltbar, z.B. in main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_ISR_TIMING=0)
+ */
+
+#include <cstdint>
+#include "histogram.h"
+
+#ifndef TT_ISR_TIMING
+#define TT_ISR_TIMING 1
+#endif
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        /**
+         * @brief Gesammelte ISR-Messwerte
+         */
+        struct IsrTiming
+        {
+            Histogram<16> latencyUs;      // Alarm -> Callback-Start
+            Histogram<16> durationCycles; // Callback-Laufzeit
+            uint32_t overruns;            // Nächster Alarm schon fällig
+            uint32_t cyclesPerUs;         // CPU-Takt zum Umrechnen
+        };
+
+        /**
+         * @brief Messpunkt einer ISR-Ausführung ablegen (nur aus der Stepper-ISR)
+         * @param latencyUs Zeit seit dem Alarm beim Eintritt
+         * @param cycles Laufzeit des Callbacks
+         * @param intervalUs Abstand bis zum nächsten Alarm
+         */
+        void recordIsrTiming(uint32_t latencyUs, uint32_t cycles, uint32_t intervalUs);
+
+        /**
+         * @brief Konsistente Kopie der Messwerte (aus einem Task)
+         */
+        IsrTiming getIsrTiming();
+
+        /**
+         * @brief Messwerte zurücksetzen (wird von der ISR beim nächsten Alarm ausgeführt)
+         */
+        void resetIsrTiming();
+
+        /**
+         * @brief Zusammenfassung und Histogramme ausgeben
+         */
+        void logIsrTiming();
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,270 @@
+/**
+ * @file monitor/perf.cpp
+ * @brief Implementierung der Performance-Registry
+ */
+
+#include "perf.h"
+#include "../core/config.h"
+
+#include <cstdio>
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "monitor.perf";
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        // Konstant initialisiert - gültig, bevor statische Konstruktoren laufen
+        static PerfMetric *s_head = nullptr;
+        static PerfMetric *s_tail = nullptr;
+        static portMUX_TYPE s_perf_mux = portMUX_INITIALIZER_UNLOCKED;
+
+        //===========================================================================
+        // Registrierung
+        //===========================================================================
+
+        PerfMetric::PerfMetric(const char *name, PerfKind kind)
+            : name_(name), kind_(kind), next_(nullptr)
+        {
+            portENTER_CRITICAL(&s_perf_mux);
+            if (s_tail)
+                s_tail->next_ = this;
+            else
+                s_head = this;
+            s_tail = this;
+            portEXIT_CRITICAL(&s_perf_mux);
+        }
+
+        PerfMetric *PerfMetric::first()
+        {
+            return s_head;
+        }
+
+        //===========================================================================
+        // Histogramme
+        //===========================================================================
+
+        PerfHistogram::PerfHistogram(const char *name) : PerfMetric(name, PerfKind::HISTOGRAM)
+        {
+            data_.reset();
+        }
+
+        void IRAM_ATTR PerfHistogram::record(uint32_t value)
+        {
+            portENTER_CRITICAL_SAFE(&s_perf_mux);
+            data_.add(value);
+            portEXIT_CRITICAL_SAFE(&s_perf_mux);
+        }
+
+        Histogram<32> PerfHistogram::snapshot() const
+        {
+            portENTER_CRITICAL(&s_perf_mux);
+            Histogram<32> copy = data_;
+            portEXIT_CRITICAL(&s_perf_mux);
+            return copy;
+        }
+
+        void PerfHistogram::reset()
+        {
+            portENTER_CRITICAL(&s_perf_mux);
+            data_.reset();
+            portEXIT_CRITICAL(&s_perf_mux);
+        }
+
+        PerfCycleScope::PerfCycleScope(PerfHistogram &hist)
+            : hist_(hist), start_(esp_cpu_get_cycle_count())
+        {
+        }
+
+        PerfCycleScope::~PerfCycleScope()
+        {
+            hist_.record(esp_cpu_get_cycle_count() - start_);
+        }
+
+        //===========================================================================
+        // Tasks und Heap
+        //===========================================================================
+
+#if configUSE_TRACE_FACILITY
+        static TaskStatus_t s_status[config::PERF_MAX_TASKS];
+
+        // Laufzeit beim letzten Schnappschuss (für den CPU-Anteil dazwischen)
+        struct PrevRunTime
+        {
+            TaskHandle_t handle;
+            uint32_t runTime;
+        };
+        static PrevRunTime s_prev[config::PERF_MAX_TASKS];
+        static uint32_t s_prev_total = 0;
+#endif
+
+        size_t collectSystemPerf(TaskPerf *tasks, size_t maxTasks, HeapPerf &heap)
+        {
+            heap.freeBytes = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+            heap.minFreeBytes = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+            heap.largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+
+#if configUSE_TRACE_FACILITY
+            uint32_t total = 0;
+            UBaseType_t count = uxTaskGetSystemState(s_status, config::PERF_MAX_TASKS, &total);
+            uint32_t elapsed = total - s_prev_total;
+
+            size_t n = 0;
+            for (UBaseType_t i = 0; i < count && n < maxTasks; i++)
+            {
+                const TaskStatus_t &st = s_status[i];
+                uint32_t runTime = 0;
+                uint32_t delta = 0;
+#if configGENERATE_RUN_TIME_STATS
+                runTime = st.ulRunTimeCounter;
+                delta = runTime;
+                for (size_t p = 0; p < config::PERF_MAX_TASKS; p++)
+                {
+                    if (s_prev[p].handle == st.xHandle)
+                    {
+                        delta = runTime - s_prev[p].runTime;
+                        break;
+                    }
+                }
+#endif
+                tasks[n++] = {
+                    .name = st.pcTaskName,
+                    .runTimeUs = runTime,
+                    .cpuPercent = elapsed ? 100.0f * delta / elapsed : 0.0f,
+                    .stackFreeMin = static_cast<uint32_t>(st.usStackHighWaterMark),
+                    .priority = static_cast<uint8_t>(st.uxCurrentPriority),
+                };
+            }
+
+            for (size_t p = 0; p < config::PERF_MAX_TASKS; p++)
+            {
+                s_prev[p] = p < count ? PrevRunTime{s_status[p].xHandle, static_cast<uint32_t>(s_status[p].ulRunTimeCounter)}
+                                      : PrevRunTime{nullptr, 0};
+            }
+            s_prev_total = total;
+            return n;
+#else
+            (void)tasks;
+            (void)maxTasks;
+            return 0;
+#endif
+        }
+
+        //===========================================================================
+        // Ausgabe
+        //===========================================================================
+
+        void logPerfSnapshot()
+        {
+            ESP_LOGI(TAG, "--- Metriken ---");
+            for (const PerfMetric *m = PerfMetric::first(); m; m = m->next())
+            {
+                switch (m->kind())
+                {
+                case PerfKind::COUNTER:
+                    ESP_LOGI(TAG, "%-24s %lu", m->name(), static_cast<const PerfCounter *>(m)->value());
+                    break;
+                case PerfKind::GAUGE:
+                {
+                    auto *g = static_cast<const PerfGauge *>(m);
+                    ESP_LOGI(TAG, "%-24s %ld (max %ld)", m->name(), g->value(), g->peak());
+                    break;
+                }
+                case PerfKind::HISTOGRAM:
+                {
+                    Histogram<32> h = static_cast<const PerfHistogram *>(m)->snapshot();
+                    ESP_LOGI(TAG, "%-24s n=%lu avg=%lu p50<=%lu p99<=%lu max=%lu", m->name(), h.count,
+                             h.average(), h.percentile(0.5f), h.percentile(0.99f), h.count ? h.max : 0);
+                    break;
+                }
+                }
+            }
+
+            TaskPerf tasks[config::PERF_MAX_TASKS];
+            HeapPerf heap;
+            size_t n = collectSystemPerf(tasks, config::PERF_MAX_TASKS, heap);
+
+            ESP_LOGI(TAG, "--- Tasks ---");
+            for (size_t i = 0; i < n; i++)
+            {
+                ESP_LOGI(TAG, "%-16s prio %2u  CPU %5.1f%%  Stack frei %5lu B", tasks[i].name,
+                         tasks[i].priority, tasks[i].cpuPercent, tasks[i].stackFreeMin);
+            }
+            ESP_LOGI(TAG, "Heap: %lu frei, Minimum %lu, größter Block %lu", heap.freeBytes, heap.minFreeBytes,
+                     heap.largestFreeBlock);
+        }
+
+        void printPerfJson()
+        {
+            std::printf("PERF {\"metrics\":{");
+            bool first = true;
+            for (const PerfMetric *m = PerfMetric::first(); m; m = m->next())
+            {
+                std::printf("%s\"%s\":", first ? "" : ",", m->name());
+                first = false;
+                switch (m->kind())
+                {
+                case PerfKind::COUNTER:
+                    std::printf("%lu", static_cast<unsigned long>(static_cast<const PerfCounter *>(m)->value()));
+                    break;
+                case PerfKind::GAUGE:
+                {
+                    auto *g = static_cast<const PerfGauge *>(m);
+                    std::printf("{\"value\":%ld,\"max\":%ld}", static_cast<long>(g->value()), static_cast<long>(g->peak()));
+                    break;
+                }
+                case PerfKind::HISTOGRAM:
+                {
+                    Histogram<32> h = static_cast<const PerfHistogram *>(m)->snapshot();
+                    std::printf("{\"count\":%lu,\"avg\":%lu,\"p50\":%lu,\"p99\":%lu,\"max\":%lu}",
+                                static_cast<unsigned long>(h.count), static_cast<unsigned long>(h.average()),
+                                static_cast<unsigned long>(h.percentile(0.5f)), static_cast<unsigned long>(h.percentile(0.99f)),
+                                static_cast<unsigned long>(h.count ? h.max : 0));
+                    break;
+                }
+                }
+            }
+
+            TaskPerf tasks[config::PERF_MAX_TASKS];
+            HeapPerf heap;
+            size_t n = collectSystemPerf(tasks, config::PERF_MAX_TASKS, heap);
+
+            std::printf("},\"tasks\":[");
+            for (size_t i = 0; i < n; i++)
+            {
+                std::printf("%s{\"name\":\"%s\",\"prio\":%u,\"cpu\":%.1f,\"run_us\":%lu,\"stack_free\":%lu}",
+                            i ? "," : "", tasks[i].name, tasks[i].priority, tasks[i].cpuPercent,
+                            static_cast<unsigned long>(tasks[i].runTimeUs), static_cast<unsigned long>(tasks[i].stackFreeMin));
+            }
+            std::printf("],\"heap\":{\"free\":%lu,\"min_free\":%lu,\"largest\":%lu}}\n",
+                        static_cast<unsigned long>(heap.freeBytes), static_cast<unsigned long>(heap.minFreeBytes),
+                        static_cast<unsigned long>(heap.largestFreeBlock));
+        }
+
+        void resetPerfCounters()
+        {
+            for (PerfMetric *m = PerfMetric::first(); m; m = m->next())
+            {
+                switch (m->kind())
+                {
+                case PerfKind::COUNTER:
+                    static_cast<PerfCounter *>(m)->reset();
+                    break;
+                case PerfKind::GAUGE:
+                    static_cast<PerfGauge *>(m)->reset();
+                    break;
+                case PerfKind::HISTOGRAM:
+                    static_cast<PerfHistogram *>(m)->reset();
+                    break;
+                }
+            }
+        }
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,186 @@
+#pragma once
+/**
+ * @file monitor/perf.h
+ * @brief Registry für Performance-Zähler und Ressourcen-Schnappschuss
+ *
+ * Module legen benannte Metriken als statische Objekte an, die sich selbst
+ * registrieren (verkettete Liste, kein Heap):
+ *
+ *   static monitor::PerfCounter s_penWaitMs("pen.wait_ms");
+ *   s_penWaitMs.add(config::SERVO_MOVE_DELAY_MS);
+ *
+ * Ein Schnappschuss sammelt alle Metriken plus FreeRTOS-Taskstatistik
+ * (CPU-Anteil, Stack-Reserve) und Heap-Minimum - wahlweise als lesbare
+ * Log-Ausgabe (logPerfSnapshot) oder als eine JSON-Zeile (printPerfJson).
+ *
+ * Zähler und Gauges sind ISR-safe, Histogramme werden über eine kurze
+ * Critical Section geschützt.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include "histogram.h"
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        enum class PerfKind : uint8_t
+        {
+            COUNTER,  // Monoton steigend (Ereignisse, Summen)
+            GAUGE,    // Momentanwert mit Maximum
+            HISTOGRAM // Verteilung (z.B. CPU-Takte pro Aufruf)
+        };
+
+        /**
+         * @brief Gemeinsame Basis aller Metriken (Registrierung)
+         */
+        class PerfMetric
+        {
+        public:
+            PerfMetric(const char *name, PerfKind kind);
+            PerfMetric(const PerfMetric &) = delete;
+            PerfMetric &operator=(const PerfMetric &) = delete;
+
+            const char *name() const { return name_; }
+            PerfKind kind() const { return kind_; }
+            PerfMetric *next() const { return next_; }
+
+            /**
+             * @brief Erste registrierte Metrik (für eigene Auswertungen)
+             */
+            static PerfMetric *first();
+
+        private:
+            const char *name_;
+            PerfKind kind_;
+            PerfMetric *next_;
+        };
+
+        /**
+         * @brief Ereigniszähler
+         */
+        class PerfCounter : public PerfMetric
+        {
+        public:
+            explicit PerfCounter(const char *name) : PerfMetric(name, PerfKind::COUNTER) {}
+
+            inline void add(uint32_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+            uint32_t value() const { return value_.load(std::memory_order_relaxed); }
+            void reset() { value_.store(0, std::memory_order_relaxed); }
+
+        private:
+            std::atomic<uint32_t> value_{0};
+        };
+
+        /**
+         * @brief Momentanwert (z.B. Füllstand) mit Höchststand
+         */
+        class PerfGauge : public PerfMetric
+        {
+        public:
+            explicit PerfGauge(const char *name) : PerfMetric(name, PerfKind::GAUGE) {}
+
+            inline void set(int32_t v)
+            {
+                value_.store(v, std::memory_order_relaxed);
+                int32_t peak = peak_.load(std::memory_order_relaxed);
+                while (v > peak && !peak_.compare_exchange_weak(peak, v, std::memory_order_relaxed))
+                {
+                }
+            }
+            int32_t value() const { return value_.load(std::memory_order_relaxed); }
+            int32_t peak() const { return peak_.load(std::memory_order_relaxed); }
+            void reset() { peak_.store(value(), std::memory_order_relaxed); }
+
+        private:
+            std::atomic<int32_t> value_{0};
+            std::atomic<int32_t> peak_{0};
+        };
+
+        /**
+         * @brief Verteilung von Messwerten (32 Zweierpotenz-Klassen)
+         */
+        class PerfHistogram : public PerfMetric
+        {
+        public:
+            explicit PerfHistogram(const char *name);
+
+            void record(uint32_t value);
+            Histogram<32> snapshot() const;
+            void reset();
+
+        private:
+            Histogram<32> data_;
+        };
+
+        /**
+         * @brief Misst die CPU-Takte eines Blocks in ein PerfHistogram
+         *
+         *   static monitor::PerfHistogram s_cycles("plotChar.cycles");
+         *   monitor::PerfCycleScope measure(s_cycles);
+         */
+        class PerfCycleScope
+        {
+        public:
+            explicit PerfCycleScope(PerfHistogram &hist);
+            ~PerfCycleScope();
+
+            PerfCycleScope(const PerfCycleScope &) = delete;
+            PerfCycleScope &operator=(const PerfCycleScope &) = delete;
+
+        private:
+            PerfHistogram &hist_;
+            uint32_t start_;
+        };
+
+        /**
+         * @brief Ressourcen eines FreeRTOS-Tasks
+         */
+        struct TaskPerf
+        {
+            const char *name;
+            uint32_t runTimeUs;        // Laufzeit seit Start (falls Laufzeitstatistik aktiv)
+            float cpuPercent;          // Anteil seit dem letzten Schnappschuss
+            uint32_t stackFreeMin;     // Stack-Reserve (High-Water-Mark) in Bytes
+            uint8_t priority;
+        };
+
+        /**
+         * @brief Heap-Zustand
+         */
+        struct HeapPerf
+        {
+            uint32_t freeBytes;
+            uint32_t minFreeBytes;     // Tiefststand seit Boot
+            uint32_t largestFreeBlock;
+        };
+
+        /**
+         * @brief Task- und Heap-Statistik erfassen
+         * @param tasks Zielpuffer
+         * @param maxTasks Größe des Puffers
+         * @param heap Heap-Zustand (Ausgabe)
+         * @return Anzahl erfasster Tasks
+         */
+        size_t collectSystemPerf(TaskPerf *tasks, size_t maxTasks, HeapPerf &heap);
+
+        /**
+         * @brief Alle Metriken, Tasks und Heap lesbar ausgeben
+         */
+        void logPerfSnapshot();
+
+        /**
+         * @brief Alle Metriken, Tasks und Heap als eine JSON-Zeile ausgeben
+         *
+         * Format: "PERF {...}" auf stdout - vom Host per grep herausfilterbar.
+         */
+        void printPerfJson();
+
+        /**
+         * @brief Zähler, Gauges und Histogramme zurücksetzen
+         */
+        void resetPerfCounters();
+
+    } // namespace monitor
+} // namespace tiny_turtle
@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file monitor/telemetry.h
+ * @brief Binärer Live-Telemetrie-Stream über die USB-Serial/JTAG-Konsole
+ *
+ * Tastet den RobotState mit fester Rate ab und sendet kompakte, COBS-gerahmte
+ * Frames mit Sequenznummer (Format: core/telemetry_frame.h). Der Produzent
+ * blockiert nie - passt ein Frame nicht in den TX-Puffer, wird er verworfen.
+ * Dekodierung auf dem Host: host/telemetry_decode.
+ *
+ * Über denselben Kanal exportiert exportTrace() den Trace-Ring (monitor/trace.h)
+ * für host/trace_export (Chrome-Trace-JSON / Perfetto).
+ */
+
+#include <cstdint>
+#include "../core/config.h"
+#include "../core/context.h"
+#include "trace.h"
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        /**
+         * @brief Laufzeit-Statistik der Telemetrie
+         */
+        struct TelemetryStats
+        {
+            uint32_t framesSent;
+            uint32_t framesDropped;
+            uint32_t avgCycles;    // Mittlere CPU-Takte pro Messpunkt
+            uint32_t maxCycles;    // Maximum seit Start
+            float cpuLoadPercent;  // Hochgerechnete Last bei aktueller Rate
+        };
+
+        /**
+         * @brief Telemetrie starten
+         * @param ctx Zu beobachtender Roboter
+         * @param rateHz Abtastrate in Hz
+         */
+        void startTelemetry(TurtleContext &ctx, uint32_t rateHz = config::TELEMETRY_RATE_HZ);
+        void startTelemetry(uint32_t rateHz = config::TELEMETRY_RATE_HZ);
+
+        /**
+         * @brief Telemetrie stoppen
+         */
+        void stopTelemetry();
+
+        /**
+         * @brief Prüfen ob die Telemetrie läuft
+         */
+        bool isTelemetryRunning();
+
+        /**
+         * @brief Statistik abfragen (Overhead-Messung)
+         */
+        TelemetryStats getTelemetryStats();
+
+        /**
+         * @brief Inhalt des Trace-Rings binär über den Telemetrie-Kanal senden
+         * @return Anzahl gesendeter Einträge
+         * @note Wartet bei vollem Sendepuffer - nicht während einer Bewegung aufrufen
+         */
+        size_t exportTrace();
+
+        /**
+         * @brief Statistik als Log-Zeile ausgeben
+         */
+        void logTelemetryStats();
+
+    } // namespace monitor
+} // namespace tiny_turtle
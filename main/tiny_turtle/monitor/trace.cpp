@@ -0,0 +1,190 @@
+/**
+ * @file monitor/trace.cpp
+ * @brief Implementierung des Ereignis-Trace (Gerät)
+ *
+ * Der Ring selbst steckt in trace_ring.h; hier kommen Zeitquelle,
+ * Platzierung im internen RAM und die verzögerte Formatierung dazu.
+ */
+
+#include "trace.h"
+#include "trace_ring.h"
+#include "../core/config.h"
+#include "../core/types.h"
+
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "monitor.trace";
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        static constexpr size_t RING_SIZE = config::TRACE_BUFFER_SIZE;
+
+        static TaskHandle_t s_task = nullptr;
+        // Statischer Stack: startTraceTask() darf auch nach init() laufen, ohne Heap
+        static StackType_t s_task_stack[config::TRACE_TASK_STACK_SIZE];
+        static StaticTask_t s_task_buffer;
+        static uint32_t s_task_cursor = 0;
+        static uint32_t s_lost = 0;
+
+#if TT_TRACE_LEVEL > TT_TRACE_LEVEL_NONE
+
+        static DRAM_ATTR TraceRing<RING_SIZE> s_ring;
+
+        void IRAM_ATTR traceRecord(TraceEvent event, uint32_t a, uint32_t b)
+        {
+            s_ring.record(static_cast<uint32_t>(esp_timer_get_time()), event, a, b);
+        }
+
+        size_t readTrace(uint32_t &cursor, TraceRecord *out, size_t max, uint32_t *lost)
+        {
+            return s_ring.read(cursor, out, max, lost);
+        }
+
+        TraceStats getTraceStats()
+        {
+            return {s_ring.recorded(), s_lost};
+        }
+
+#else
+
+        void traceRecord(TraceEvent, uint32_t, uint32_t) {}
+
+        size_t readTrace(uint32_t &, TraceRecord *, size_t, uint32_t *lost)
+        {
+            if (lost)
+                *lost = 0;
+            return 0;
+        }
+
+        TraceStats getTraceStats() { return {0, 0}; }
+
+#endif
+
+        //===========================================================================
+        // Formatierung (nur außerhalb des Motion-Pfads)
+        //===========================================================================
+
+        static void printRecord(const TraceRecord &rec)
+        {
+            static const char *const commands[] = {"STOP", "FORWARD", "BACKWARD", "SPIN_CW", "SPIN_CCW"};
+
+            switch (rec.event)
+            {
+            case TraceEvent::MOTOR_COMMAND:
+                ESP_LOGI(TAG, "%10lu %-16s %s (M1=%d, M2=%d)", rec.timestampUs, traceEventName(rec.event),
+                         rec.a < 5 ? commands[rec.a] : "?",
+                         static_cast<int8_t>(rec.b & 0xFF), static_cast<int8_t>((rec.b >> 8) & 0xFF));
+                break;
+            case TraceEvent::STEP_SPEED:
+            case TraceEvent::RAMP_DONE:
+                ESP_LOGI(TAG, "%10lu %-16s %lu µs/Schritt", rec.timestampUs, traceEventName(rec.event), rec.a);
+                break;
+            case TraceEvent::RAMP:
+            case TraceEvent::SMOOTH_STOP:
+                ESP_LOGI(TAG, "%10lu %-16s %lu Schritte", rec.timestampUs, traceEventName(rec.event), rec.a);
+                break;
+            case TraceEvent::ACCELERATE:
+            case TraceEvent::DECELERATE:
+                ESP_LOGI(TAG, "%10lu %-16s %lu -> %lu µs", rec.timestampUs, traceEventName(rec.event), rec.a, rec.b);
+                break;
+            case TraceEvent::SPAN_BEGIN:
+                ESP_LOGI(TAG, "%10lu > %s (%ld)", rec.timestampUs, traceSpanName(static_cast<TraceSpan>(rec.a)),
+                         static_cast<int32_t>(rec.b));
+                break;
+            case TraceEvent::SPAN_END:
+                ESP_LOGI(TAG, "%10lu < %s", rec.timestampUs, traceSpanName(static_cast<TraceSpan>(rec.a)));
+                break;
+            case TraceEvent::SMOOTH_STOP_DONE:
+                ESP_LOGI(TAG, "%10lu %-16s bei Schritt %ld", rec.timestampUs, traceEventName(rec.event),
+                         static_cast<int32_t>(rec.a));
+                break;
+            case TraceEvent::STEP_MODE:
+            {
+                static const char *const modes[] = {"HALF", "FULL", "WAVE", "MICRO"};
+                ESP_LOGI(TAG, "%10lu %-16s %s bei %lu µs", rec.timestampUs, traceEventName(rec.event),
+                         rec.a < 4 ? modes[rec.a] : "?", rec.b);
+                break;
+            }
+            case TraceEvent::SEGMENT_DONE:
+                ESP_LOGI(TAG, "%10lu %-16s bei Schritt %ld, weiter mit %s", rec.timestampUs, traceEventName(rec.event),
+                         static_cast<int32_t>(rec.b), rec.a < 5 ? commands[rec.a] : "?");
+                break;
+            default:
+                ESP_LOGI(TAG, "%10lu %-16s", rec.timestampUs, traceEventName(rec.event));
+                break;
+            }
+        }
+
+        static void printPending(uint32_t &cursor, bool countLost)
+        {
+            TraceRecord batch[16];
+            size_t n;
+            do
+            {
+                uint32_t lost = 0;
+                n = readTrace(cursor, batch, 16, &lost);
+                if (lost)
+                {
+                    if (countLost)
+                        s_lost += lost;
+                    ESP_LOGW(TAG, "%lu Einträge überschrieben", lost);
+                }
+                for (size_t i = 0; i < n; i++)
+                {
+                    printRecord(batch[i]);
+                }
+            } while (n == 16);
+        }
+
+        void dumpTrace()
+        {
+            TraceStats stats = getTraceStats();
+            uint32_t cursor = stats.recorded > RING_SIZE ? stats.recorded - RING_SIZE : 0;
+
+            ESP_LOGI(TAG, "--- Trace (%lu Einträge insgesamt) ---", stats.recorded);
+            printPending(cursor, false);
+        }
+
+        static void traceTask(void *)
+        {
+            for (;;)
+            {
+                printPending(s_task_cursor, true);
+                vTaskDelay(pdMS_TO_TICKS(config::TRACE_DUMP_INTERVAL_MS));
+            }
+        }
+
+        void startTraceTask()
+        {
+            if (s_task || TT_TRACE_LEVEL == TT_TRACE_LEVEL_NONE)
+                return;
+
+            s_task_cursor = getTraceStats().recorded;
+            s_task = xTaskCreateStatic(traceTask, "trace", config::TRACE_TASK_STACK_SIZE, nullptr,
+                                       config::TRACE_TASK_PRIORITY, s_task_stack, &s_task_buffer);
+            if (!s_task)
+            {
+                ESP_LOGE(TAG, "Trace-Task konnte nicht gestartet werden");
+                return;
+            }
+            ESP_LOGI(TAG, "Trace-Task gestartet (Stufe %d, %u Einträge)", TT_TRACE_LEVEL,
+                     static_cast<unsigned>(RING_SIZE));
+        }
+
+        void stopTraceTask()
+        {
+            if (!s_task)
+                return;
+
+            vTaskDelete(s_task);
+            s_task = nullptr;
+        }
+
+    } // namespace monitor
+} // namespace tiny_turtle
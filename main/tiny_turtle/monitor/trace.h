@@ -0,0 +1,222 @@
+#pragma once
+/**
+ * @file monitor/trace.h
+ * @brief Binärer Ereignis-Trace mit verzögerter Formatierung
+ *
+ * Statt printf-Formatierung und UART-Ausgabe im Motion-Pfad werden feste
+ * Binär-Records (Ereignis, Zeitstempel, zwei Argumente) in einen lock-freien
+ * RAM-Ring geschrieben. Das kostet nur einige Takte und ist auch aus der
+ * Stepper-ISR erlaubt. Formatiert wird später - im niederprioren Trace-Task
+ * oder bei einem expliziten dumpTrace().
+ *
+ * Zusätzlich gibt es Spannen (TT_TRACE_SPAN) für Bewegungen, Stift-Wartezeiten
+ * und Glyphen. Über exportTrace() (monitor/telemetry.h) landen die Einträge
+ * binär auf dem Host, host/trace_export erzeugt daraus Chrome-Trace-JSON für
+ * Perfetto (ui.perfetto.dev).
+ *
+ * Der Ring überschreibt die ältesten Einträge (Flugschreiber-Prinzip).
+ *
+ * Trace-Stufen werden zur Compile-Zeit gewählt, z.B. in main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE TT_TRACE_LEVEL=0)
+ * Deaktivierte Stufen erzeugen keinen Code; bei Stufe 0 entfällt auch der Ring.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#define TT_TRACE_LEVEL_NONE 0    // Kein Trace
+#define TT_TRACE_LEVEL_INFO 1    // API-Aufrufe aus Tasks (Befehle, Geschwindigkeit, Rampen)
+#define TT_TRACE_LEVEL_VERBOSE 2 // Zusätzlich Ereignisse aus der Stepper-ISR
+
+#ifndef TT_TRACE_LEVEL
+#define TT_TRACE_LEVEL TT_TRACE_LEVEL_INFO
+#endif
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+        /**
+         * @brief Trace-Ereignisse (Bedeutung der Argumente a/b siehe Kommentar)
+         */
+        enum class TraceEvent : uint16_t
+        {
+            MOTOR_COMMAND,    // a = MotorCommand, b = M1-Richtung | (M2-Richtung << 8)
+            STEP_SPEED,       // a = Intervall in µs
+            RAMP,             // a = Rampenlänge in Schritten
+            ACCELERATE,       // a = Start-Intervall, b = Ziel-Intervall (µs)
+            DECELERATE,       // a = Start-Intervall, b = Ziel-Intervall (µs)
+            SMOOTH_STOP,      // a = Rampenlänge in Schritten
+            TIMER_START,      //
+            TIMER_STOP,       //
+            RAMP_DONE,        // ISR: a = erreichtes Intervall in µs
+            SMOOTH_STOP_DONE, // ISR: a = Schrittzähler
+            SPAN_BEGIN,       // a = TraceSpan, b = Argument (siehe TraceSpan)
+            SPAN_END,         // a = TraceSpan
+            SEGMENT_DONE,     // ISR: a = nächster MotorCommand (STOP = letztes Segment), b = Schrittzähler
+            STEP_MODE,        // ISR: a = StepMode (HALF/FULL/WAVE/MICRO), b = Intervall in µs
+            COUNT
+        };
+
+        /**
+         * @brief Zeitspannen für den Timeline-Export (Argument b bei SPAN_BEGIN)
+         */
+        enum class TraceSpan : uint16_t
+        {
+            MOVE,      // Distanz in 0.1 mm (vorzeichenbehaftet)
+            TURN,      // Winkel in 0.1° (vorzeichenbehaftet)
+            GOTO,      // Ziel: X | (Y << 16), je int16 in 0.1 mm
+            PEN_UP,    // Servo-Winkel
+            PEN_DOWN,  // Servo-Winkel
+            PLOT_CHAR, // Zeichen (ASCII)
+            TIMELINE,  // Anzahl Datensätze (motion::playTimeline)
+            COUNT
+        };
+
+        /**
+         * @brief Ein gelesener Trace-Eintrag
+         */
+        struct TraceRecord
+        {
+            uint32_t index;       // Laufende Nummer seit Start
+            uint32_t timestampUs; // esp_timer-Zeit
+            TraceEvent event;
+            uint32_t a;
+            uint32_t b;
+        };
+
+        /**
+         * @brief Zähler des Trace-Rings
+         */
+        struct TraceStats
+        {
+            uint32_t recorded; // Insgesamt geschriebene Einträge
+            uint32_t lost;     // Vom Trace-Task nicht rechtzeitig gelesene (überschrieben)
+        };
+
+        /**
+         * @brief Eintrag schreiben (ISR-safe, blockiert nie)
+         * @note Nicht direkt aufrufen - TT_TRACE() / TT_TRACE_ISR() verwenden
+         */
+        void traceRecord(TraceEvent event, uint32_t a, uint32_t b);
+
+        /**
+         * @brief Name eines Ereignisses
+         */
+        inline const char *traceEventName(TraceEvent event)
+        {
+            static const char *const names[] = {
+                "MOTOR_COMMAND", "STEP_SPEED", "RAMP", "ACCELERATE", "DECELERATE", "SMOOTH_STOP",
+                "TIMER_START", "TIMER_STOP", "RAMP_DONE", "SMOOTH_STOP_DONE", "SPAN_BEGIN", "SPAN_END",
+                "SEGMENT_DONE", "STEP_MODE"};
+            static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(TraceEvent::COUNT),
+                          "Namen passen nicht zu TraceEvent");
+
+            size_t idx = static_cast<size_t>(event);
+            return idx < static_cast<size_t>(TraceEvent::COUNT) ? names[idx] : "?";
+        }
+
+        /**
+         * @brief Name einer Zeitspanne
+         */
+        inline const char *traceSpanName(TraceSpan span)
+        {
+            static const char *const names[] = {"move", "turn", "goTo", "penUp", "penDown", "plotChar", "timeline"};
+            static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(TraceSpan::COUNT),
+                          "Namen passen nicht zu TraceSpan");
+
+            size_t idx = static_cast<size_t>(span);
+            return idx < static_cast<size_t>(TraceSpan::COUNT) ? names[idx] : "?";
+        }
+
+        /**
+         * @brief Zielpunkt als Span-Argument packen (GOTO: X | (Y << 16) in 0.1 mm)
+         */
+        inline uint32_t tracePackXY(float xMm, float yMm)
+        {
+            uint16_t x = static_cast<uint16_t>(static_cast<int16_t>(xMm * 10.0f));
+            uint16_t y = static_cast<uint16_t>(static_cast<int16_t>(yMm * 10.0f));
+            return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 16);
+        }
+
+        /**
+         * @brief Zeichnet eine Zeitspanne für die Lebensdauer des Objekts auf
+         * @note Nicht direkt verwenden - TT_TRACE_SPAN() nutzen
+         */
+        class TraceScope
+        {
+        public:
+            TraceScope(TraceSpan span, uint32_t arg) : span_(span)
+            {
+                traceRecord(TraceEvent::SPAN_BEGIN, static_cast<uint32_t>(span), arg);
+            }
+            ~TraceScope()
+            {
+                traceRecord(TraceEvent::SPAN_END, static_cast<uint32_t>(span_), 0);
+            }
+
+            TraceScope(const TraceScope &) = delete;
+            TraceScope &operator=(const TraceScope &) = delete;
+
+        private:
+            TraceSpan span_;
+        };
+
+        /**
+         * @brief Neue Einträge ab einer Lese-Position kopieren
+         * @param cursor Lese-Position (0 beim ersten Aufruf), wird weitergezählt
+         * @param out Zielpuffer
+         * @param max Größe des Zielpuffers
+         * @param lost Optional: Anzahl übersprungener (bereits überschriebener) Einträge
+         * @return Anzahl kopierter Einträge
+         */
+        size_t readTrace(uint32_t &cursor, TraceRecord *out, size_t max, uint32_t *lost = nullptr);
+
+        /**
+         * @brief Alle noch im Ring vorhandenen Einträge formatiert ausgeben
+         */
+        void dumpTrace();
+
+        /**
+         * @brief Niederprioren Task starten, der neue Einträge periodisch ausgibt
+         */
+        void startTraceTask();
+
+        /**
+         * @brief Trace-Task beenden
+         */
+        void stopTraceTask();
+
+        /**
+         * @brief Zähler abfragen
+         */
+        TraceStats getTraceStats();
+
+    } // namespace monitor
+} // namespace tiny_turtle
+
+//===========================================================================
+// Trace-Makros (entfallen vollständig unterhalb der gewählten Stufe)
+//===========================================================================
+
+#if TT_TRACE_LEVEL >= TT_TRACE_LEVEL_INFO
+#define TT_TRACE(event, a, b)                                                                \
+    ::tiny_turtle::monitor::traceRecord(::tiny_turtle::monitor::TraceEvent::event,            \
+                                        static_cast<uint32_t>(a), static_cast<uint32_t>(b))
+#define TT_TRACE_CONCAT_(x, y) x##y
+#define TT_TRACE_CONCAT(x, y) TT_TRACE_CONCAT_(x, y)
+#define TT_TRACE_SPAN(span, arg)                                                             \
+    ::tiny_turtle::monitor::TraceScope TT_TRACE_CONCAT(ttTraceSpan_, __LINE__)(              \
+        ::tiny_turtle::monitor::TraceSpan::span, static_cast<uint32_t>(arg))
+#else
+#define TT_TRACE(event, a, b) ((void)0)
+#define TT_TRACE_SPAN(span, arg) ((void)0)
+#endif
+
+#if TT_TRACE_LEVEL >= TT_TRACE_LEVEL_VERBOSE
+#define TT_TRACE_ISR(event, a, b)                                                            \
+    ::tiny_turtle::monitor::traceRecord(::tiny_turtle::monitor::TraceEvent::event,            \
+                                        static_cast<uint32_t>(a), static_cast<uint32_t>(b))
+#else
+#define TT_TRACE_ISR(event, a, b) ((void)0)
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file monitor/trace_frame.h
+ * @brief Binäres Frame-Format für exportierte Trace-Einträge
+ *
+ * Läuft über denselben Kanal wie die Telemetrie (core/telemetry_frame.h),
+ * unterscheidet sich nur im Frame-Typ. Aufbau (Little-Endian, vor COBS):
+ *
+ * | Offset | Typ  | Inhalt                      |
+ * |--------|------|-----------------------------|
+ * | 0      | u8   | Frame-Typ (FRAME_TYPE_TRACE)|
+ * | 1      | u32  | Laufende Nummer             |
+ * | 5      | u32  | Zeitstempel in µs           |
+ * | 9      | u16  | TraceEvent                  |
+ * | 11     | u32  | Argument a                  |
+ * | 15     | u32  | Argument b                  |
+ * | 19     | u8   | CRC-8 über Byte 0-18        |
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/cobs.h"
+#include "../core/telemetry_frame.h"
+#include "trace.h"
+
+namespace tiny_turtle
+{
+    namespace telemetry
+    {
+        constexpr uint8_t FRAME_TYPE_TRACE = 0x52; // 'R'
+        constexpr size_t TRACE_FRAME_RAW_SIZE = 20;
+        constexpr size_t TRACE_FRAME_WIRE_SIZE = cobs::maxEncodedSize(TRACE_FRAME_RAW_SIZE) + 2;
+
+        /**
+         * @brief Trace-Eintrag in ein Roh-Frame packen
+         */
+        inline void packTrace(const monitor::TraceRecord &rec, uint8_t *raw)
+        {
+            using namespace detail;
+
+            raw[0] = FRAME_TYPE_TRACE;
+            put32(raw + 1, rec.index);
+            put32(raw + 5, rec.timestampUs);
+            put16(raw + 9, static_cast<uint16_t>(rec.event));
+            put32(raw + 11, rec.a);
+            put32(raw + 15, rec.b);
+            raw[19] = cobs::crc8(raw, TRACE_FRAME_RAW_SIZE - 1);
+        }
+
+        /**
+         * @brief Roh-Frame entpacken und prüfen
+         * @return false bei falscher Länge, falschem Typ oder CRC-Fehler
+         */
+        inline bool unpackTrace(const uint8_t *raw, size_t len, monitor::TraceRecord &rec)
+        {
+            using namespace detail;
+
+            if (len != TRACE_FRAME_RAW_SIZE || raw[0] != FRAME_TYPE_TRACE)
+                return false;
+            if (cobs::crc8(raw, TRACE_FRAME_RAW_SIZE - 1) != raw[19])
+                return false;
+
+            rec.index = get32(raw + 1);
+            rec.timestampUs = get32(raw + 5);
+            rec.event = static_cast<monitor::TraceEvent>(get16(raw + 9));
+            rec.a = get32(raw + 11);
+            rec.b = get32(raw + 15);
+            return true;
+        }
+
+        /**
+         * @brief Trace-Eintrag als Leitungs-Frame kodieren (0x00 + COBS + 0x00)
+         * @param wire Puffer mit mindestens TRACE_FRAME_WIRE_SIZE Bytes
+         * @return Anzahl Bytes inklusive Trenner
+         */
+        inline size_t encodeTraceFrame(const monitor::TraceRecord &rec, uint8_t *wire)
+        {
+            uint8_t raw[TRACE_FRAME_RAW_SIZE];
+            packTrace(rec, raw);
+            wire[0] = 0x00;
+            size_t n = 1 + cobs::encode(raw, TRACE_FRAME_RAW_SIZE, wire + 1);
+            wire[n++] = 0x00;
+            return n;
+        }
+
+    } // namespace telemetry
+} // namespace tiny_turtle
@@ -0,0 +1,129 @@
+#pragma once
+/**
+ * @file monitor/trace_ring.h
+ * @brief Lock-freier Ring für Trace-Einträge (überschreibt die ältesten)
+ *
+ * Schreiber reservieren einen Platz per atomarem fetch_add auf dem Kopf-Index
+ * und markieren ihn während des Schreibens als ungültig (seq = 0). Leser
+ * prüfen die Sequenznummer vor und nach dem Kopieren und verwerfen Einträge,
+ * die inzwischen überschrieben wurden.
+ *
+ * Header-only und ohne ESP-IDF-Abhängigkeit: die Zeitquelle übergibt der
+ * Aufrufer (Gerät: esp_timer, Simulation auf dem Host: steady_clock).
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "trace.h"
+#include "../core/isr_attr.h"
+
+namespace tiny_turtle
+{
+    namespace monitor
+    {
+
+        template <size_t N>
+        class TraceRing
+        {
+            static_assert(N >= 2 && (N & (N - 1)) == 0, "Trace-Ring-Größe muss eine Zweierpotenz sein");
+
+        public:
+            TraceRing() = default;
+            TraceRing(const TraceRing &) = delete;
+            TraceRing &operator=(const TraceRing &) = delete;
+
+            /**
+             * @brief Eintrag schreiben (ISR-safe, blockiert nie)
+             */
+            TT_ISR_INLINE void record(uint32_t timestampUs, TraceEvent event, uint32_t a, uint32_t b)
+            {
+                uint32_t idx = head_.fetch_add(1, std::memory_order_relaxed);
+                Slot &slot = slots_[idx & (N - 1)];
+
+                slot.seq.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                slot.timestampUs = timestampUs;
+                slot.event = static_cast<uint16_t>(event);
+                slot.a = a;
+                slot.b = b;
+
+                slot.seq.store(idx + 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Einträge ab cursor kopieren (siehe monitor::readTrace)
+             */
+            size_t read(uint32_t &cursor, TraceRecord *out, size_t max, uint32_t *lost) const
+            {
+                uint32_t head = head_.load(std::memory_order_acquire);
+                uint32_t skipped = 0;
+
+                // Bereits überschriebene Einträge überspringen
+                if (head - cursor > N)
+                {
+                    skipped = head - cursor - N;
+                    cursor = head - N;
+                }
+
+                size_t n = 0;
+                while (cursor != head && n < max)
+                {
+                    const Slot &slot = slots_[cursor & (N - 1)];
+                    uint32_t before = slot.seq.load(std::memory_order_acquire);
+
+                    TraceRecord rec = {
+                        .index = cursor,
+                        .timestampUs = slot.timestampUs,
+                        .event = static_cast<TraceEvent>(slot.event),
+                        .a = slot.a,
+                        .b = slot.b,
+                    };
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    uint32_t after = slot.seq.load(std::memory_order_relaxed);
+
+                    int32_t age = static_cast<int32_t>(before - (cursor + 1));
+                    if (age == 0 && after == before)
+                    {
+                        out[n++] = rec;
+                    }
+                    else if (age < 0 || before == 0)
+                    {
+                        break; // Reserviert, aber noch nicht fertig geschrieben - später lesen
+                    }
+                    else
+                    {
+                        skipped++; // Während des Lesens überschrieben
+                    }
+                    cursor++;
+                }
+
+                if (lost)
+                    *lost = skipped;
+                return n;
+            }
+
+            /**
+             * @brief Anzahl insgesamt geschriebener Einträge
+             */
+            uint32_t recorded() const { return head_.load(std::memory_order_relaxed); }
+
+            static constexpr size_t capacity() { return N; }
+
+        private:
+            struct Slot
+            {
+                std::atomic<uint32_t> seq{0}; // Index + 1 wenn gültig, 0 während des Schreibens
+                uint32_t timestampUs;
+                uint16_t event;
+                uint32_t a;
+                uint32_t b;
+            };
+
+            Slot slots_[N];
+            std::atomic<uint32_t> head_{0};
+        };
+
+    } // namespace monitor
+} // namespace tiny_turtle
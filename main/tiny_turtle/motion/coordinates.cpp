@@ -5,90 +5,51 @@
 
 #include "coordinates.h"
 #include "motion.h"
+#include "motion_core.h"
+#include "../hal/device_hal.h"
 #include "../hal/servo.h"
 #include "../math/trigonometry.h"
-#include "../core/globals.h"
-#include <cmath>
+#include "../core/context.h"
 
 namespace tiny_turtle
 {
     namespace motion
     {
 
-        // Aktuelle Position des Roboters
-        static float currentX = 0.0f;
-        static float currentY = 0.0f;
-        static float currentHeading = 0.0f; // 0 = nach vorne (positive Y)
-
-        void resetPosition()
+        static void publishPose(TurtleContext &ctx)
         {
-            currentX = 0.0f;
-            currentY = 0.0f;
-            currentHeading = 0.0f;
+            ctx.state.setPose(ctx.pose.x, ctx.pose.y, ctx.pose.heading);
         }
 
-        void setPosition(float x, float y, float heading)
+        void resetPosition(TurtleContext &ctx)
         {
-            currentX = x;
-            currentY = y;
-            currentHeading = heading;
+            ctx.pose = {0.0f, 0.0f, 0.0f};
+            publishPose(ctx);
         }
 
-        Point2D getPosition()
+        void setPosition(TurtleContext &ctx, float x, float y, float heading)
         {
-            return {currentX, currentY};
+            ctx.pose = {x, y, heading};
+            publishPose(ctx);
         }
 
-        float getHeading()
+        Point2D getPosition(const TurtleContext &ctx)
         {
-            return currentHeading;
+            return {ctx.pose.x, ctx.pose.y};
         }
 
-        void goTo(float targetX, float targetY, bool penDown)
+        float getHeading(const TurtleContext &ctx)
         {
-            // Differenz berechnen
-            float dx = targetX - currentX;
-            float dy = targetY - currentY;
-
-            // Distanz und Winkel berechnen
-            float distance = sqrt(dx * dx + dy * dy);
-            float targetAngle = atan2(dx, dy) * 180.0f / M_PI; // atan2(x,y) für Heading-Konvention
-
-            // Winkel zum Ziel drehen
-            float turnAngle = targetAngle - currentHeading;
-
-            // Winkel normalisieren auf -180 bis 180
-            while (turnAngle > 180.0f)
-                turnAngle -= 360.0f;
-            while (turnAngle < -180.0f)
-                turnAngle += 360.0f;
-
-            // Drehen wenn nötig
-            if (abs(turnAngle) > 1.0f)
-            {
-                turn(turnAngle);
-                currentHeading = targetAngle;
-            }
-
-            // Zum Ziel fahren
-            if (penDown)
-            {
-                hal::penDown();
-            }
-
-            forward(distance);
-
-            if (penDown)
-            {
-                hal::penUp();
-            }
+            return ctx.pose.heading;
+        }
 
-            // Position aktualisieren
-            currentX = targetX;
-            currentY = targetY;
+        void goTo(TurtleContext &ctx, float targetX, float targetY, bool penDown)
+        {
+            hal::DeviceHal device(ctx);
+            MotionCore<hal::DeviceHal>(device, ctx.hot).goTo(ctx.pose, targetX, targetY, penDown);
         }
 
-        void drawCoordinates(const uint8_t *coords, int count, float scale)
+        void drawCoordinates(TurtleContext &ctx, const uint8_t *coords, int count, float scale)
         {
             // Koordinaten sind als X,Y Paare kodiert
             for (int i = 0; i < count; i += 2)
@@ -99,41 +60,68 @@ namespace tiny_turtle
                 if (i == 0)
                 {
                     // Zum ersten Punkt ohne Zeichnen
-                    goTo(x, y, false);
-                    hal::penDown();
+                    goTo(ctx, x, y, false);
+                    hal::penDown(ctx);
                 }
                 else
                 {
-                    goTo(x, y, true);
+                    goTo(ctx, x, y, true);
                 }
             }
-            hal::penUp();
+            hal::penUp(ctx);
         }
 
-        void drawShape(const Point2D *points, int count, bool closed)
+        void drawShape(TurtleContext &ctx, const Point2D *points, int count, bool closed)
         {
             if (count < 2)
                 return;
 
             // Zum ersten Punkt
-            goTo(points[0].x, points[0].y, false);
-            hal::penDown();
+            goTo(ctx, points[0].x, points[0].y, false);
+            hal::penDown(ctx);
 
             // Alle weiteren Punkte
             for (int i = 1; i < count; i++)
             {
-                goTo(points[i].x, points[i].y, true);
+                goTo(ctx, points[i].x, points[i].y, true);
             }
 
             // Zurück zum Start wenn geschlossen
             if (closed)
             {
-                goTo(points[0].x, points[0].y, true);
+                goTo(ctx, points[0].x, points[0].y, true);
             }
 
-            hal::penUp();
+            hal::penUp(ctx);
         }
 
+        void drawPath(TurtleContext &ctx, const PathBuffer &path)
+        {
+            const PathCoord *xs = path.x();
+            const PathCoord *ys = path.y();
+            const uint8_t *flags = path.flags();
+
+            for (size_t i = 0; i < path.size(); i++)
+            {
+                float x = pathCoordToMm(xs[i]);
+                float y = pathCoordToMm(ys[i]);
+                // goTo() senkt den Stift nur für die Fahrt selbst
+                bool draw = i > 0 && !(flags[i] & PATH_STROKE_START) && (flags[i] & PATH_PEN_DOWN);
+                goTo(ctx, x, y, draw);
+            }
+            hal::penUp(ctx);
+        }
+
+        // Kurzformen auf defaultContext()
+        void resetPosition() { resetPosition(defaultContext()); }
+        void setPosition(float x, float y, float heading) { setPosition(defaultContext(), x, y, heading); }
+        Point2D getPosition() { return getPosition(defaultContext()); }
+        float getHeading() { return getHeading(defaultContext()); }
+        void goTo(float x, float y, bool penDown) { goTo(defaultContext(), x, y, penDown); }
+        void drawCoordinates(const uint8_t *coords, int count, float scale) { drawCoordinates(defaultContext(), coords, count, scale); }
+        void drawShape(const Point2D *points, int count, bool closed) { drawShape(defaultContext(), points, count, closed); }
+        void drawPath(const PathBuffer &path) { drawPath(defaultContext(), path); }
+
     } // namespace motion
 } // namespace tiny_turtle
 
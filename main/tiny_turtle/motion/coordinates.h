@@ -5,6 +5,8 @@
  */
 
 #include "../core/types.h"
+#include "../core/context.h"
+#include "../core/path_buffer.h"
 #include <cstdint>
 
 namespace tiny_turtle
@@ -15,21 +17,25 @@ namespace tiny_turtle
         /**
          * @brief Position zurücksetzen
          */
+        void resetPosition(TurtleContext &ctx);
         void resetPosition();
 
         /**
          * @brief Position manuell setzen
          */
+        void setPosition(TurtleContext &ctx, float x, float y, float heading);
         void setPosition(float x, float y, float heading);
 
         /**
          * @brief Aktuelle Position abfragen
          */
+        Point2D getPosition(const TurtleContext &ctx);
         Point2D getPosition();
 
         /**
          * @brief Aktuelle Ausrichtung abfragen (in Grad)
          */
+        float getHeading(const TurtleContext &ctx);
         float getHeading();
 
         /**
@@ -38,6 +44,7 @@ namespace tiny_turtle
          * @param y Ziel-Y in mm
          * @param penDown Mit Stift zeichnen?
          */
+        void goTo(TurtleContext &ctx, float x, float y, bool penDown = false);
         void goTo(float x, float y, bool penDown = false);
 
         /**
@@ -46,6 +53,7 @@ namespace tiny_turtle
          * @param count Anzahl der Werte (nicht Punkte!)
          * @param scale Skalierungsfaktor
          */
+        void drawCoordinates(TurtleContext &ctx, const uint8_t *coords, int count, float scale = 1.0f);
         void drawCoordinates(const uint8_t *coords, int count, float scale = 1.0f);
 
         /**
@@ -54,8 +62,18 @@ namespace tiny_turtle
          * @param count Anzahl Punkte
          * @param closed Zurück zum Start?
          */
+        void drawShape(TurtleContext &ctx, const Point2D *points, int count, bool closed = true);
         void drawShape(const Point2D *points, int count, bool closed = true);
 
+        /**
+         * @brief PathBuffer abfahren
+         *
+         * Zum ersten Punkt und zu Punkten mit PATH_STROKE_START ohne Zeichnen,
+         * sonst mit Stift unten, wenn PATH_PEN_DOWN gesetzt ist.
+         */
+        void drawPath(TurtleContext &ctx, const PathBuffer &path);
+        void drawPath(const PathBuffer &path);
+
         /**
          * @brief Koordinaten-Zeichnung ausführen (Legacy)
          * @param scale Skalierungsfaktor
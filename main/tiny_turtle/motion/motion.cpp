@@ -1,150 +1,68 @@
 /**
  * @file motion/motion.cpp
  * @brief Implementierung der Bewegungsfunktionen
+ *
+ * Die Schritt-Schleifen stehen in motion/motion_core.h und laufen hier auf
+ * dem Hardware-Backend hal::DeviceHal.
  */
 
 #include "motion.h"
-#include "../core/config.h"
-#include "../core/globals.h"
-#include "../hal/stepper.h"
-#include "../hal/servo.h"
-#include "../hal/sensors.h"
-#include "../hal/gpio_hal.h"
-#include <cmath>
+#include "motion_core.h"
+#include "../core/context.h"
+#include "../hal/device_hal.h"
 
 namespace tiny_turtle
 {
     namespace motion
     {
 
-        using namespace config;
+        using DeviceMotion = MotionCore<hal::DeviceHal>;
 
-        bool move(float distanceMm, bool bounceAtObstacle)
+        bool move(TurtleContext &ctx, float distanceMm, bool bounceAtObstacle)
         {
-            uint16_t targetSteps = static_cast<uint16_t>(STEPS_PER_MM * std::abs(distanceMm));
-            uint16_t halfTarget = targetSteps / 2;
-            delayValue = 2000;
-
-            for (uint16_t i = 0; i < targetSteps; i++)
-            {
-                hal::stepMotor(1, direction);
-                hal::stepMotor(2, direction);
-
-                if (i < halfTarget)
-                {
-                    delayValue -= RAMP_VALUE;
-                }
-                else
-                {
-                    delayValue += RAMP_VALUE;
-                }
-                delayMicroseconds(constrain(delayValue, MIN_STEP_DELAY_US, MAX_STEP_DELAY_US));
-
-                if (bounceAtObstacle)
-                    bounce();
-            }
-            hal::stopMotors();
+            hal::DeviceHal device(ctx);
+            DeviceMotion(device, ctx.hot).move(distanceMm, bounceAtObstacle);
             return true;
         }
 
-        void bounce()
+        void bounce(TurtleContext &ctx)
         {
-            bool penState = drawing;
-
-            auto bumpers = hal::readBumpers();
-            if (bumpers.front)
-                direction = -1;
-            if (bumpers.back)
-                direction = 1;
-
-            while (hal::isBumperPressed())
-            {
-                hal::penUp();
-                int randomDir = random(2) ? -1 : 1;
-
-                while (hal::isBumperPressed())
-                {
-                    turn(randomDir);
-                }
-                turn(randomDir * random(5, 45));
-            }
-
-            if (penState)
-                hal::penDown();
+            hal::DeviceHal device(ctx);
+            DeviceMotion(device, ctx.hot).bounce();
         }
 
-        void forward(float distanceMm)
+        void forward(TurtleContext &ctx, float distanceMm)
         {
-            direction = 1;
-            move(distanceMm);
+            ctx.hot.direction = 1;
+            move(ctx, distanceMm);
         }
 
-        void backward(float distanceMm)
+        void backward(TurtleContext &ctx, float distanceMm)
         {
-            direction = -1;
-            move(distanceMm);
+            ctx.hot.direction = -1;
+            move(ctx, distanceMm);
         }
 
-        void turn(float degrees, int turningDirection)
+        void turn(TurtleContext &ctx, float degrees, int turningDirection)
         {
-            if (degrees < 0)
-            {
-                degrees = -degrees;
-                turningDirection *= -1;
-            }
-
-            while (degrees >= 360)
-                degrees -= 360;
-
-            uint16_t targetSteps = static_cast<uint16_t>(degrees * STEPS_PER_360_ROTATION / 360 + 0.5f);
-            uint16_t halfTarget = targetSteps / 2;
-            delayValue = 2000;
-
-            for (uint16_t i = 0; i < targetSteps; i++)
-            {
-                hal::stepMotor(1, -turningDirection);
-                hal::stepMotor(2, turningDirection);
-
-                if (i < halfTarget)
-                {
-                    delayValue -= RAMP_VALUE;
-                }
-                else
-                {
-                    delayValue += RAMP_VALUE;
-                }
-                delayMicroseconds(constrain(delayValue, MIN_STEP_DELAY_US, MAX_STEP_DELAY_US));
-            }
+            hal::DeviceHal device(ctx);
+            DeviceMotion(device, ctx.hot).turn(degrees, turningDirection);
         }
 
-        void smartTurn(float angle)
+        void smartTurn(TurtleContext &ctx, float angle)
         {
-            while (angle > 180)
-                angle -= 360;
-            while (angle <= -180)
-                angle += 360;
-
-            float optimized = angle;
-
-            if (optimized > 90)
-            {
-                direction *= -1;
-                optimized -= 180;
-            }
-            else if (optimized < -90)
-            {
-                direction *= -1;
-                optimized += 180;
-            }
-            else if (optimized == 180 || optimized == -180)
-            {
-                direction *= -1;
-                optimized = 0;
-            }
-
-            turn(optimized, 1);
+            hal::DeviceHal device(ctx);
+            DeviceMotion(device, ctx.hot).smartTurn(angle);
         }
 
+        // Kurzformen auf defaultContext()
+        bool move(float distanceMm, bool bounceAtObstacle) { return move(defaultContext(), distanceMm, bounceAtObstacle); }
+        void bounce() { bounce(defaultContext()); }
+        void forward(float distanceMm) { forward(defaultContext(), distanceMm); }
+        void backward(float distanceMm) { backward(defaultContext(), distanceMm); }
+        void turn(float degrees, int turningDirection) { turn(defaultContext(), degrees, turningDirection); }
+        void smartTurn(float angle) { smartTurn(defaultContext(), angle); }
+
     } // namespace motion
 } // namespace tiny_turtle
 
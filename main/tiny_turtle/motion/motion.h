@@ -5,22 +5,27 @@
  */
 
 #include <cstdint>
+#include "../core/context.h"
 
 namespace tiny_turtle
 {
     namespace motion
     {
+        // Jede Funktion gibt es mit explizitem Kontext und als Kurzform,
+        // die auf defaultContext() arbeitet.
 
         /**
          * @brief Vorwärts bewegen
          * @param distanceMm Distanz in Millimetern
          */
+        void forward(TurtleContext &ctx, float distanceMm);
         void forward(float distanceMm);
 
         /**
          * @brief Rückwärts bewegen
          * @param distanceMm Distanz in Millimetern
          */
+        void backward(TurtleContext &ctx, float distanceMm);
         void backward(float distanceMm);
 
         /**
@@ -29,6 +34,7 @@ namespace tiny_turtle
          * @param bounceAtObstacle Bei Kollision ausweichen
          * @return true wenn erfolgreich
          */
+        bool move(TurtleContext &ctx, float distanceMm, bool bounceAtObstacle = true);
         bool move(float distanceMm, bool bounceAtObstacle = true);
 
         /**
@@ -36,17 +42,20 @@ namespace tiny_turtle
          * @param degrees Winkel in Grad
          * @param clockwise true = Uhrzeigersinn
          */
+        void turn(TurtleContext &ctx, float degrees, int turningDirection = 1);
         void turn(float degrees, int turningDirection = 1);
 
         /**
          * @brief Optimierte Drehung (max 90°)
          * @param angle Zielwinkel
          */
+        void smartTurn(TurtleContext &ctx, float angle);
         void smartTurn(float angle);
 
         /**
          * @brief Bei Kollision ausweichen
          */
+        void bounce(TurtleContext &ctx);
         void bounce();
 
     } // namespace motion
@@ -0,0 +1,290 @@
+#pragma once
+/**
+ * @file motion/motion_core.h
+ * @brief Blockierende Bewegungen, templatisiert auf ein HAL-Backend
+ *
+ * Die Schritt-Schleifen von move(), turn(), bounce(), smartTurn() und goTo()
+ * laufen gegen die statische Schnittstelle aus hal/hal_backend.h.
+ * motion/motion.cpp instanziiert sie mit hal::DeviceHal; Host-Werkzeuge fahren dieselben
+ * Schleifen mit host::SimHal oder host::RecordingHal (host/motion_sim).
+ *
+ *   host::SimHal sim;
+ *   HotState hot{};
+ *   hot.direction = 1;
+ *   motion::MotionCore<host::SimHal>(sim, hot).move(100.0f);
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "../core/config.h"
+#include "../core/context.h"
+#include "../core/kinematics.h"
+#include "../hal/hal_backend.h"
+#include "../monitor/trace.h"
+
+namespace tiny_turtle
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Drehung und Strecke eines goTo()
+         */
+        struct GoToPlan
+        {
+            float distance;    // Strecke in mm
+            float targetAngle; // Heading am Ziel
+            float turnAngle;   // Drehung, auf -180..180 normalisiert
+            bool turns;        // Nur Drehungen über 1° werden gefahren
+        };
+
+        /**
+         * @brief goTo() vorausberechnen, ohne zu fahren
+         *
+         * Host-Planer ermitteln damit die Pose am Anfang jedes Abschnitts, ohne
+         * die Schritte davor zu erzeugen (host/path_planner.h).
+         */
+        inline GoToPlan planGoTo(const Pose &pose, float targetX, float targetY)
+        {
+            // Differenz berechnen
+            float dx = targetX - pose.x;
+            float dy = targetY - pose.y;
+
+            // Distanz und Winkel berechnen
+            GoToPlan plan;
+            plan.distance = std::sqrt(dx * dx + dy * dy);
+            plan.targetAngle = std::atan2(static_cast<double>(dx), static_cast<double>(dy)) * 180.0f / M_PI; // atan2(x,y) für Heading-Konvention
+
+            // Winkel zum Ziel drehen
+            float turnAngle = plan.targetAngle - pose.heading;
+
+            // Winkel normalisieren auf -180 bis 180
+            while (turnAngle > 180.0f)
+                turnAngle -= 360.0f;
+            while (turnAngle < -180.0f)
+                turnAngle += 360.0f;
+
+            plan.turnAngle = turnAngle;
+            plan.turns = std::fabs(turnAngle) > 1.0f;
+            return plan;
+        }
+
+        /**
+         * @brief Pose nach einem goTo() (wie MotionCore::goTo)
+         */
+        inline void advancePose(Pose &pose, float targetX, float targetY)
+        {
+            GoToPlan plan = planGoTo(pose, targetX, targetY);
+            if (plan.turns)
+                pose.heading = plan.targetAngle;
+            pose.x = targetX;
+            pose.y = targetY;
+        }
+
+        /**
+         * @brief Rampe der blockierenden Bewegungen
+         *
+         * Das Gerät fährt mit defaultTuning() (core/config.h, Stepper-Profil);
+         * host/tune_motion setzt andere Werte, um sie zu vergleichen.
+         */
+        struct MotionTuning
+        {
+            uint16_t minStepDelayUs; // Kürzeste Verzögerung (Höchstgeschwindigkeit)
+            uint16_t maxStepDelayUs; // Längste Verzögerung
+            uint16_t rampValue;      // Änderung der Verzögerung pro Schritt
+        };
+
+        inline MotionTuning defaultTuning()
+        {
+            return {ActiveKinematics::minStepDelayUs(), ActiveKinematics::maxStepDelayUs(), config::RAMP_VALUE};
+        }
+
+        template <class Hal>
+        class MotionCore
+        {
+            static_assert(hal::isHalBackend<Hal>, "Hal muss von hal::HalBackend<Hal> erben");
+
+        public:
+            MotionCore(Hal &hal, HotState &hot, const MotionTuning &tuning = defaultTuning())
+                : hal_(hal), hot_(hot), tuning_(tuning) {}
+
+            /**
+             * @brief Geradeaus in hot.direction fahren (Rampe auf und ab)
+             */
+            void move(float distanceMm, bool bounceAtObstacle = false)
+            {
+                TT_TRACE_SPAN(MOVE, static_cast<int32_t>(distanceMm * hot_.direction * 10.0f));
+                hal_.waitServoSettled();
+                uint16_t targetSteps = static_cast<uint16_t>(ActiveKinematics::stepsForMm(distanceMm));
+                uint16_t halfTarget = targetSteps / 2;
+                hot_.delayValue = config::RAMP_START_DELAY_US;
+
+                for (uint16_t i = 0; i < targetSteps; i++)
+                {
+                    hal_.stepPair(hot_.direction, hot_.direction);
+                    rampDelay(i < halfTarget);
+
+                    if (bounceAtObstacle)
+                        bounce();
+                }
+                hal_.stopMotors();
+                hal_.segmentDone(targetSteps);
+            }
+
+            void forward(float distanceMm)
+            {
+                hot_.direction = 1;
+                move(distanceMm);
+            }
+
+            void backward(float distanceMm)
+            {
+                hot_.direction = -1;
+                move(distanceMm);
+            }
+
+            /**
+             * @brief Auf der Stelle drehen
+             */
+            void turn(float degrees, int turningDirection = 1)
+            {
+                TT_TRACE_SPAN(TURN, static_cast<int32_t>(degrees * turningDirection * 10.0f));
+                hal_.waitServoSettled();
+
+                if (degrees < 0)
+                {
+                    degrees = -degrees;
+                    turningDirection *= -1;
+                }
+
+                while (degrees >= 360)
+                    degrees -= 360;
+
+                uint16_t targetSteps = static_cast<uint16_t>(ActiveKinematics::stepsForDegrees(degrees));
+                uint16_t halfTarget = targetSteps / 2;
+                hot_.delayValue = config::RAMP_START_DELAY_US;
+
+                for (uint16_t i = 0; i < targetSteps; i++)
+                {
+                    hal_.stepPair(-turningDirection, turningDirection);
+                    rampDelay(i < halfTarget);
+                }
+                hal_.segmentDone(targetSteps);
+            }
+
+            /**
+             * @brief Bei gedrücktem Bumper zurücksetzen und zufällig abdrehen
+             */
+            void bounce()
+            {
+                bool penState = hal_.isDrawing();
+
+                BumperState bumpers = hal_.readBumpers();
+                if (bumpers.front)
+                    hot_.direction = -1;
+                if (bumpers.back)
+                    hot_.direction = 1;
+
+                while (hal_.isBumperPressed())
+                {
+                    hal_.penUp();
+                    int randomDir = hal_.random(0, 2) ? -1 : 1;
+
+                    while (hal_.isBumperPressed())
+                    {
+                        turn(randomDir);
+                    }
+                    turn(randomDir * hal_.random(5, 45));
+                }
+
+                if (penState)
+                    hal_.penDown();
+            }
+
+            /**
+             * @brief Kürzeste Drehung (max 90°), ggf. mit umgekehrter Fahrtrichtung
+             */
+            void smartTurn(float angle)
+            {
+                while (angle > 180)
+                    angle -= 360;
+                while (angle <= -180)
+                    angle += 360;
+
+                float optimized = angle;
+
+                if (optimized > 90)
+                {
+                    hot_.direction *= -1;
+                    optimized -= 180;
+                }
+                else if (optimized < -90)
+                {
+                    hot_.direction *= -1;
+                    optimized += 180;
+                }
+                else if (optimized == 180 || optimized == -180)
+                {
+                    hot_.direction *= -1;
+                    optimized = 0;
+                }
+
+                turn(optimized, 1);
+            }
+
+            /**
+             * @brief Zu einer Koordinate fahren (drehen, geradeaus, Pose fortschreiben)
+             */
+            void goTo(Pose &pose, float targetX, float targetY, bool penDown)
+            {
+                TT_TRACE_SPAN(GOTO, monitor::tracePackXY(targetX, targetY));
+                GoToPlan plan = planGoTo(pose, targetX, targetY);
+
+                // Drehen wenn nötig
+                if (plan.turns)
+                {
+                    turn(plan.turnAngle);
+                    pose.heading = plan.targetAngle;
+                    hal_.reportPose(pose);
+                }
+
+                // Zum Ziel fahren
+                if (penDown)
+                    hal_.penDown();
+
+                forward(plan.distance);
+
+                if (penDown)
+                    hal_.penUp();
+
+                // Position aktualisieren
+                pose.x = targetX;
+                pose.y = targetY;
+                hal_.reportPose(pose);
+            }
+
+            Hal &hal() { return hal_; }
+
+        private:
+            // Verzögerung bis zur Hälfte verkürzen, danach wieder verlängern
+            inline void rampDelay(bool accelerate)
+            {
+                if (accelerate)
+                    hot_.delayValue -= tuning_.rampValue;
+                else
+                    hot_.delayValue += tuning_.rampValue;
+
+                int32_t us = std::clamp<int32_t>(hot_.delayValue, tuning_.minStepDelayUs, tuning_.maxStepDelayUs);
+                hal_.delayMicroseconds(static_cast<uint32_t>(us));
+            }
+
+            Hal &hal_;
+            HotState &hot_;
+            MotionTuning tuning_;
+        };
+
+    } // namespace motion
+} // namespace tiny_turtle
@@ -17,11 +17,11 @@ namespace tiny_turtle
 
         using namespace config;
 
-        void spiral(float startRadius, float endRadius, float revolutions, bool penDown)
+        void spiral(TurtleContext &ctx, float startRadius, float endRadius, float revolutions, bool penDown)
         {
             if (penDown)
             {
-                hal::penDown();
+                hal::penDown(ctx);
             }
 
             const int stepsPerRev = 36; // 10° Schritte
@@ -32,28 +32,28 @@ namespace tiny_turtle
             for (int i = 0; i < totalSteps; i++)
             {
                 float arcLength = (2.0f * PI * currentRadius) / stepsPerRev;
-                forward(arcLength);
-                turn(360.0f / stepsPerRev);
+                forward(ctx, arcLength);
+                turn(ctx, 360.0f / stepsPerRev);
                 currentRadius += radiusStep;
             }
 
             if (penDown)
             {
-                hal::penUp();
+                hal::penUp(ctx);
             }
         }
 
-        void spiralIn(float radius, float revolutions)
+        void spiralIn(TurtleContext &ctx, float radius, float revolutions)
         {
-            spiral(radius, 0, revolutions, true);
+            spiral(ctx, radius, 0, revolutions, true);
         }
 
-        void spiralOut(float radius, float revolutions)
+        void spiralOut(TurtleContext &ctx, float radius, float revolutions)
         {
-            spiral(0, radius, revolutions, true);
+            spiral(ctx, 0, radius, revolutions, true);
         }
 
-        void circle(float radius, bool clockwise)
+        void circle(TurtleContext &ctx, float radius, bool clockwise)
         {
             const int steps = 36;
             float arcLength = (2.0f * PI * radius) / steps;
@@ -61,12 +61,12 @@ namespace tiny_turtle
 
             for (int i = 0; i < steps; i++)
             {
-                forward(arcLength);
-                turn(angleStep);
+                forward(ctx, arcLength);
+                turn(ctx, angleStep);
             }
         }
 
-        void arc(float radius, float degrees, bool clockwise)
+        void arc(TurtleContext &ctx, float radius, float degrees, bool clockwise)
         {
             int steps = static_cast<int>(fabs(degrees) / 10.0f);
             if (steps < 1)
@@ -79,11 +79,18 @@ namespace tiny_turtle
 
             for (int i = 0; i < steps; i++)
             {
-                forward(arcLength);
-                turn(angleStep);
+                forward(ctx, arcLength);
+                turn(ctx, angleStep);
             }
         }
 
+        // Kurzformen auf defaultContext()
+        void spiral(float startRadius, float endRadius, float revolutions, bool penDown) { spiral(defaultContext(), startRadius, endRadius, revolutions, penDown); }
+        void spiralIn(float radius, float revolutions) { spiralIn(defaultContext(), radius, revolutions); }
+        void spiralOut(float radius, float revolutions) { spiralOut(defaultContext(), radius, revolutions); }
+        void circle(float radius, bool clockwise) { circle(defaultContext(), radius, clockwise); }
+        void arc(float radius, float degrees, bool clockwise) { arc(defaultContext(), radius, degrees, clockwise); }
+
     } // namespace motion
 } // namespace tiny_turtle
 
@@ -4,30 +4,40 @@
  * @brief Spiral-Bewegungen und Kreise
  */
 
+#include "../core/context.h"
+
 namespace tiny_turtle
 {
     namespace motion
     {
         /**
          * @brief Spirale zeichnen
-         * @param initialRadiusMM Startradius
-         * @param finalRadiusMM Endradius
+         * @param startRadius Startradius in mm
+         * @param endRadius Endradius in mm
          * @param revolutions Anzahl Umdrehungen
-         * @param clockwise Richtung
-         * @param stopAtSwitch Bei Bumper stoppen
-         * @param stopAtSensor Bei Sensor stoppen
-         * @param togglePenAtSensor Stift bei Sensor umschalten
-         * @return true wenn erfolgreich
+         * @param penDown Mit Stift zeichnen?
+         */
+        void spiral(TurtleContext &ctx, float startRadius, float endRadius, float revolutions = 1.0f, bool penDown = true);
+        void spiral(float startRadius, float endRadius, float revolutions = 1.0f, bool penDown = true);
+
+        /**
+         * @brief Spirale von außen nach innen zeichnen
+         */
+        void spiralIn(TurtleContext &ctx, float radius, float revolutions);
+        void spiralIn(float radius, float revolutions);
+
+        /**
+         * @brief Spirale von innen nach außen zeichnen
          */
-        bool spiral(double initialRadiusMM, double finalRadiusMM, double revolutions = 1.0,
-                    bool clockwise = true, bool stopAtSwitch = true,
-                    bool stopAtSensor = false, bool togglePenAtSensor = false);
+        void spiralOut(TurtleContext &ctx, float radius, float revolutions);
+        void spiralOut(float radius, float revolutions);
 
         /**
          * @brief Kreis zeichnen
          * @param radius Radius in mm
          * @param clockwise Im Uhrzeigersinn?
          */
+        void circle(TurtleContext &ctx, float radius, bool clockwise = false);
         void circle(float radius, bool clockwise = false);
 
         /**
@@ -36,12 +46,15 @@ namespace tiny_turtle
          * @param degrees Winkel in Grad
          * @param clockwise Im Uhrzeigersinn?
          */
+        void arc(TurtleContext &ctx, float radius, float degrees, bool clockwise = false);
         void arc(float radius, float degrees, bool clockwise = false);
 
     } // namespace motion
 } // namespace tiny_turtle
 
 // Legacy-Kompatibilität
-bool spiral(double initialRadiusMM, double finalRadiusMM, double revolutions = 1.0,
-            bool clockwise = true, bool stopAtSwitch = true,
-            bool stopAtSensor = false, bool togglePenAtSensor = false);
+void spiral(float startRadius, float endRadius, float revolutions, bool penDown);
+void spiralIn(float radius, float revolutions);
+void spiralOut(float radius, float revolutions);
+void circle(float radius, bool clockwise);
+void arc(float radius, float degrees, bool clockwise);
@@ -0,0 +1,60 @@
+/**
+ * @file motion/timeline.cpp
+ * @brief Vom Host geplante Aufträge abspielen
+ */
+
+#include "timeline.h"
+#include "timeline_player.h"
+#include "../core/kinematics.h"
+#include "../hal/device_hal.h"
+#include "esp_log.h"
+
+static const char *TAG = "motion.timeline";
+
+namespace tiny_turtle
+{
+    namespace motion
+    {
+
+        static uint32_t activeStepsPerMmFx()
+        {
+#if TT_KINEMATICS_RUNTIME
+            return CalibratedKinematics::factors().stepsPerMmFx;
+#else
+            return ActiveKinematics::STEPS_PER_MM_FX;
+#endif
+        }
+
+        bool playTimeline(TurtleContext &ctx, const uint8_t *data, size_t size)
+        {
+            timeline::TimelineHeader header;
+            if (!timeline::unpackHeader(data, size, header))
+            {
+                ESP_LOGE(TAG, "Keine gültige Schritt-Abfolge (%u Bytes)", static_cast<unsigned>(size));
+                return false;
+            }
+            if (header.stepsPerMmFx != activeStepsPerMmFx())
+            {
+                ESP_LOGE(TAG, "Für anderes Profil geplant (stepsPerMmFx %lu statt %lu)", header.stepsPerMmFx,
+                         activeStepsPerMmFx());
+                return false;
+            }
+
+            hal::DeviceHal device(ctx);
+            TimelineStats stats;
+            bool ok = playTimeline(device, data, size, &stats);
+            if (stats.havePose)
+                ctx.pose = stats.pose;
+
+            if (ok)
+                ESP_LOGI(TAG, "%lu Datensätze, %lu Schritte", stats.records, stats.steps);
+            else
+                ESP_LOGE(TAG, "Abbruch bei Datensatz %lu", stats.records);
+            return ok;
+        }
+
+        // Kurzform auf defaultContext()
+        bool playTimeline(const uint8_t *data, size_t size) { return playTimeline(defaultContext(), data, size); }
+
+    } // namespace motion
+} // namespace tiny_turtle
@@ -0,0 +1,29 @@
+#pragma once
+/**
+ * @file motion/timeline.h
+ * @brief Vom Host geplante Aufträge abspielen (host/job_compiler)
+ *
+ * Die Abfolge bleibt, wo sie liegt - typischerweise im Flash, eingebunden
+ * über EMBED_FILES oder als C-Array (job_compiler --c). Das Gerät dekodiert
+ * nur noch Schritte und Pausen, siehe motion/timeline_player.h.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/context.h"
+
+namespace tiny_turtle
+{
+    namespace motion
+    {
+        /**
+         * @brief Schritt-Abfolge abspielen
+         * @param data Kopf und Datensätze (core/step_timeline.h)
+         * @param size Länge in Bytes
+         * @return false bei ungültigen Daten oder wenn für ein anderes Profil geplant wurde
+         */
+        bool playTimeline(TurtleContext &ctx, const uint8_t *data, size_t size);
+        bool playTimeline(const uint8_t *data, size_t size);
+
+    } // namespace motion
+} // namespace tiny_turtle
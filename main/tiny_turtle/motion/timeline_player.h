@@ -0,0 +1,124 @@
+#pragma once
+/**
+ * @file motion/timeline_player.h
+ * @brief Vorberechnete Schritt-Abfolgen (core/step_timeline.h) abspielen
+ *
+ * Der Player dekodiert nur: je BURST-Schritt stepPair() bzw. stepMotor() und
+ * eine Pause aus Start-Intervall plus Schrittweite, keine Gleitkomma-Rechnung,
+ * keine Rampen, keine Winkel. Auf dem Gerät läuft er mit hal::DeviceHal
+ * (motion/timeline.h), auf dem Host mit host::SimHal - gleiche Eingabe,
+ * gleiche Schrittfolge wie MotionCore beim Planen.
+ *
+ * Frei von ESP-IDF.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/context.h"
+#include "../core/step_timeline.h"
+#include "../hal/hal_backend.h"
+#include "../monitor/trace.h"
+
+namespace tiny_turtle
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Ergebnis eines Abspielvorgangs
+         */
+        struct TimelineStats
+        {
+            uint32_t records;  // Abgespielte Datensätze
+            uint32_t steps;    // Schritte (Paare zählen einfach)
+            bool havePose;     // Mindestens ein POSE-Datensatz
+            Pose pose;         // Letzte gemeldete Pose
+        };
+
+        /**
+         * @brief Schritt-Abfolge abspielen
+         * @param data Kopf und Datensätze (z.B. direkt aus dem Flash)
+         * @param size Länge in Bytes
+         * @param stats Optional: Zähler und letzte Pose
+         * @return false bei ungültigem Kopf oder unbekanntem Datensatz (Motoren werden gestoppt)
+         */
+        template <class Hal>
+        bool playTimeline(Hal &hal, const uint8_t *data, size_t size, TimelineStats *stats = nullptr)
+        {
+            static_assert(hal::isHalBackend<Hal>, "Hal muss von hal::HalBackend<Hal> erben");
+            using namespace timeline;
+
+            TimelineStats local = {0, 0, false, {0.0f, 0.0f, 0.0f}};
+            TimelineStats &s = stats ? *stats : local;
+            s = local;
+
+            TimelineHeader header;
+            if (!unpackHeader(data, size, header))
+                return false;
+
+            TT_TRACE_SPAN(TIMELINE, header.recordCount);
+            const uint8_t *raw = data + HEADER_SIZE;
+            for (uint32_t n = 0; n < header.recordCount; n++, raw += RECORD_SIZE)
+            {
+                TimelineRecord r = unpackRecord(raw);
+                s.records++;
+
+                switch (r.op)
+                {
+                case TimelineOp::END:
+                    return true;
+
+                case TimelineOp::BURST:
+                {
+                    int dir1 = decodeDir(r.dirs & 0x03);
+                    int dir2 = decodeDir((r.dirs >> 2) & 0x03);
+                    int32_t us = r.intervalUs;
+                    for (uint16_t k = 0; k < r.count; k++, us += r.deltaUs)
+                    {
+                        if (dir1 != 0 && dir2 != 0)
+                            hal.stepPair(dir1, dir2);
+                        else if (dir1 != 0)
+                            hal.stepMotor(1, dir1);
+                        else if (dir2 != 0)
+                            hal.stepMotor(2, dir2);
+                        if (us > 0)
+                            hal.delayMicroseconds(static_cast<uint32_t>(us));
+                    }
+                    s.steps += r.count;
+                    break;
+                }
+
+                case TimelineOp::STOP:
+                    hal.stopMotors();
+                    break;
+                case TimelineOp::PEN_UP:
+                    hal.penUp();
+                    break;
+                case TimelineOp::PEN_DOWN:
+                    hal.penDown();
+                    break;
+                case TimelineOp::SETTLE:
+                    hal.waitServoSettled();
+                    break;
+                case TimelineOp::SEGMENT:
+                    hal.segmentDone(r.count);
+                    break;
+                case TimelineOp::POSE:
+                    s.pose = recordPose(r);
+                    s.havePose = true;
+                    hal.reportPose(s.pose);
+                    break;
+                case TimelineOp::DELAY:
+                    hal.delayMicroseconds((static_cast<uint32_t>(r.count) << 16) | r.intervalUs);
+                    break;
+
+                default:
+                    hal.stopMotors();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace motion
+} // namespace tiny_turtle
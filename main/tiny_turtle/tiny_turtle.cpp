@@ -15,27 +15,40 @@ namespace tiny_turtle
 {
     void init()
     {
+        using monitor::BootPhase;
+        monitor::markBootPhase(BootPhase::STARTUP);
         ESP_LOGI(TAG, "Tiny Turtle v%s initialisieren...", VERSION);
 
-        // HAL initialisieren
+        // Nichts hier wartet auf Mechanik oder Töne: Servo und Startton laufen
+        // im Hintergrund weiter, alles mit spürbaren Erst-Kosten (ADC, RMT)
+        // wird dafür sofort angelegt statt beim ersten Gebrauch.
         hal::initStepperTimer();
+        hal::initSleepTimers();
+        monitor::markBootPhase(BootPhase::STEPPER);
+
+        // Stift heben anstoßen - die erste Bewegung wartet die Restzeit ab
         hal::initServo();
+        monitor::markBootPhase(BootPhase::SERVO);
+
         hal::initSensors(); // Keine Pin-Konflikte mehr mit neuen Motor-Pins
-        hal::initAudio();
-        hal::initLed();
+        monitor::markBootPhase(BootPhase::SENSORS);
 
-        // Stift hoch
-        hal::penUp();
+        // Kurzer Startton (läuft im Hintergrund weiter)
+        hal::initAudio();
+        static const hal::Note chime[] = {{1000, 100}, {0, 100}, {1500, 100}};
+        hal::playNotes(chime, 3);
+        monitor::markBootPhase(BootPhase::AUDIO);
 
         // LED grün für "bereit"
-        hal::setLedColor(0, 32, 0);
-
-        // Kurzer Startton
-        hal::playTone(1000, 100);
-        vTaskDelay(pdMS_TO_TICKS(100));
-        hal::playTone(1500, 100);
+        hal::initLed();
+        hal::showStatus(hal::LedStatus::READY);
+        monitor::markBootPhase(BootPhase::LED);
 
         ESP_LOGI(TAG, "Initialisierung abgeschlossen.");
+        monitor::logBootTimeline();
+
+        // Ab hier kein Heap mehr (TT_ALLOC_TRACKING)
+        monitor::armAllocTracking();
     }
 
     void shutdown()
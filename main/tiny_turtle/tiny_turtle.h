@@ -11,14 +11,20 @@
  */
 
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 // ============================================================================
 // Core Module
 // ============================================================================
 #include "core/config.h"  // Hardware-Konfiguration und Konstanten
 #include "core/types.h"   // Gemeinsame Typen und Enums
-#include "core/globals.h" // Globale Zustandsvariablen
+#include "core/context.h" // TurtleContext (Zustand + HAL-Handles je Roboter)
+#include "core/globals.h" // Globale Zustandsvariablen (Referenzen auf defaultContext())
+#include "core/robot_state.h" // Seqlock-geschützter Zustands-Schnappschuss
+#include "core/kinematics.h"  // Schritte aus Weg/Winkel (Kinematics<Profile>)
+#include "core/arena.h"        // Bump-Allokator über festem Speicherblock
+#include "core/path_buffer.h"  // Pfade als x/y/Flag-Arrays (SoA)
+#include "core/path_kernels.h" // Stapel-Kernel über PathBuffer
 
 // ============================================================================
 // HAL (Hardware Abstraction Layer)
@@ -26,17 +32,26 @@
 #include "hal/gpio_hal.h" // GPIO-Wrapper (pinMode, digitalWrite, delay, etc.)
 #include "hal/neopixel.h" // NeoPixel LED-Streifen
 #include "hal/stepper.h"  // Schrittmotor-Steuerung mit GPTimer
+#include "hal/microstep.h" // Sinus-Mikroschritt über LEDC (StepMode::MICRO)
+#include "hal/stepper_backend.h" // Treiber-Backends (Unipolar, STEP/DIR)
+#include "hal/stepdir.h"   // STEP-Pulse aus MCPWM (STEP/DIR-Backend)
+#include "hal/wave_stream.h" // DMA-Wellenform über PARLIO (TT_STEPPER_WAVE)
+#include "hal/timing.h"   // sleepUs() unterhalb der Tick-Auflösung
 #include "hal/servo.h"    // Servo für Stift (Pen Up/Down)
 #include "hal/sensors.h"  // Bumper und Foto-Sensor
 #include "hal/audio.h"    // Speaker/Piezo
 #include "hal/led.h"      // NeoPixel LED
+#include "hal/hal_backend.h" // Statische HAL-Schnittstelle (CRTP)
+#include "hal/device_hal.h"  // HAL-Backend für die Hardware
 
 // ============================================================================
 // Motion Module
 // ============================================================================
 #include "motion/motion.h"      // Grundlegende Bewegungen (forward, turn, etc.)
+#include "motion/motion_core.h" // Schritt-Schleifen auf beliebigem HAL-Backend
 #include "motion/spiral.h"      // Spiralen und Kreise
 #include "motion/coordinates.h" // Koordinatenbasierte Bewegung
+#include "motion/timeline.h"    // Vom Host geplante Schritt-Abfolgen abspielen
 
 // ============================================================================
 // Drawing Module
@@ -44,6 +59,16 @@
 #include "drawing/text.h"  // Text-Zeichnung
 #include "drawing/fonts.h" // Font-Daten
 
+// ============================================================================
+// Monitor Module
+// ============================================================================
+#include "monitor/telemetry.h" // Binärer Telemetrie-Stream
+#include "monitor/trace.h"     // Ereignis-Trace (TT_TRACE)
+#include "monitor/isr_timing.h" // Laufzeit-Histogramme der Stepper-ISR
+#include "monitor/perf.h"       // Performance-Zähler, Task- und Heap-Statistik
+#include "monitor/boot_timeline.h" // Dauer der Start-Phasen bis "bereit"
+#include "monitor/alloc_tracking.h" // Heap-Allokationen nach init() (TT_ALLOC_TRACKING)
+
 // ============================================================================
 // Math Module
 // ============================================================================
@@ -57,6 +82,10 @@ namespace tiny_turtle
 
     /**
      * @brief Tiny Turtle System initialisieren
+     *
+     * Blockiert weder auf das Servo noch auf den Startton; beide laufen im
+     * Hintergrund weiter. Die Dauer jeder Phase steht danach im Log
+     * (monitor::logBootTimeline()).
      */
     void init();
 